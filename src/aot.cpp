@@ -0,0 +1,450 @@
+#include <fmt/core.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "module.h"
+#include "ops.h"
+#include "registry.h"
+#include "simd.h"
+
+// Translates an assembled module into C++ that runs it without the
+// interpreter loop: every instruction becomes a direct call to the VM's op
+// handler and branches become gotos between labels. The generated entry point
+// takes a pushle::VM, so results are read back with the usual get_* calls.
+
+struct Decoded {
+  size_t offset;
+  pushle::Op op;
+  std::string name;
+  std::vector<pushle::DataType> types;
+  std::vector<unsigned __int128> args; // little-endian bits, truncated to the type's size
+};
+
+size_t type_size(pushle::DataType type) {
+  switch (type) {
+    case pushle::DataType::_i8:
+    case pushle::DataType::_u8:
+    case pushle::DataType::_bool:
+      return 1;
+    case pushle::DataType::_i16:
+    case pushle::DataType::_u16:
+      return 2;
+    case pushle::DataType::_i32:
+    case pushle::DataType::_u32:
+    case pushle::DataType::_f32:
+      return 4;
+    case pushle::DataType::_i64:
+    case pushle::DataType::_u64:
+    case pushle::DataType::_f64:
+      return 8;
+    case pushle::DataType::_i128:
+    case pushle::DataType::_u128:
+    case pushle::DataType::_f128:
+      return 16;
+    default:
+      throw std::runtime_error("Unknown type");
+  }
+}
+
+bool is_branch(pushle::Op op) {
+  return (op >= pushle::Op::JZ && op <= pushle::Op::JMP) || op == pushle::Op::JERR ||
+    (op >= pushle::Op::BRLI_Z_I8 && op <= pushle::Op::BR_NG_F64) ||
+    (op >= pushle::Op::LOOP_I8 && op <= pushle::Op::DJNZ_F64) || op == pushle::Op::BRSIZE ||
+    (op >= pushle::Op::BRI_Z_I8 && op <= pushle::Op::BRI_NG_F64) ||
+    (op >= pushle::Op::LOOPT_I8 && op <= pushle::Op::LOOPT_F64) || op == pushle::Op::ONTRAP;
+}
+
+// Instructions that can never raise a trap, so no check follows them.
+bool cannot_trap(pushle::Op op) {
+  return (op >= pushle::Op::JZ && op <= pushle::Op::JMP) || op == pushle::Op::JERR ||
+    op == pushle::Op::SIG || op == pushle::Op::ONTRAP || op == pushle::Op::OFFTRAP;
+}
+
+bool is_constant_ref(pushle::Op op) {
+  return op == pushle::Op::PUSHK || op == pushle::Op::PUSHKW ||
+    (op >= pushle::Op::SETLK_I64 && op <= pushle::Op::SETLKW_F64);
+}
+
+bool valid_string(const pushle::Module& module, uint64_t offset) {
+  if (offset % 8 != 0 || module.strings_size < sizeof(pushle::StringHeader) || offset > module.strings_size - sizeof(pushle::StringHeader)) {
+    return false;
+  }
+  pushle::StringHeader header;
+  memcpy(&header, module.strings + offset, sizeof(header));
+  return header.length < module.strings_size - offset - sizeof(pushle::StringHeader);
+}
+
+// Decodes the code section and checks that it is well formed: every opcode is
+// known, operands lie within the section, branches land on an instruction
+// (or the end of the code) and constant indices are inside the pool, as are
+// string offsets.
+std::vector<Decoded> verify(const pushle::Module& module) {
+  std::vector<Decoded> program;
+  std::set<size_t> boundaries;
+  size_t offset = 0;
+  while (offset < module.code_size) {
+    Decoded ins;
+    ins.offset = offset;
+    unsigned opcode = module.code[offset++];
+    if (opcode >= pushle::OP_PAGE_PREFIX) {
+      if (offset >= module.code_size) {
+        throw std::runtime_error(fmt::format("{:#x}: truncated opcode", ins.offset));
+      }
+      opcode = ((opcode - pushle::OP_PAGE_PREFIX + 1) << 8) | module.code[offset++];
+    }
+    ins.op = (pushle::Op) opcode;
+    auto token = pushle::TokenRegistry::getInstance().getToken(ins.op);
+    // Generated code runs to completion, so it cannot suspend at a yield.
+    if (!token || ins.op == pushle::Op::YIELD || ins.op == pushle::Op::AWAITNATIVE) {
+      throw std::runtime_error(fmt::format("{:#x}: unsupported opcode {:#x}", ins.offset, opcode));
+    }
+    ins.name = token->getToken();
+    ins.types = token->getArguments();
+    for (auto type : ins.types) {
+      size_t size = type_size(type);
+      if (size > module.code_size - offset) {
+        throw std::runtime_error(fmt::format("{:#x}: truncated operand for {}", ins.offset, ins.name));
+      }
+      unsigned __int128 bits = 0;
+      memcpy(&bits, module.code + offset, size);
+      ins.args.push_back(bits);
+      offset += size;
+    }
+    if (is_constant_ref(ins.op) && ins.args.back() >= module.constant_count) {
+      throw std::runtime_error(fmt::format("{:#x}: constant {} out of range", ins.offset, ins.args.back()));
+    }
+    if (ins.op == pushle::Op::STRK && !valid_string(module, ins.args[0])) {
+      throw std::runtime_error(fmt::format("{:#x}: string {} out of range", ins.offset, ins.args[0]));
+    }
+    boundaries.insert(ins.offset);
+    program.push_back(ins);
+  }
+  boundaries.insert(module.code_size);
+
+  for (const auto& ins : program) {
+    if (is_branch(ins.op) && !boundaries.contains(ins.args.back())) {
+      throw std::runtime_error(fmt::format("{:#x}: {} target {:#x} is not an instruction", ins.offset, ins.name, ins.args.back()));
+    }
+  }
+  return program;
+}
+
+// C++ has no 128-bit literals, so they are assembled from two halves.
+std::string wide_literal(unsigned __int128 bits) {
+  return fmt::format("((uint128_t){:#x}ull << 64 | {:#x}ull)", (uint64_t)(bits >> 64), (uint64_t)bits);
+}
+
+std::string literal(pushle::DataType type, unsigned __int128 bits) {
+  switch (type) {
+    case pushle::DataType::_i8:   return fmt::format("(int8_t){}", (int8_t) bits);
+    case pushle::DataType::_u8:   return fmt::format("(uint8_t){}", (uint8_t) bits);
+    case pushle::DataType::_bool: return bits != 0 ? "true" : "false";
+    case pushle::DataType::_i16:  return fmt::format("(int16_t){}", (int16_t) bits);
+    case pushle::DataType::_u16:  return fmt::format("(uint16_t){}", (uint16_t) bits);
+    case pushle::DataType::_i32:  return fmt::format("(int32_t){}", (int32_t) bits);
+    case pushle::DataType::_u32:  return fmt::format("(uint32_t){}u", (uint32_t) bits);
+    case pushle::DataType::_f32:  return fmt::format("std::bit_cast<float>((uint32_t){:#x}u)", (uint32_t) bits);
+    case pushle::DataType::_i64:  return fmt::format("(int64_t){:#x}ull", (uint64_t) bits);
+    case pushle::DataType::_u64:  return fmt::format("(uint64_t){:#x}ull", (uint64_t) bits);
+    case pushle::DataType::_f64:  return fmt::format("std::bit_cast<double>((uint64_t){:#x}ull)", (uint64_t) bits);
+    case pushle::DataType::_i128: return fmt::format("(int128_t){}", wide_literal(bits));
+    case pushle::DataType::_u128: return wide_literal(bits);
+    case pushle::DataType::_f128: return fmt::format("std::bit_cast<float128_t>{}", wide_literal(bits));
+    default:
+      throw std::runtime_error("Unknown type");
+  }
+}
+
+// "br_nl_i32" -> "i32"
+std::string type_suffix(const std::string& name) {
+  return name.substr(name.rfind('_') + 1);
+}
+
+pushle::DataType suffix_type(const std::string& suffix) {
+  static const std::map<std::string, pushle::DataType> types = {
+    {"i8", pushle::DataType::_i8}, {"u8", pushle::DataType::_u8}, {"bool", pushle::DataType::_bool},
+    {"i16", pushle::DataType::_i16}, {"u16", pushle::DataType::_u16}, {"i32", pushle::DataType::_i32},
+    {"u32", pushle::DataType::_u32}, {"f32", pushle::DataType::_f32}, {"i64", pushle::DataType::_i64},
+    {"u64", pushle::DataType::_u64}, {"f64", pushle::DataType::_f64},
+  };
+  return types.at(suffix);
+}
+
+// Condition on a comparison result (-1, 0 or 1), as tested by jz..jng.
+std::string condition(const std::string& code) {
+  static const std::map<std::string, std::string> conditions = {
+    {"z", "== 0"}, {"nz", "!= 0"}, {"l", "== -1"}, {"g", "== 1"}, {"nl", "!= -1"}, {"ng", "!= 1"},
+  };
+  return conditions.at(code);
+}
+
+std::string label(size_t offset) {
+  return fmt::format("L_{:08x}", offset);
+}
+
+// A trap raised by the instruction at `offset` must be seen before it
+// branches anywhere, so every goto it makes goes through this check.
+std::string trap_check(size_t offset) {
+  return fmt::format("if (vm.reg_trap != TRAP_NONE) {{ vm.trap_at = {}; goto L_trap; }}", offset);
+}
+
+std::string jump(const Decoded& ins, size_t target) {
+  if (cannot_trap(ins.op)) {
+    return fmt::format("goto {};", label(target));
+  }
+  return fmt::format("{{ {} goto {}; }}", trap_check(ins.offset), label(target));
+}
+
+std::string translate(const Decoded& ins, const pushle::Module& module) {
+  using pushle::Op;
+  Op op = ins.op;
+  const std::string& name = ins.name;
+  auto arg = [&](size_t i) { return literal(ins.types[i], ins.args[i]); };
+
+  if (op == Op::PUSHK || op == Op::PUSHKW) {
+    uint64_t bits;
+    memcpy(&bits, module.constants + ins.args[0] * sizeof(uint64_t), sizeof(bits));
+    return fmt::format("{{ uint64_t k = {:#x}ull; vm.push(&k, 8); }}", bits);
+  }
+  if (op >= Op::SETLK_I64 && op <= Op::SETLKW_F64) {
+    uint64_t bits;
+    memcpy(&bits, module.constants + ins.args[1] * sizeof(uint64_t), sizeof(bits));
+    std::string suffix = type_suffix(name);
+    return fmt::format("vm.setl_{}({}, &vm.scope, {});", suffix, literal(suffix_type(suffix), bits), arg(0));
+  }
+  if (op == Op::STRK) {
+    return fmt::format("{{ uint64_t s = (uint64_t)(strings + {}); vm.push(&s, 8); }}", ins.args[0] + sizeof(pushle::StringHeader));
+  }
+  if (op >= Op::PUSHS_I32 && op <= Op::PUSHS_F64) {
+    return fmt::format("vm.push_{}({});", type_suffix(name), arg(0));
+  }
+  if (op >= Op::SETLS_I32 && op <= Op::SETLS_F64) {
+    return fmt::format("vm.setl_{}({}, &vm.scope, {});", type_suffix(name), arg(1), arg(0));
+  }
+  if ((op >= Op::PUSHL_I8 && op <= Op::POPL_F64) || (op >= Op::PUSHL_I128 && op <= Op::POPL_F128)
+      || op == Op::PUSHL_REF || op == Op::POPL_REF) {
+    return fmt::format("vm.{}(&vm.scope, {});", name, arg(0));
+  }
+  if ((op >= Op::SETL_I8 && op <= Op::SETL_F64) || (op >= Op::SETL_I128 && op <= Op::SETL_F128)
+      || (op >= Op::CMPLI_I8 && op <= Op::CMPLI_F64)) {
+    return fmt::format("vm.{}({}, &vm.scope, {});", name, arg(1), arg(0));
+  }
+  if (op >= Op::MOVL_I8 && op <= Op::CMPL_F64) {
+    std::string args;
+    for (size_t i = 0; i < ins.args.size(); i++) {
+      args += ", " + arg(i);
+    }
+    return fmt::format("vm.{}(&vm.scope{});", name, args);
+  }
+  if (op >= Op::ALOADL_I8 && op <= Op::ASTORELU_F64) {
+    return fmt::format("vm.{}(&vm.scope, {}, {});", name, arg(0), arg(1));
+  }
+  if (op == Op::BRSIZE) {
+    return fmt::format("if (vm.array_short(&vm.scope, {}, {})) {}", arg(0), arg(1), jump(ins, ins.args[2]));
+  }
+  if (op >= Op::VADD_I8X16 && op <= Op::VCMPLT_F64X4) {
+    unsigned i = op - Op::VADD_I8X16;
+    return fmt::format("vm.vbinary((simd::BinaryOp) {}, (simd::Shape) {});", i / pushle::simd::SHAPE_COUNT, i % pushle::simd::SHAPE_COUNT);
+  }
+  if (op >= Op::VSUM_I8X16 && op <= Op::VHMAX_F64X4) {
+    unsigned i = op - Op::VSUM_I8X16;
+    return fmt::format("vm.vreduce((simd::ReduceOp) {}, (simd::Shape) {});", i / pushle::simd::SHAPE_COUNT, i % pushle::simd::SHAPE_COUNT);
+  }
+  if (op >= Op::BRLI_Z_I8 && op <= Op::BRLI_NG_F64) {
+    // brli_<cc>_<type> -> cmpli_<type> followed by a jump on reg_cmp
+    std::string cc = name.substr(5, name.rfind('_') - 5);
+    return fmt::format("vm.cmpli_{}({}, &vm.scope, {}); if (vm.reg_cmp {}) {}",
+      type_suffix(name), arg(1), arg(0), condition(cc), jump(ins, ins.args[2]));
+  }
+  if (op >= Op::BRI_Z_I8 && op <= Op::BRI_NG_F64) {
+    // bri_<cc>_<type> -> cmpi_<type> followed by a jump on reg_cmp
+    std::string cc = name.substr(4, name.rfind('_') - 4);
+    return fmt::format("vm.cmpi_{}({}); if (vm.reg_cmp {}) {}",
+      type_suffix(name), arg(0), condition(cc), jump(ins, ins.args[1]));
+  }
+  if (op >= Op::MOVL2_I8 && op <= Op::MOVL2_F64) {
+    return fmt::format("vm.{}(&vm.scope, {}, {}, {}, {});", name, arg(0), arg(1), arg(2), arg(3));
+  }
+  if (op >= Op::BR_Z_I8 && op <= Op::BR_NG_F64) {
+    std::string cc = name.substr(3, name.rfind('_') - 3);
+    return fmt::format("if (vm.br_compare_{}() {}) {}", type_suffix(name), condition(cc), jump(ins, ins.args[0]));
+  }
+  if (op >= Op::LOOP_I8 && op <= Op::LOOP_F64) {
+    return fmt::format("if (vm.loop_step_{}({}, &vm.scope, {}) == -1) {}",
+      type_suffix(name), arg(1), arg(0), jump(ins, ins.args[2]));
+  }
+  if (op >= Op::LOOPT_I8 && op <= Op::LOOPT_F64) {
+    return fmt::format("if (vm.loopt_step_{}({}) == -1) {}", type_suffix(name), arg(0), jump(ins, ins.args[1]));
+  }
+  if (op >= Op::DJNZ_I8 && op <= Op::DJNZ_F64) {
+    return fmt::format("if (vm.djnz_step_{}(&vm.scope, {}) != 0) {}", type_suffix(name), arg(0), jump(ins, ins.args[1]));
+  }
+  if (op >= Op::JZ && op <= Op::JNG) {
+    return fmt::format("if (vm.reg_cmp {}) goto {};", condition(name.substr(1)), label(ins.args[0]));
+  }
+  if (op == Op::JMP) {
+    return fmt::format("goto {};", label(ins.args[0]));
+  }
+  if (op == Op::JERR) {
+    return fmt::format("if (vm.reg_err != 0) goto {};", label(ins.args[0]));
+  }
+  if (op == Op::SIG) {
+    return fmt::format("vm.sig({}); goto {};", arg(0), label(module.code_size));
+  }
+
+  std::string args;
+  for (size_t i = 0; i < ins.args.size(); i++) {
+    args += (i == 0 ? "" : ", ") + arg(i);
+  }
+  return fmt::format("vm.{}({});", name, args);
+}
+
+std::string generate(const std::vector<Decoded>& program, const pushle::Module& module, const std::string& symbol) {
+  std::set<size_t> targets;
+  std::set<size_t> handlers;
+  for (const auto& ins : program) {
+    if (ins.op == pushle::Op::ONTRAP) {
+      handlers.insert(ins.args[0]);
+    }
+    if (is_branch(ins.op)) {
+      targets.insert(ins.args.back());
+    } else if (ins.op == pushle::Op::SIG) {
+      targets.insert(module.code_size);
+    }
+  }
+
+  std::string out;
+  out += "// Generated by the pushle aot tool. Do not edit.\n";
+  out += "#include <bit>\n";
+  out += "#include <cstdint>\n\n";
+  out += "#include \"pushle.h\"\n\n";
+  out += "namespace pushle {\n";
+  out += fmt::format("  struct {}_program;\n\n", symbol);
+  out += "  template <>\n";
+  out += fmt::format("  struct AotProgram<{}_program> {{\n", symbol);
+  out += "    static void run(VM &vm) {\n";
+  if (module.strings_size > 0) {
+    // the strings section, so that strk handles stay interned
+    out += "      alignas(8) static const uint8_t strings[] = {";
+    for (size_t i = 0; i < module.strings_size; i++) {
+      out += fmt::format("{}{}", i % 16 == 0 ? "\n        " : " ", module.strings[i]) + (i + 1 < module.strings_size ? "," : "");
+    }
+    out += "\n      };\n";
+    // string handles are checked against the section the VM knows about
+    out += "      vm.strings = strings;\n";
+    out += "      vm.strings_size = sizeof(strings);\n";
+  } else {
+    out += "      vm.strings = nullptr;\n";
+    out += "      vm.strings_size = 0;\n";
+  }
+  for (const auto& ins : program) {
+    if (targets.contains(ins.offset)) {
+      out += fmt::format("    {}:\n", label(ins.offset));
+    }
+    out += fmt::format("      {}\n", translate(ins, module));
+    if (!cannot_trap(ins.op)) {
+      out += fmt::format("      {}\n", trap_check(ins.offset));
+    }
+  }
+  if (targets.contains(module.code_size)) {
+    out += fmt::format("    {}:\n", label(module.code_size));
+  }
+  out += "      vm.flush_releases();\n";
+  out += "      return;\n";
+  // the interpreter's stopped(): enter the handler set by ontrap, or leave
+  // the trap pending for the caller
+  out += "    L_trap:\n";
+  out += "      switch (vm.enter_trap_handler()) {\n";
+  for (size_t handler : handlers) {
+    out += fmt::format("        case {}: goto {};\n", handler, label(handler));
+  }
+  out += "        default: break;\n";
+  out += "      }\n";
+  out += "      vm.flush_releases();\n";
+  out += "    }\n";
+  out += "  };\n";
+  out += "};\n\n";
+  out += fmt::format("void {}(pushle::VM &vm) {{\n", symbol);
+  out += fmt::format("  pushle::AotProgram<pushle::{}_program>::run(vm);\n", symbol);
+  out += "}\n";
+  return out;
+}
+
+// "out/fib.o" -> "aot_fib"
+std::string default_symbol(const std::string& path) {
+  std::string symbol = "aot_";
+  for (char c : std::filesystem::path(path).stem().string()) {
+    symbol += std::isalnum((unsigned char) c) ? c : '_';
+  }
+  return symbol;
+}
+
+int main(int argc, char** argv) {
+  bool object = false;
+  std::string symbol;
+  std::string flags;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-c") {
+      object = true;
+    } else if (arg == "-n" && i + 1 < argc) {
+      symbol = argv[++i];
+    } else if (arg.starts_with("-I") || arg.starts_with("-D")) {
+      flags += " '" + arg + "'";
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 2) {
+    fmt::print("Usage: {} [-c] [-n symbol] [-I<dir>|-D<macro>...] <module> <output>\n", argv[0]);
+    return 1;
+  }
+  if (symbol.empty()) {
+    symbol = default_symbol(paths[1]);
+  }
+
+  std::ifstream in(paths[0], std::ios::binary);
+  if (!in) {
+    fmt::print("Failed to open file: {}\n", paths[0]);
+    return 1;
+  }
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  pushle::Module module = pushle::Module::load(data.data(), data.size());
+
+  std::string source;
+  try {
+    source = generate(verify(module), module, symbol);
+  } catch (const std::exception& e) {
+    fmt::print("{}: {}\n", paths[0], e.what());
+    return 1;
+  }
+
+  std::string source_path = object ? paths[1] + ".cpp" : paths[1];
+  {
+    std::ofstream out(source_path);
+    out << source;
+  }
+  if (!object) {
+    return 0;
+  }
+
+  // Compile with the host compiler; the flags must match the ones the VM
+  // library was built with (VM_SLOT_STACK in particular).
+  const char *cxx = std::getenv("CXX");
+  std::string command = fmt::format("{} -std=c++20 -O2 -fwrapv{} -c '{}' -o '{}'",
+    cxx != nullptr ? cxx : "c++", flags, source_path, paths[1]);
+  int status = std::system(command.c_str());
+  std::filesystem::remove(source_path);
+  return status == 0 ? 0 : 1;
+}
@@ -1,10 +1,18 @@
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <map>
+#include <set>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "module.h"
 #include "registry.h"
 #include "ops.h"
 
@@ -15,15 +23,13 @@ private:
   std::string label_;
   std::string text_;
 public:
-  Token() : is_label_(false) {}
+  Token() : is_label_(false), is_string_(false) {}
   Token(const std::string& text) : Token(text, false) {}
-  Token(const std::string& text, bool is_string) {
-    if (text.starts_with("@")) {
+  Token(const std::string& text, bool is_string) : is_label_(false), is_string_(is_string) {
+    if (!is_string && text.starts_with("@")) {
       is_label_ = true;
       label_ = text.substr(1);
     } else {
-      is_label_ = false;
-      is_string_ = is_string;
       text_ = text;
     }
   }
@@ -37,7 +43,7 @@ public:
   }
 
   bool is_number() const {
-    return !is_label_ && !is_string_ && text_.find_first_not_of("0123456789.") == std::string::npos;
+    return !is_label_ && !is_string_ && !text_.empty() && text_.find_first_not_of("0123456789.", text_[0] == '-' ? 1 : 0) == std::string::npos;
   }
 
   const std::string& label() const {
@@ -61,37 +67,1465 @@ public:
   }
 };
 
-class Bytecode {
-private:
-  bool is_label_;
-  uint8_t op_;
-  std::string label_;
+class Operand {
 public:
-  Bytecode() : is_label_(false), op_(0xff) {}
-  Bytecode(uint8_t op) : is_label_(false), op_(op) {}
-  Bytecode(const std::string& label) : is_label_(true), op_(0xff), label_(label) {}
+  pushle::DataType type;
+  uint64_t bits = 0;  // little-endian value, truncated to the type's size
+  uint64_t high = 0;  // upper half of 128-bit values
+  std::string label;  // label reference, encoded as a u64 address
+
+  Operand(pushle::DataType type, uint64_t bits) : type(type), bits(bits) {}
+  Operand(const std::string& label) : type(pushle::DataType::_u64), label(label) {}
 
   bool is_label() const {
-    return is_label_;
+    return !label.empty();
   }
 
-  uint8_t op() const {
-    return op_;
+  size_t size() const {
+    switch (type) {
+      case pushle::DataType::_i8:
+      case pushle::DataType::_u8:
+      case pushle::DataType::_bool:
+        return 1;
+      case pushle::DataType::_i16:
+      case pushle::DataType::_u16:
+        return 2;
+      case pushle::DataType::_i32:
+      case pushle::DataType::_u32:
+      case pushle::DataType::_f32:
+        return 4;
+      case pushle::DataType::_i64:
+      case pushle::DataType::_u64:
+      case pushle::DataType::_f64:
+        return 8;
+      case pushle::DataType::_i128:
+      case pushle::DataType::_u128:
+      case pushle::DataType::_f128:
+        return 16;
+      default:
+        throw std::runtime_error("Unknown type");
+    }
   }
+};
 
-  const std::string& label() const {
-    return label_;
+class Instruction {
+public:
+  pushle::Op op;
+  std::vector<Operand> args;
+  std::string label; // set on label definitions, which emit no code
+
+  Instruction(pushle::Op op, std::vector<Operand> args) : op(op), args(args) {}
+  Instruction(const std::string& label) : op(pushle::Op::RET), label(label) {}
+
+  bool is_label() const {
+    return !label.empty();
+  }
+
+  size_t size() const {
+    if (is_label()) {
+      return 0;
+    }
+    size_t size = pushle::op_size(op);
+    for (auto& arg : args) {
+      size += arg.size();
+    }
+    return size;
+  }
+};
+
+class ConstantPool {
+private:
+  std::vector<uint64_t> entries_;
+  std::map<uint64_t, size_t> index_;
+public:
+  size_t add(uint64_t bits) {
+    auto it = index_.find(bits);
+    if (it != index_.end()) {
+      return it->second;
+    }
+    index_[bits] = entries_.size();
+    entries_.push_back(bits);
+    return entries_.size() - 1;
+  }
+
+  const std::vector<uint64_t>& entries() const {
+    return entries_;
+  }
+};
+
+// Interned string literals, laid out as the module's strings section. Each
+// distinct literal is stored once and referenced by the byte offset of its
+// StringHeader, so equal literals share one handle at run time.
+class StringPool {
+private:
+  std::vector<uint8_t> bytes_;
+  std::map<std::string, uint32_t> index_;
+public:
+  uint32_t add(const std::string& text) {
+    auto it = index_.find(text);
+    if (it != index_.end()) {
+      return it->second;
+    }
+    if (text.size() > UINT32_MAX || bytes_.size() > UINT32_MAX - sizeof(pushle::StringHeader) - text.size() - 8) {
+      throw std::runtime_error("String pool too large");
+    }
+    uint32_t offset = bytes_.size();
+    pushle::StringHeader header = {
+      pushle::string_hash(reinterpret_cast<const uint8_t*>(text.data()), text.size()),
+      (uint32_t)text.size(),
+      pushle::STRING_INTERNED,
+    };
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(&header);
+    bytes_.insert(bytes_.end(), raw, raw + sizeof(header));
+    bytes_.insert(bytes_.end(), text.begin(), text.end());
+    bytes_.resize((bytes_.size() + 1 + 7) / 8 * 8, 0); // NUL, then pad
+    index_[text] = offset;
+    return offset;
+  }
+
+  const std::vector<uint8_t>& bytes() const {
+    return bytes_;
+  }
+};
+
+// std::stoull stops at 64 bits. Accepts an optional leading '-' and wraps it
+// around like a cast would; the caller checks the range for signed types.
+unsigned __int128 parse_u128(const std::string& text) {
+  bool negative = text.starts_with("-");
+  unsigned __int128 value = 0;
+  for (size_t i = negative ? 1 : 0; i < text.size(); i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      throw std::invalid_argument("parse_u128: " + text);
+    }
+    unsigned __int128 next = value * 10 + (text[i] - '0');
+    if (next / 10 != value) {
+      throw std::out_of_range("parse_u128: " + text);
+    }
+    value = next;
+  }
+  return negative ? -value : value;
+}
+
+Operand wide_operand(pushle::DataType type, unsigned __int128 value) {
+  Operand operand(type, (uint64_t)value);
+  operand.high = (uint64_t)(value >> 64);
+  return operand;
+}
+
+Operand parse_number(pushle::DataType type, const std::string& text) {
+  switch (type) {
+    case pushle::DataType::_none:
+      throw std::runtime_error("Unexpected number");
+    case pushle::DataType::_i8:
+    case pushle::DataType::_i16:
+    case pushle::DataType::_i32:
+    case pushle::DataType::_i64:
+      return Operand(type, (uint64_t)std::stoll(text));
+    case pushle::DataType::_u8:
+    case pushle::DataType::_bool: // pretty much the same
+    case pushle::DataType::_u16:
+    case pushle::DataType::_u32:
+    case pushle::DataType::_u64:
+      return Operand(type, std::stoull(text));
+    case pushle::DataType::_f32:
+      return Operand(type, std::bit_cast<uint32_t>(std::stof(text)));
+    case pushle::DataType::_f64:
+      return Operand(type, std::bit_cast<uint64_t>(std::stod(text)));
+    case pushle::DataType::_i128: {
+      unsigned __int128 value = parse_u128(text);
+      if (value != 0 && ((__int128)value < 0) != text.starts_with("-")) {
+        throw std::out_of_range("parse_number: " + text);
+      }
+      return wide_operand(type, value);
+    }
+    case pushle::DataType::_u128:
+      if (text.starts_with("-")) {
+        throw std::out_of_range("parse_number: " + text);
+      }
+      return wide_operand(type, parse_u128(text));
+    case pushle::DataType::_f128:
+      return wide_operand(type, std::bit_cast<unsigned __int128>(strtof128(text.c_str(), nullptr)));
+    default:
+      throw std::runtime_error("Unknown type");
+  }
+}
+
+std::vector<Instruction> parse(const std::vector<std::vector<Token>>& program_tokens, StringPool& strings) {
+  auto& registry = pushle::TokenRegistry::getInstance();
+  std::vector<Instruction> program;
+
+  for (auto& tokens : program_tokens) {
+    std::vector<pushle::DataType> arg_types;
+    for (auto& token : tokens) {
+      if (token.is_label() && arg_types.empty()) {
+        program.emplace_back(token.label());
+      } else if (token.is_label()) {
+        if (arg_types.front() != pushle::DataType::_u64) {
+          throw std::runtime_error("Label can only be used with u64");
+        }
+        arg_types.erase(arg_types.begin());
+        program.back().args.emplace_back(token.label());
+      } else if (token.is_string()) {
+        if (arg_types.empty() || program.back().op != pushle::Op::STRK) {
+          throw std::runtime_error("Strings can only be used with strk");
+        }
+        arg_types.erase(arg_types.begin());
+        program.back().args.emplace_back(pushle::DataType::_u32, strings.add(token.text()));
+      } else if (token.is_number()) {
+        if (arg_types.empty()) {
+          throw std::runtime_error("Unexpected number");
+        }
+        program.back().args.push_back(parse_number(arg_types.front(), token.text()));
+        arg_types.erase(arg_types.begin());
+      } else if (arg_types.size() > 0) {
+        throw std::runtime_error("Unexpected token (expected argument)");
+      } else {
+        auto it = registry.getToken(token.text());
+        if (!it.has_value()) {
+          throw std::runtime_error("unknown opcode: " + token.text());
+        }
+        program.emplace_back(it->getOp(), std::vector<Operand>{});
+        arg_types = it->getArguments();
+      }
+    }
+    if (arg_types.size() > 0) {
+      for (auto& t : tokens) {
+        fmt::print("{}\n", t.to_string());
+      }
+      throw std::runtime_error("unexpected end of instruction");
+    }
   }
+  return program;
+}
+
+// Optimizer
+//
+// Every pass works on the flat instruction list. Label definitions are kept
+// in place and act as barriers: a pattern never matches across a label, since
+// control may enter there from elsewhere.
+
+const pushle::DataType T_TYPES[] = {
+  pushle::DataType::_i8, pushle::DataType::_u8, pushle::DataType::_bool, pushle::DataType::_i16,
+  pushle::DataType::_u16, pushle::DataType::_i32, pushle::DataType::_u32, pushle::DataType::_f32,
+  pushle::DataType::_i64, pushle::DataType::_u64, pushle::DataType::_f64,
 };
 
+const pushle::DataType N_TYPES[] = {
+  pushle::DataType::_i8, pushle::DataType::_u8, pushle::DataType::_i16, pushle::DataType::_u16,
+  pushle::DataType::_i32, pushle::DataType::_u32, pushle::DataType::_f32, pushle::DataType::_i64,
+  pushle::DataType::_u64, pushle::DataType::_f64,
+};
+
+const pushle::DataType W_TYPES[] = {
+  pushle::DataType::_i128, pushle::DataType::_u128, pushle::DataType::_f128,
+};
+
+const size_t S_SIZES[] = { 1, 2, 4, 8, 16 };
+
+// Position of `op` within the family of `count` opcodes starting at `first`, or -1.
+int family_index(pushle::Op op, pushle::Op first, size_t count) {
+  return op >= first && op < first + count ? op - first : -1;
+}
+
+bool is_code(const Instruction& ins, pushle::Op first, size_t count) {
+  return !ins.is_label() && family_index(ins.op, first, count) >= 0;
+}
+
+const size_t BRANCH_CONDITIONS = pushle::Op::JNG - pushle::Op::JZ + 1;
+
+// Conditional branch families. Each is laid out as z, nz, l, g, nl, ng groups
+// of `width` opcodes, one per operand type.
+const std::pair<pushle::Op, size_t> BRANCH_FAMILIES[] = {
+  { pushle::Op::JZ, 1 },
+  { pushle::Op::BRLI_Z_I8, std::size(N_TYPES) },
+  { pushle::Op::BR_Z_I8, std::size(N_TYPES) },
+  { pushle::Op::BRI_Z_I8, std::size(N_TYPES) },
+};
+
+bool is_conditional_branch(const Instruction& ins) {
+  for (auto& [first, width] : BRANCH_FAMILIES) {
+    if (is_code(ins, first, BRANCH_CONDITIONS * width)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool is_branch(const Instruction& ins) {
+  return is_conditional_branch(ins) || is_code(ins, pushle::Op::JMP, 1) || is_code(ins, pushle::Op::JERR, 1)
+    || is_code(ins, pushle::Op::LOOP_I8, 2 * std::size(N_TYPES)) || is_code(ins, pushle::Op::LOOPT_I8, std::size(N_TYPES))
+    || is_code(ins, pushle::Op::BRSIZE, 1);
+}
+
+// Branches keep their target in the last operand.
+const Operand& branch_target(const Instruction& ins) {
+  return ins.args.back();
+}
+
+// `ret` is not a terminator: the VM does not implement it yet and falls through.
+bool is_terminator(const Instruction& ins) {
+  return !ins.is_label() && (ins.op == pushle::Op::JMP || ins.op == pushle::Op::SIG);
+}
+
+pushle::Op invert_branch(pushle::Op op) {
+  const int inverse[] = { 1, 0, 4, 5, 2, 3 };
+  for (auto& [first, width] : BRANCH_FAMILIES) {
+    int i = family_index(op, first, BRANCH_CONDITIONS * width);
+    if (i >= 0) {
+      return (pushle::Op)(first + inverse[i / width] * width + i % width);
+    }
+  }
+  throw std::runtime_error("not a conditional branch");
+}
+
+// What is left of a conditional branch once its jump is dropped: fused
+// compares still set reg_cmp or pop their operands, and loops still step
+// their counter. loopt only steps when it would jump, so it has no
+// straight-line equivalent and is never dropped.
+std::vector<Instruction> branch_side_effects(const Instruction& ins) {
+  int t;
+  if ((t = family_index(ins.op, pushle::Op::BRLI_Z_I8, BRANCH_CONDITIONS * std::size(N_TYPES))) >= 0) {
+    t %= std::size(N_TYPES);
+    return { Instruction((pushle::Op)(pushle::Op::CMPLI_I8 + t), { ins.args[0], ins.args[1] }) };
+  }
+  if ((t = family_index(ins.op, pushle::Op::BRI_Z_I8, BRANCH_CONDITIONS * std::size(N_TYPES))) >= 0) {
+    t %= std::size(N_TYPES);
+    return { Instruction((pushle::Op)(pushle::Op::CMPI_I8 + t), { ins.args[0] }) };
+  }
+  if ((t = family_index(ins.op, pushle::Op::BR_Z_I8, BRANCH_CONDITIONS * std::size(N_TYPES))) >= 0) {
+    uint64_t size = Operand(N_TYPES[t % std::size(N_TYPES)], 0).size();
+    Instruction pop(pushle::Op::POPG, { Operand(pushle::DataType::_u8, size) });
+    return { pop, pop };
+  }
+  if ((t = family_index(ins.op, pushle::Op::LOOP_I8, 2 * std::size(N_TYPES))) >= 0) {
+    bool up = t < (int)std::size(N_TYPES);
+    t %= std::size(N_TYPES);
+    int k = t >= 2 ? t + 1 : t;
+    Operand limit = up ? ins.args[1] : Operand(N_TYPES[t], 0);
+    return {
+      Instruction((pushle::Op)(pushle::Op::PUSHL_I8 + k), { ins.args[0] }),
+      Instruction((pushle::Op)((up ? pushle::Op::INC_I8 : pushle::Op::DEC_I8) + t), {}),
+      Instruction((pushle::Op)(pushle::Op::POPL_I8 + k), { ins.args[0] }),
+      Instruction((pushle::Op)(pushle::Op::CMPLI_I8 + t), { ins.args[0], limit }),
+    };
+  }
+  return {};
+}
+
+// Instructions that only touch locals (and possibly reg_cmp), never the stack.
+bool is_local_op(const Instruction& ins) {
+  return is_code(ins, pushle::Op::SETL_I8, std::size(T_TYPES))
+    || is_code(ins, pushle::Op::MOVL_I8, pushle::Op::CMPI_I8 - pushle::Op::MOVL_I8)
+    || is_code(ins, pushle::Op::MOVL2_I8, std::size(T_TYPES));
+}
+
+// Bytes pushed by an instruction whose only effect is pushing a value, else 0.
+size_t pure_push_size(const Instruction& ins) {
+  if (ins.is_label()) {
+    return 0;
+  }
+  int i;
+  if ((i = family_index(ins.op, pushle::Op::PUSH_I8, std::size(T_TYPES))) >= 0) {
+    return Operand(T_TYPES[i], 0).size();
+  }
+  if ((i = family_index(ins.op, pushle::Op::PUSHL_I8, std::size(T_TYPES))) >= 0) {
+    return Operand(T_TYPES[i], 0).size();
+  }
+  if (is_code(ins, pushle::Op::PUSH_I128, std::size(W_TYPES)) || is_code(ins, pushle::Op::PUSHL_I128, std::size(W_TYPES))) {
+    return 16;
+  }
+  if ((i = family_index(ins.op, pushle::Op::DUP1, std::size(S_SIZES))) >= 0) {
+    return S_SIZES[i];
+  }
+  if (ins.op == pushle::Op::DUPG) {
+    return ins.args[0].bits;
+  }
+  if (ins.op == pushle::Op::STRK) {
+    return 8;
+  }
+  return 0;
+}
+
+// Bytes dropped by a pop instruction, else 0.
+size_t pop_size(const Instruction& ins) {
+  if (ins.is_label()) {
+    return 0;
+  }
+  int i;
+  if ((i = family_index(ins.op, pushle::Op::POP1, std::size(S_SIZES))) >= 0) {
+    return S_SIZES[i];
+  }
+  if (ins.op == pushle::Op::POPG) {
+    return ins.args[0].bits;
+  }
+  return 0;
+}
+
+// Rewrites `rnew` to `rnewl` where the new ref provably stays local, so the
+// VM can skip its reference count. The ref must go straight into a local with
+// `popl_ref`, and every `pushl_ref` of that local must feed an `rload_<t>`,
+// an `rrelease`, or the ref side of an `rstore_<t>` behind a single push of
+// the value. Any other use counts as an escape, `rcount` included, as it
+// would see the count that is no longer kept. Allocations inside a loop
+// (between a label and a backward branch to it) are left counted too, as
+// local refs are only reclaimed when the VM is reset.
+void elide_local_refs(std::vector<Instruction>& program) {
+  using pushle::Op;
+  std::map<std::string, size_t> labels;
+  for (size_t i = 0; i < program.size(); i++) {
+    if (program[i].is_label()) {
+      labels[program[i].label] = i;
+    }
+  }
+
+  std::vector<std::pair<size_t, size_t>> loops;
+  for (size_t i = 0; i < program.size(); i++) {
+    for (auto& arg : program[i].args) {
+      auto it = arg.is_label() ? labels.find(arg.label) : labels.end();
+      if (it != labels.end() && it->second <= i) {
+        loops.emplace_back(it->second, i);
+      }
+    }
+  }
+
+  // a value push that cannot be a copy of the ref itself
+  auto value_push = [](const Instruction& ins) {
+    return is_code(ins, Op::PUSH_I8, std::size(T_TYPES)) || is_code(ins, Op::PUSHL_I8, std::size(T_TYPES))
+      || is_code(ins, Op::PUSH_I128, std::size(W_TYPES)) || is_code(ins, Op::PUSHL_I128, std::size(W_TYPES));
+  };
+  std::set<uint64_t> escaping;
+  for (size_t i = 0; i < program.size(); i++) {
+    if (!is_code(program[i], Op::PUSHL_REF, 1)) {
+      continue;
+    }
+    bool contained = i + 1 < program.size()
+      && (is_code(program[i + 1], Op::RLOAD_I8, std::size(T_TYPES) + 1) || is_code(program[i + 1], Op::RRELEASE, 1)
+          || (i + 2 < program.size() && value_push(program[i + 1])
+              && is_code(program[i + 2], Op::RSTORE_I8, std::size(T_TYPES) + 1)));
+    if (!contained) {
+      escaping.insert(program[i].args[0].bits);
+    }
+  }
+
+  for (size_t i = 0; i + 1 < program.size(); i++) {
+    if (!is_code(program[i], Op::RNEW, 1) || !is_code(program[i + 1], Op::POPL_REF, 1)
+        || escaping.count(program[i + 1].args[0].bits)) {
+      continue;
+    }
+    bool in_loop = false;
+    for (auto& [start, end] : loops) {
+      in_loop |= start <= i && i <= end;
+    }
+    if (!in_loop) {
+      program[i].op = Op::RNEWL;
+    }
+  }
+}
+
+// Stack-local rewrites, applied as each instruction is appended to the output
+// so that a rewrite can expose the next one:
+//   pushl_<t> a; popl_<t> a             -> (nothing)
+//   push_<t> c; popl_<t> a              -> setl_<t> a c
+//   <push n bytes>; <local ops>; pop<n> -> <local ops>
+//   <push n>; <push n>; swap<n>; pop<n> -> <second push>
+//   swap<n>; swap<n>                    -> (nothing)
+//   cvt_<n>_<n>                         -> (nothing)
+bool peephole(std::vector<Instruction>& program) {
+  using pushle::Op;
+  std::vector<Instruction> out;
+  bool changed = false;
+
+  for (auto& ins : program) {
+    // the conversion matrix is laid out from-major, so identities sit on its diagonal
+    int cvt = ins.is_label() ? -1 : family_index(ins.op, Op::CVT_I8_I8, std::size(N_TYPES) * std::size(N_TYPES));
+    if (cvt >= 0 && cvt % (std::size(N_TYPES) + 1) == 0) {
+      changed = true;
+      continue;
+    }
+
+    int popl = ins.is_label() ? -1 : family_index(ins.op, Op::POPL_I8, std::size(T_TYPES));
+    if (popl >= 0 && !out.empty() && is_code(out.back(), Op::PUSHL_I8, std::size(T_TYPES))
+        && out.back().op - Op::PUSHL_I8 == popl && out.back().args[0].bits == ins.args[0].bits) {
+      out.pop_back();
+      changed = true;
+      continue;
+    }
+    if (popl >= 0 && !out.empty() && is_code(out.back(), Op::PUSH_I8, std::size(T_TYPES))
+        && out.back().op - Op::PUSH_I8 == popl) {
+      out.back() = Instruction((Op)(Op::SETL_I8 + popl), { ins.args[0], out.back().args[0] });
+      changed = true;
+      continue;
+    }
+
+    size_t n = pop_size(ins);
+    if (n > 0) {
+      size_t k = out.size();
+      while (k > 0 && is_local_op(out[k - 1])) {
+        k--;
+      }
+      if (k > 0 && pure_push_size(out[k - 1]) == n) {
+        out.erase(out.begin() + (k - 1));
+        changed = true;
+        continue;
+      }
+      size_t m = out.size();
+      if (m >= 3 && !out[m - 1].is_label() && pure_push_size(out[m - 2]) == n && pure_push_size(out[m - 3]) == n
+          && ((out[m - 1].op == Op::SWAPG && out[m - 1].args[0].bits == n)
+              || (family_index(out[m - 1].op, Op::SWAP1, std::size(S_SIZES)) >= 0 && S_SIZES[out[m - 1].op - Op::SWAP1] == n))) {
+        out.pop_back();
+        out.erase(out.end() - 2);
+        changed = true;
+        continue;
+      }
+    }
+
+    bool swap = !ins.is_label() && (ins.op == Op::SWAPG || family_index(ins.op, Op::SWAP1, std::size(S_SIZES)) >= 0);
+    if (swap && !out.empty() && !out.back().is_label() && out.back().op == ins.op
+        && (ins.op != Op::SWAPG || out.back().args[0].bits == ins.args[0].bits)) {
+      out.pop_back();
+      changed = true;
+      continue;
+    }
+
+    out.push_back(ins);
+  }
+
+  program = std::move(out);
+  return changed;
+}
+
+// Lowers stack sequences that only shuffle locals to the register-style ops:
+//   pushl_<t> a; popl_<t> d                -> movl_<t> d a
+//   pushl_<n> a; pushl_<n> b; <op>_<n>; popl_<n> d
+//                                          -> pushl_<n> a; <op>l_<n> d a b
+//   pushl_<n> a; pushl_<n> b; cmp_<n>      -> cmpl_<n> a b; pushl_<n> a; pushl_<n> b
+//   pushl_<n> a; push_<n> c; cmp_<n>       -> cmpli_<n> a c; pushl_<n> a; push_<n> c
+//   push_<n> c; cmp_<n>                    -> cmpi_<n> c; push_<n> c
+//   cmpli_<n> a c; j<cc> target            -> brli_<cc>_<n> a c target
+//   cmpi_<n> c; j<cc> target               -> bri_<cc>_<n> c target
+//   movl_<t> d a; movl_<t> e b             -> movl2_<t> d a e b
+//   pushl_ref a; pushl_u64 i; aload_<t>    -> aloadl_<t> a i
+//   pushl_ref a; pushl_u64 i; <push>; astore_<t>
+//                                          -> <push>; astorel_<t> a i
+// The pushes left behind are usually cancelled by the pops that follow (see
+// peephole()), as local ops do not touch the stack.
+bool lower_local_ops(std::vector<Instruction>& program) {
+  using pushle::Op;
+  const size_t n = std::size(N_TYPES);
+  std::vector<Instruction> out;
+  bool changed = false;
+
+  // numeric index of a T-family opcode, or -1 for the bool variant
+  auto numeric = [](int index) { return index == 2 ? -1 : index > 2 ? index - 1 : index; };
+  auto t_index = [](int index) { return index >= 2 ? index + 1 : index; };
+
+  for (auto& ins : program) {
+    size_t m = out.size();
+    int i;
+
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::POPL_I8, std::size(T_TYPES))) >= 0) {
+      if (m >= 1 && is_code(out[m - 1], (Op)(Op::PUSHL_I8 + i), 1) && out[m - 1].args[0].bits != ins.args[0].bits) {
+        out[m - 1] = Instruction((Op)(Op::MOVL_I8 + i), { ins.args[0], out[m - 1].args[0] });
+        changed = true;
+        continue;
+      }
+      int k = numeric(i);
+      if (k >= 0 && m >= 3 && is_code(out[m - 3], (Op)(Op::PUSHL_I8 + i), 1) && is_code(out[m - 2], (Op)(Op::PUSHL_I8 + i), 1)) {
+        const Op families[][2] = {
+          { Op::ADD_I8, Op::ADDL_I8 }, { Op::SUB_I8, Op::SUBL_I8 }, { Op::MUL_I8, Op::MULL_I8 },
+          { Op::DIV_I8, Op::DIVL_I8 }, { Op::REM_I8, Op::REML_I8 },
+        };
+        bool lowered = false;
+        for (auto& [stack_op, local_op] : families) {
+          if (is_code(out[m - 1], (Op)(stack_op + k), 1)) {
+            out[m - 1] = Instruction((Op)(local_op + k), { ins.args[0], out[m - 3].args[0], out[m - 2].args[0] });
+            out.erase(out.end() - 2);
+            lowered = true;
+            break;
+          }
+        }
+        if (lowered) {
+          changed = true;
+          continue;
+        }
+      }
+    }
+
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::CMP_I8, n)) >= 0) {
+      Op pushl = (Op)(Op::PUSHL_I8 + t_index(i));
+      Op push = (Op)(Op::PUSH_I8 + t_index(i));
+      if (m >= 2 && is_code(out[m - 2], pushl, 1) && is_code(out[m - 1], pushl, 1)) {
+        out.insert(out.end() - 2, Instruction((Op)(Op::CMPL_I8 + i), { out[m - 2].args[0], out[m - 1].args[0] }));
+        changed = true;
+        continue;
+      }
+      if (m >= 2 && is_code(out[m - 2], pushl, 1) && is_code(out[m - 1], push, 1)) {
+        out.insert(out.end() - 2, Instruction((Op)(Op::CMPLI_I8 + i), { out[m - 2].args[0], out[m - 1].args[0] }));
+        changed = true;
+        continue;
+      }
+      if (m >= 1 && is_code(out[m - 1], push, 1)) {
+        out.insert(out.end() - 1, Instruction((Op)(Op::CMPI_I8 + i), { out[m - 1].args[0] }));
+        changed = true;
+        continue;
+      }
+    }
+
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::ALOAD_I8, std::size(T_TYPES))) >= 0
+        && m >= 2 && is_code(out[m - 2], Op::PUSHL_REF, 1) && is_code(out[m - 1], Op::PUSHL_U64, 1)) {
+      out[m - 2] = Instruction((Op)(Op::ALOADL_I8 + i), { out[m - 2].args[0], out[m - 1].args[0] });
+      out.pop_back();
+      changed = true;
+      continue;
+    }
+
+    // the value must be a plain push: a dup would copy the index instead
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::ASTORE_I8, std::size(T_TYPES))) >= 0
+        && m >= 3 && is_code(out[m - 3], Op::PUSHL_REF, 1) && is_code(out[m - 2], Op::PUSHL_U64, 1)
+        && (is_code(out[m - 1], Op::PUSH_I8, std::size(T_TYPES)) || is_code(out[m - 1], Op::PUSHL_I8, std::size(T_TYPES)))
+        && pure_push_size(out[m - 1]) == Operand(T_TYPES[i], 0).size()) {
+      Instruction store((Op)(Op::ASTOREL_I8 + i), { out[m - 3].args[0], out[m - 2].args[0] });
+      out[m - 3] = out[m - 1];
+      out.erase(out.end() - 2, out.end());
+      out.push_back(store);
+      changed = true;
+      continue;
+    }
+
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::JZ, BRANCH_CONDITIONS)) >= 0
+        && m >= 1 && is_code(out[m - 1], Op::CMPLI_I8, n)) {
+      Op fused = (Op)(Op::BRLI_Z_I8 + i * n + (out[m - 1].op - Op::CMPLI_I8));
+      out[m - 1] = Instruction(fused, { out[m - 1].args[0], out[m - 1].args[1], ins.args[0] });
+      changed = true;
+      continue;
+    }
+
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::JZ, BRANCH_CONDITIONS)) >= 0
+        && m >= 1 && is_code(out[m - 1], Op::CMPI_I8, n)) {
+      Op fused = (Op)(Op::BRI_Z_I8 + i * n + (out[m - 1].op - Op::CMPI_I8));
+      out[m - 1] = Instruction(fused, { out[m - 1].args[0], ins.args[0] });
+      changed = true;
+      continue;
+    }
+
+    if ((i = ins.is_label() ? -1 : family_index(ins.op, Op::MOVL_I8, std::size(T_TYPES))) >= 0
+        && m >= 1 && is_code(out[m - 1], ins.op, 1)) {
+      out[m - 1] = Instruction((Op)(Op::MOVL2_I8 + i), { out[m - 1].args[0], out[m - 1].args[1], ins.args[0], ins.args[1] });
+      changed = true;
+      continue;
+    }
+
+    out.push_back(ins);
+  }
+
+  program = std::move(out);
+  return changed;
+}
+
+template <typename T>
+uint64_t fold(pushle::Op family, uint64_t a_bits, uint64_t b_bits) {
+  using pushle::Op;
+  if constexpr (std::is_floating_point_v<T>) {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    T a = std::bit_cast<T>((Bits)a_bits);
+    T b = std::bit_cast<T>((Bits)b_bits);
+    T r = family == Op::ADD_I8 ? a + b : family == Op::SUB_I8 ? a - b : a * b;
+    return std::bit_cast<Bits>(r);
+  } else {
+    // wrap around like the VM does, without signed overflow
+    uint64_t r = family == Op::ADD_I8 ? a_bits + b_bits : family == Op::SUB_I8 ? a_bits - b_bits : a_bits * b_bits;
+    return (uint64_t)(T)r;
+  }
+}
+
+uint64_t fold(pushle::Op family, pushle::DataType type, uint64_t a_bits, uint64_t b_bits) {
+  switch (type) {
+    case pushle::DataType::_i8:  return fold<int8_t>(family, a_bits, b_bits);
+    case pushle::DataType::_u8:  return fold<uint8_t>(family, a_bits, b_bits);
+    case pushle::DataType::_i16: return fold<int16_t>(family, a_bits, b_bits);
+    case pushle::DataType::_u16: return fold<uint16_t>(family, a_bits, b_bits);
+    case pushle::DataType::_i32: return fold<int32_t>(family, a_bits, b_bits);
+    case pushle::DataType::_u32: return fold<uint32_t>(family, a_bits, b_bits);
+    case pushle::DataType::_f32: return fold<float>(family, a_bits, b_bits);
+    case pushle::DataType::_i64: return fold<int64_t>(family, a_bits, b_bits);
+    case pushle::DataType::_u64: return fold<uint64_t>(family, a_bits, b_bits);
+    case pushle::DataType::_f64: return fold<double>(family, a_bits, b_bits);
+    default:
+      throw std::runtime_error("Unknown type");
+  }
+}
+
+// Evaluates arithmetic on literals. Binary operators keep the second operand
+// on the stack, so only the top value is replaced:
+//   push_<n> a; push_<n> b; add_<n> -> push_<n> a; push_<n> a+b   (also sub, mul)
+//   push_<n> a; inc_<n>             -> push_<n> a+1               (also dec)
+bool fold_constants(std::vector<Instruction>& program) {
+  using pushle::Op;
+  const size_t n = std::size(N_TYPES);
+  std::vector<Instruction> out;
+  bool changed = false;
+
+  // push_<n> opcode for the numeric type at `index`, skipping push_bool
+  auto push_op = [](int index) { return (Op)(Op::PUSH_I8 + (index >= 2 ? index + 1 : index)); };
+
+  for (auto& ins : program) {
+    size_t m = out.size();
+    for (Op family : { Op::ADD_I8, Op::SUB_I8, Op::MUL_I8 }) {
+      int i = ins.is_label() ? -1 : family_index(ins.op, family, n);
+      if (i >= 0 && m >= 2 && is_code(out[m - 1], push_op(i), 1) && is_code(out[m - 2], push_op(i), 1)) {
+        uint64_t& top = out[m - 1].args[0].bits;
+        top = fold(family, N_TYPES[i], out[m - 2].args[0].bits, top);
+        changed = true;
+        goto next;
+      }
+    }
+    for (Op family : { Op::INC_I8, Op::DEC_I8 }) {
+      int i = ins.is_label() ? -1 : family_index(ins.op, family, n);
+      if (i >= 0 && m >= 1 && is_code(out[m - 1], push_op(i), 1)) {
+        uint64_t& top = out[m - 1].args[0].bits;
+        uint64_t one = N_TYPES[i] == pushle::DataType::_f32 ? std::bit_cast<uint32_t>(1.0f)
+                     : N_TYPES[i] == pushle::DataType::_f64 ? std::bit_cast<uint64_t>(1.0) : 1;
+        top = fold(family == Op::INC_I8 ? Op::ADD_I8 : Op::SUB_I8, N_TYPES[i], top, one);
+        changed = true;
+        goto next;
+      }
+    }
+    out.push_back(ins);
+  next:;
+  }
+
+  program = std::move(out);
+  return changed;
+}
+
+// Index of the first instruction that is not a label definition at or after `i`.
+size_t skip_labels(const std::vector<Instruction>& program, size_t i) {
+  while (i < program.size() && program[i].is_label()) {
+    i++;
+  }
+  return i;
+}
+
+std::map<std::string, size_t> label_indices(const std::vector<Instruction>& program) {
+  std::map<std::string, size_t> labels;
+  for (size_t i = 0; i < program.size(); i++) {
+    if (program[i].is_label()) {
+      labels[program[i].label] = i;
+    }
+  }
+  return labels;
+}
+
+// Retargets branches whose destination is an unconditional jump (or the same
+// conditional branch, as nothing in between touches the comparison register),
+// turns `j<cc> a; jmp b; @a` into `j<!cc> b; @a`, and drops branches to the
+// next instruction.
+bool thread_jumps(std::vector<Instruction>& program) {
+  bool changed = false;
+  auto labels = label_indices(program);
+
+  for (auto& ins : program) {
+    if (!is_branch(ins) || !branch_target(ins).is_label()) {
+      continue;
+    }
+    std::set<std::string> seen = { branch_target(ins).label };
+    while (true) {
+      auto it = labels.find(branch_target(ins).label);
+      if (it == labels.end()) {
+        break;
+      }
+      size_t j = skip_labels(program, it->second);
+      // only plain jumps can be followed: a fused compare reads locals that may differ
+      if (j == program.size() || !is_code(program[j], pushle::Op::JZ, BRANCH_CONDITIONS + 1)
+          || !branch_target(program[j]).is_label()
+          || (program[j].op != pushle::Op::JMP && program[j].op != ins.op)
+          || !seen.insert(branch_target(program[j]).label).second) {
+        break;
+      }
+      ins.args.back() = branch_target(program[j]);
+      changed = true;
+    }
+  }
+
+  // whether the label `label` is defined anywhere in [begin, end)
+  auto defined_in = [&](const std::string& label, size_t begin, size_t end) {
+    auto it = labels.find(label);
+    return it != labels.end() && it->second >= begin && it->second < end;
+  };
+
+  std::vector<Instruction> out;
+  for (size_t i = 0; i < program.size(); i++) {
+    Instruction ins = program[i];
+    if (is_conditional_branch(ins) && branch_target(ins).is_label() && i + 1 < program.size()
+        && is_code(program[i + 1], pushle::Op::JMP, 1) && branch_target(program[i + 1]).is_label()
+        && defined_in(branch_target(ins).label, i + 2, skip_labels(program, i + 2))) {
+      ins.op = invert_branch(ins.op);
+      ins.args.back() = branch_target(program[i + 1]);
+      i++;
+      changed = true;
+    }
+    if (is_branch(ins) && !is_code(ins, pushle::Op::LOOPT_I8, std::size(N_TYPES)) && branch_target(ins).is_label()
+        && defined_in(branch_target(ins).label, i + 1, skip_labels(program, i + 1))) {
+      for (auto& effect : branch_side_effects(ins)) {
+        out.push_back(effect);
+      }
+      changed = true;
+      continue;
+    }
+    out.push_back(ins);
+  }
+
+  program = std::move(out);
+  return changed;
+}
+
+// Rotates counted loops so that stepping the counter, comparing it and
+// branching back take one instruction:
+//   @top; brli_nl_<n> i c @end; <body>; pushl_<n> i; inc_<n>; popl_<n> i; jmp @top
+//     -> @top; brli_nl_<n> i c @end; @body; <body>; loop_<n> i c @body; jmp @end
+// and likewise `brli_z_<n> i 0` with dec_<n> into `djnz_<n> i @body`. A
+// counter kept on the stack is stepped right after the test instead, so the
+// body may only hold local ops, which leave it on top:
+//   @top; bri_nl_<n> c @end; inc_<n>; <local ops>; jmp @top
+//     -> @top; bri_nl_<n> c @end; inc_<n>; @body; <local ops>; loopt_<n> c @body; jmp @end
+// The test at the top stays behind as the entry check; thread_jumps() drops
+// the jump to @end when @end follows.
+bool form_counted_loops(std::vector<Instruction>& program) {
+  using pushle::Op;
+  const size_t n = std::size(N_TYPES);
+  auto labels = label_indices(program);
+
+  for (size_t j = 0; j < program.size(); j++) {
+    if (!is_code(program[j], Op::JMP, 1) || !branch_target(program[j]).is_label()) {
+      continue;
+    }
+    auto it = labels.find(branch_target(program[j]).label);
+    if (it == labels.end() || it->second > j) {
+      continue;
+    }
+    size_t g = skip_labels(program, it->second);
+    if (g + 2 > j || !is_branch(program[g]) || !branch_target(program[g]).is_label()) {
+      continue;
+    }
+    Instruction guard = program[g];
+    std::string body = it->first + ".loop";
+    while (labels.count(body)) {
+      body += "'";
+    }
+    int t;
+    if ((t = family_index(guard.op, Op::BRI_NL_I8, n)) >= 0 && is_code(program[g + 1], (Op)(Op::INC_I8 + t), 1)
+        && std::all_of(program.begin() + (g + 2), program.begin() + j, is_local_op)) {
+      std::vector<Instruction> out(program.begin(), program.begin() + g + 2);
+      out.push_back(Instruction(body));
+      out.insert(out.end(), program.begin() + (g + 2), program.begin() + j);
+      out.push_back(Instruction((Op)(Op::LOOPT_I8 + t), { guard.args[0], Operand(body) }));
+      out.push_back(Instruction(Op::JMP, { branch_target(guard) }));
+      out.insert(out.end(), program.begin() + (j + 1), program.end());
+      program = std::move(out);
+      return true;
+    }
+    if (g + 4 > j) {
+      continue;
+    }
+    bool up;
+    if ((t = family_index(guard.op, Op::BRLI_NL_I8, n)) >= 0) {
+      up = true;
+    } else if ((t = family_index(guard.op, Op::BRLI_Z_I8, n)) >= 0 && guard.args[1].bits == 0) {
+      up = false;
+    } else {
+      continue;
+    }
+    int k = t >= 2 ? t + 1 : t;
+    Op step = (Op)((up ? Op::INC_I8 : Op::DEC_I8) + t);
+    if (!is_code(program[j - 3], (Op)(Op::PUSHL_I8 + k), 1) || program[j - 3].args[0].bits != guard.args[0].bits
+        || !is_code(program[j - 2], step, 1)
+        || !is_code(program[j - 1], (Op)(Op::POPL_I8 + k), 1) || program[j - 1].args[0].bits != guard.args[0].bits) {
+      continue;
+    }
+
+    std::vector<Instruction> out(program.begin(), program.begin() + g + 1);
+    out.push_back(Instruction(body));
+    out.insert(out.end(), program.begin() + g + 1, program.begin() + (j - 3));
+    if (up) {
+      out.push_back(Instruction((Op)(Op::LOOP_I8 + t), { guard.args[0], guard.args[1], Operand(body) }));
+    } else {
+      out.push_back(Instruction((Op)(Op::DJNZ_I8 + t), { guard.args[0], Operand(body) }));
+    }
+    out.push_back(Instruction(Op::JMP, { branch_target(guard) }));
+    out.insert(out.end(), program.begin() + (j + 1), program.end());
+    program = std::move(out);
+    return true;
+  }
+  return false;
+}
+
+// Moves the exit test of other loops to the bottom, so that an iteration
+// takes one conditional branch instead of a jump back and the test:
+//   @top; <branch> @end; <body>; jmp @top
+//     -> @top; <branch> @end; @body; <body>; <inverted branch> @body; jmp @end
+// The test is a single instruction, so running a copy of it at the bottom
+// does the same as jumping back to it. Only loops that exit forward are
+// rotated; optimize() leaves this until nothing else applies, so that
+// form_counted_loops() sees counted loops first.
+bool rotate_loops(std::vector<Instruction>& program) {
+  auto labels = label_indices(program);
+
+  for (size_t j = 0; j < program.size(); j++) {
+    if (!is_code(program[j], pushle::Op::JMP, 1) || !branch_target(program[j]).is_label()) {
+      continue;
+    }
+    auto it = labels.find(branch_target(program[j]).label);
+    if (it == labels.end() || it->second > j) {
+      continue;
+    }
+    size_t g = skip_labels(program, it->second);
+    if (g >= j || !is_conditional_branch(program[g]) || !branch_target(program[g]).is_label()) {
+      continue;
+    }
+    auto exit = labels.find(branch_target(program[g]).label);
+    if (exit == labels.end() || exit->second <= j) {
+      continue;
+    }
+
+    std::string body = it->first + ".loop";
+    while (labels.count(body)) {
+      body += "'";
+    }
+    Instruction test = program[g];
+    test.op = invert_branch(test.op);
+    test.args.back() = Operand(body);
+    std::vector<Instruction> out(program.begin(), program.begin() + g + 1);
+    out.push_back(Instruction(body));
+    out.insert(out.end(), program.begin() + g + 1, program.begin() + j);
+    out.push_back(test);
+    out.push_back(Instruction(pushle::Op::JMP, { branch_target(program[g]) }));
+    out.insert(out.end(), program.begin() + (j + 1), program.end());
+    program = std::move(out);
+    return true;
+  }
+  return false;
+}
+
+// Indices of the locals `ins` writes.
+std::vector<int> written_locals(const Instruction& ins) {
+  using pushle::Op;
+  const size_t t = std::size(T_TYPES), n = std::size(N_TYPES), w = std::size(W_TYPES);
+  bool writes = is_code(ins, Op::POPL_I8, t) || is_code(ins, Op::SETL_I8, t) || is_code(ins, Op::POPL_REF, 1)
+    || is_code(ins, Op::POPL_I128, w) || is_code(ins, Op::SETL_I128, w)
+    || is_code(ins, Op::MOVL_I8, t) || is_code(ins, Op::ADDL_I8, 5 * n) || is_code(ins, Op::LOOP_I8, 2 * n);
+  if (is_code(ins, Op::MOVL2_I8, t)) {
+    return { (int)ins.args[0].bits, (int)ins.args[2].bits };
+  }
+  if (writes) {
+    return { (int)ins.args[0].bits };
+  }
+  return {};
+}
+
+// Versions counted loops over arrays. The body of a u64 loop only runs with
+// its counter below the limit, so if the body never writes the counter, one
+// brsize per array ahead of the loop covers every access indexed by it; the
+// loop then runs either a copy of the body with unchecked accesses or the
+// original one:
+//   brli_nl_u64 i c @end; @body; <body>; loop_u64 i c @body
+//     -> brli_nl_u64 i c @end; brsize a c*<size> @body.checked;
+//        @body; <body, unchecked>; loop_u64 i c @body; jmp @next;
+//        @body.checked; <body>; loop_u64 i c @body.checked; @next
+// Arrays whose local the body writes stay checked, and loops whose body can
+// be entered from outside are left alone.
+bool hoist_bounds_checks(std::vector<Instruction>& program) {
+  using pushle::Op;
+  const size_t t = std::size(T_TYPES);
+  auto labels = label_indices(program);
+  std::map<std::string, std::vector<size_t>> uses; // label -> branches to it
+  std::set<std::string> taken;
+  for (size_t k = 0; k < program.size(); k++) {
+    for (auto& arg : program[k].args) {
+      if (arg.is_label()) {
+        uses[arg.label].push_back(k);
+        if (!is_branch(program[k])) {
+          taken.insert(arg.label);
+        }
+      }
+    }
+  }
+  std::set<std::string> fresh_names;
+  auto fresh = [&](std::string name) {
+    while (labels.count(name) || fresh_names.count(name)) {
+      name += "'";
+    }
+    fresh_names.insert(name);
+    return name;
+  };
+
+  for (size_t l = 0; l < program.size(); l++) {
+    if (!is_code(program[l], Op::LOOP_U64, 1) || !branch_target(program[l]).is_label()) {
+      continue;
+    }
+    Instruction loop = program[l];
+    auto it = labels.find(branch_target(loop).label);
+    if (it == labels.end() || it->second > l) {
+      continue;
+    }
+    size_t begin = it->second;
+    while (begin > 0 && program[begin - 1].is_label()) {
+      begin--;
+    }
+    uint64_t i = loop.args[0].bits;
+    if (begin == 0 || !is_code(program[begin - 1], Op::BRLI_NL_U64, 1)
+        || program[begin - 1].args[0].bits != i || program[begin - 1].args[1].bits != loop.args[1].bits) {
+      continue;
+    }
+
+    std::map<uint64_t, size_t> sizes; // array local -> widest element accessed
+    std::set<int> written;
+    bool closed = true;
+    for (size_t k = begin; k < l; k++) {
+      const Instruction& ins = program[k];
+      if (ins.is_label()) {
+        for (size_t use : uses[ins.label]) {
+          closed = closed && use >= begin && use <= l;
+        }
+        closed = closed && !taken.count(ins.label);
+        continue;
+      }
+      for (int local : written_locals(ins)) {
+        written.insert(local);
+      }
+      int e;
+      if ((e = family_index(ins.op, Op::ALOADL_I8, t)) >= 0 || (e = family_index(ins.op, Op::ASTOREL_I8, t)) >= 0) {
+        if (ins.args[1].bits == i) {
+          size_t& size = sizes[ins.args[0].bits];
+          size = std::max(size, Operand(T_TYPES[e], 0).size());
+        }
+      }
+    }
+    if (!closed || written.count((int)i)) {
+      continue;
+    }
+    uint64_t limit = loop.args[1].bits;
+    for (auto a = sizes.begin(); a != sizes.end();) {
+      a = written.count((int)a->first) || limit > UINT64_MAX / a->second ? sizes.erase(a) : std::next(a);
+    }
+    if (sizes.empty()) {
+      continue;
+    }
+
+    std::map<std::string, std::string> renamed;
+    for (size_t k = begin; k < l; k++) {
+      if (program[k].is_label()) {
+        renamed[program[k].label] = fresh(program[k].label + ".checked");
+      }
+    }
+    std::string next = fresh(it->first + ".next");
+
+    std::vector<Instruction> out(program.begin(), program.begin() + begin);
+    for (auto& [array, size] : sizes) {
+      out.push_back(Instruction(Op::BRSIZE, {
+        Operand(pushle::DataType::_u8, array), Operand(pushle::DataType::_u64, limit * size), Operand(renamed[it->first]),
+      }));
+    }
+    for (size_t k = begin; k <= l; k++) {
+      Instruction ins = program[k];
+      int e;
+      if (!ins.is_label() && ins.args.size() == 2 && ins.args[1].bits == i && sizes.count(ins.args[0].bits)) {
+        if ((e = family_index(ins.op, Op::ALOADL_I8, t)) >= 0) {
+          ins.op = (Op)(Op::ALOADLU_I8 + e);
+        } else if ((e = family_index(ins.op, Op::ASTOREL_I8, t)) >= 0) {
+          ins.op = (Op)(Op::ASTORELU_I8 + e);
+        }
+      }
+      out.push_back(ins);
+    }
+    out.push_back(Instruction(Op::JMP, { Operand(next) }));
+    for (size_t k = begin; k <= l; k++) {
+      Instruction ins = program[k];
+      if (ins.is_label()) {
+        ins.label = renamed[ins.label];
+      }
+      for (auto& arg : ins.args) {
+        if (arg.is_label() && renamed.count(arg.label)) {
+          arg.label = renamed[arg.label];
+        }
+      }
+      out.push_back(ins);
+    }
+    out.push_back(Instruction(next));
+    out.insert(out.end(), program.begin() + (l + 1), program.end());
+    program = std::move(out);
+    return true;
+  }
+  return false;
+}
+
+struct BasicBlock {
+  size_t begin; // first instruction, including leading label definitions
+  size_t end;
+  std::vector<size_t> successors;
+};
+
+// Splits the program at label definitions and after branches, and links each
+// block to its branch target and its fall-through block.
+std::vector<BasicBlock> build_cfg(const std::vector<Instruction>& program) {
+  std::vector<BasicBlock> blocks;
+  std::map<std::string, size_t> block_of_label;
+
+  for (size_t i = 0; i < program.size(); i++) {
+    bool leader = i == 0
+      || (program[i].is_label() && !program[i - 1].is_label())
+      || is_branch(program[i - 1]) || is_terminator(program[i - 1]);
+    if (leader) {
+      if (!blocks.empty()) {
+        blocks.back().end = i;
+      }
+      blocks.push_back({ i, program.size(), {} });
+    }
+    if (program[i].is_label()) {
+      block_of_label[program[i].label] = blocks.size() - 1;
+    }
+  }
+
+  for (size_t b = 0; b < blocks.size(); b++) {
+    const Instruction& last = program[blocks[b].end - 1];
+    if (is_branch(last) && branch_target(last).is_label()) {
+      auto it = block_of_label.find(branch_target(last).label);
+      if (it == block_of_label.end()) {
+        throw std::runtime_error("unknown label: " + branch_target(last).label);
+      }
+      blocks[b].successors.push_back(it->second);
+    }
+    if (!is_terminator(last) && b + 1 < blocks.size()) {
+      blocks[b].successors.push_back(b + 1);
+    }
+  }
+  return blocks;
+}
+
+// Whether reg_cmp may be read before it is written again, at the start of
+// each block. Only the plain conditional jumps read it.
+std::vector<bool> compare_liveness(const std::vector<Instruction>& program, const std::vector<BasicBlock>& blocks) {
+  auto writes = [](const Instruction& ins) {
+    return is_code(ins, pushle::Op::CMP_I8, std::size(N_TYPES))
+      || is_code(ins, pushle::Op::CMPL_I8, pushle::Op::BRLI_NG_F64 - pushle::Op::CMPL_I8 + 1)
+      || is_code(ins, pushle::Op::LOOP_I8, 2 * std::size(N_TYPES))
+      || is_code(ins, pushle::Op::BRI_Z_I8, BRANCH_CONDITIONS * std::size(N_TYPES))
+      || is_code(ins, pushle::Op::LOOPT_I8, std::size(N_TYPES));
+  };
+  auto reads = [](const Instruction& ins) {
+    return is_code(ins, pushle::Op::JZ, BRANCH_CONDITIONS);
+  };
+
+  std::vector<bool> live_in(blocks.size(), false);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t b = blocks.size(); b-- > 0;) {
+      bool live = false;
+      for (size_t s : blocks[b].successors) {
+        live = live || live_in[s];
+      }
+      for (size_t i = blocks[b].end; i-- > blocks[b].begin;) {
+        if (writes(program[i])) {
+          live = false;
+        }
+        if (reads(program[i])) {
+          live = true;
+        }
+      }
+      if (live != live_in[b]) {
+        live_in[b] = live;
+        changed = true;
+      }
+    }
+  }
+  return live_in;
+}
+
+// Replaces `cmp_<n>; pop; pop; j<cc> target` with `br_<cc>_<n> target`
+// wherever nothing reads reg_cmp after the jump. Compares of two locals or a
+// local and a literal are left to lower_local_ops(), which does better.
+bool fuse_compare_branches(std::vector<Instruction>& program) {
+  using pushle::Op;
+  if (program.empty()) {
+    return false;
+  }
+  auto blocks = build_cfg(program);
+  auto live_in = compare_liveness(program, blocks);
+  const size_t n = std::size(N_TYPES);
+  bool changed = false;
+
+  // back to front, so that erasing keeps the earlier block bounds valid; the
+  // liveness stays valid too, as reg_cmp is dead after each fused jump
+  for (size_t b = blocks.size(); b-- > 0;) {
+    size_t end = blocks[b].end;
+    if (end - blocks[b].begin < 4) {
+      continue;
+    }
+    const Instruction& jump = program[end - 1];
+    int cond = jump.is_label() ? -1 : family_index(jump.op, Op::JZ, BRANCH_CONDITIONS);
+    int t = program[end - 4].is_label() ? -1 : family_index(program[end - 4].op, Op::CMP_I8, n);
+    if (cond < 0 || t < 0) {
+      continue;
+    }
+    size_t size = Operand(N_TYPES[t], 0).size();
+    if (pop_size(program[end - 3]) != size || pop_size(program[end - 2]) != size) {
+      continue;
+    }
+    Op pushl = (Op)(Op::PUSHL_I8 + (t >= 2 ? t + 1 : t));
+    Op push = (Op)(Op::PUSH_I8 + (t >= 2 ? t + 1 : t));
+    if (end - blocks[b].begin >= 6 && is_code(program[end - 6], pushl, 1)
+        && (is_code(program[end - 5], pushl, 1) || is_code(program[end - 5], push, 1))) {
+      continue;
+    }
+    bool live = false;
+    for (size_t s : blocks[b].successors) {
+      live = live || live_in[s];
+    }
+    if (live) {
+      continue;
+    }
+    program[end - 4] = Instruction((Op)(Op::BR_Z_I8 + cond * n + t), jump.args);
+    program.erase(program.begin() + (end - 3), program.begin() + end);
+    changed = true;
+  }
+  return changed;
+}
+
+// Removes blocks that cannot be reached from the entry point, then label
+// definitions that nothing refers to. Labels used as plain values (e.g. an
+// address pushed onto the stack) keep their block alive.
+bool eliminate_dead_code(std::vector<Instruction>& program) {
+  if (program.empty()) {
+    return false;
+  }
+  auto blocks = build_cfg(program);
+
+  std::set<std::string> referenced;
+  std::set<std::string> taken; // referenced other than as a branch target
+  for (auto& ins : program) {
+    for (auto& arg : ins.args) {
+      if (arg.is_label()) {
+        referenced.insert(arg.label);
+        if (!is_branch(ins)) {
+          taken.insert(arg.label);
+        }
+      }
+    }
+  }
+
+  std::vector<bool> reachable(blocks.size(), false);
+  std::vector<size_t> worklist = { 0 };
+  for (size_t b = 0; b < blocks.size(); b++) {
+    for (size_t i = blocks[b].begin; i < blocks[b].end && program[i].is_label(); i++) {
+      if (taken.count(program[i].label)) {
+        worklist.push_back(b);
+      }
+    }
+  }
+  while (!worklist.empty()) {
+    size_t b = worklist.back();
+    worklist.pop_back();
+    if (reachable[b]) {
+      continue;
+    }
+    reachable[b] = true;
+    for (size_t s : blocks[b].successors) {
+      worklist.push_back(s);
+    }
+  }
+
+  std::vector<Instruction> out;
+  for (size_t b = 0; b < blocks.size(); b++) {
+    if (!reachable[b]) {
+      continue;
+    }
+    for (size_t i = blocks[b].begin; i < blocks[b].end; i++) {
+      if (!program[i].is_label() || referenced.count(program[i].label)) {
+        out.push_back(program[i]);
+      }
+    }
+  }
+
+  bool changed = out.size() != program.size();
+  program = std::move(out);
+  return changed;
+}
+
+// -O1 elides the counts of local refs once, then runs the local op lowering,
+// counted loop rotation, bounds check hoisting, peephole rewrites,
+// compare/branch fusion, jump threading and dead code elimination, and
+// rotates the remaining loops once those are done; -O2 adds constant
+// folding. Passes repeat until none of them applies.
+void optimize(std::vector<Instruction>& program, int level) {
+  if (level < 1) {
+    return;
+  }
+  elide_local_refs(program);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    if (level >= 2) {
+      changed |= fold_constants(program);
+    }
+    changed |= fuse_compare_branches(program);
+    changed |= lower_local_ops(program);
+    changed |= form_counted_loops(program);
+    changed |= hoist_bounds_checks(program);
+    changed |= peephole(program);
+    changed |= thread_jumps(program);
+    changed |= eliminate_dead_code(program);
+    if (!changed) {
+      changed = rotate_loops(program);
+    }
+  }
+}
+
+// Replaces wide immediates with a one-byte short form when the value fits,
+// and 8-byte immediates with an index into the constant pool otherwise.
+void select_encodings(std::vector<Instruction>& program, ConstantPool& pool) {
+  using pushle::Op;
+  using pushle::DataType;
+
+  auto fits_i8 = [](int64_t v) { return v >= INT8_MIN && v <= INT8_MAX; };
+  auto small_f64 = [&](uint64_t bits) {
+    double v = std::bit_cast<double>(bits);
+    return fits_i8((int64_t)v) && (double)(int64_t)v == v && std::bit_cast<uint64_t>((double)(int64_t)v) == bits;
+  };
+  auto pooled = [&](Instruction& ins, Op narrow, Op wide, std::vector<Operand> prefix, uint64_t bits) {
+    size_t k = pool.add(bits);
+    if (k <= UINT8_MAX) {
+      prefix.emplace_back(DataType::_u8, k);
+      ins = Instruction(narrow, prefix);
+    } else if (k <= UINT16_MAX) {
+      prefix.emplace_back(DataType::_u16, k);
+      ins = Instruction(wide, prefix);
+    }
+  };
+
+  for (auto& ins : program) {
+    if (ins.is_label()) {
+      continue;
+    }
+    switch (ins.op) {
+      case Op::PUSH_I32:
+        if (fits_i8((int32_t)ins.args[0].bits)) ins = Instruction(Op::PUSHS_I32, {Operand(DataType::_i8, ins.args[0].bits)});
+        break;
+      case Op::PUSH_U32:
+        if ((uint32_t)ins.args[0].bits <= UINT8_MAX) ins = Instruction(Op::PUSHS_U32, {Operand(DataType::_u8, ins.args[0].bits)});
+        break;
+      case Op::PUSH_I64:
+        if (fits_i8((int64_t)ins.args[0].bits)) ins = Instruction(Op::PUSHS_I64, {Operand(DataType::_i8, ins.args[0].bits)});
+        else pooled(ins, Op::PUSHK, Op::PUSHKW, {}, ins.args[0].bits);
+        break;
+      case Op::PUSH_U64:
+        if (ins.args[0].bits <= UINT8_MAX) ins = Instruction(Op::PUSHS_U64, {Operand(DataType::_u8, ins.args[0].bits)});
+        else pooled(ins, Op::PUSHK, Op::PUSHKW, {}, ins.args[0].bits);
+        break;
+      case Op::PUSH_F64:
+        if (small_f64(ins.args[0].bits)) ins = Instruction(Op::PUSHS_F64, {Operand(DataType::_i8, (uint64_t)(int64_t)std::bit_cast<double>(ins.args[0].bits))});
+        else pooled(ins, Op::PUSHK, Op::PUSHKW, {}, ins.args[0].bits);
+        break;
+      case Op::SETL_I32:
+        if (fits_i8((int32_t)ins.args[1].bits)) ins = Instruction(Op::SETLS_I32, {ins.args[0], Operand(DataType::_i8, ins.args[1].bits)});
+        break;
+      case Op::SETL_U32:
+        if ((uint32_t)ins.args[1].bits <= UINT8_MAX) ins = Instruction(Op::SETLS_U32, {ins.args[0], Operand(DataType::_u8, ins.args[1].bits)});
+        break;
+      case Op::SETL_I64:
+        if (fits_i8((int64_t)ins.args[1].bits)) ins = Instruction(Op::SETLS_I64, {ins.args[0], Operand(DataType::_i8, ins.args[1].bits)});
+        else pooled(ins, Op::SETLK_I64, Op::SETLKW_I64, {ins.args[0]}, ins.args[1].bits);
+        break;
+      case Op::SETL_U64:
+        if (ins.args[1].bits <= UINT8_MAX) ins = Instruction(Op::SETLS_U64, {ins.args[0], Operand(DataType::_u8, ins.args[1].bits)});
+        else pooled(ins, Op::SETLK_U64, Op::SETLKW_U64, {ins.args[0]}, ins.args[1].bits);
+        break;
+      case Op::SETL_F64:
+        if (small_f64(ins.args[1].bits)) ins = Instruction(Op::SETLS_F64, {ins.args[0], Operand(DataType::_i8, (uint64_t)(int64_t)std::bit_cast<double>(ins.args[1].bits))});
+        else pooled(ins, Op::SETLK_F64, Op::SETLKW_F64, {ins.args[0]}, ins.args[1].bits);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+std::vector<uint8_t> encode(const std::vector<Instruction>& program) {
+  std::map<std::string, uint64_t> label_map;
+  uint64_t offset = 0;
+  for (auto& ins : program) {
+    if (ins.is_label()) {
+      label_map[ins.label] = offset;
+    }
+    offset += ins.size();
+  }
+
+  std::vector<uint8_t> bytecode;
+  for (auto& ins : program) {
+    if (ins.is_label()) {
+      continue;
+    }
+    if (pushle::op_size(ins.op) == 1) {
+      bytecode.push_back(ins.op);
+    } else {
+      bytecode.push_back(pushle::OP_PAGE_PREFIX + (ins.op >> 8) - 1);
+      bytecode.push_back(ins.op & 0xff);
+    }
+    for (auto& arg : ins.args) {
+      uint64_t bits = arg.bits;
+      if (arg.is_label()) {
+        auto it = label_map.find(arg.label);
+        if (it == label_map.end()) {
+          throw std::runtime_error("unknown label: " + arg.label);
+        }
+        bits = it->second;
+      }
+      // little endian
+      for (size_t i = 0; i < arg.size(); i++) {
+        bytecode.push_back(((i < 8 ? bits : arg.high) >> (8 * (i % 8))) & 0xff);
+      }
+    }
+  }
+  return bytecode;
+}
+
+void write_module(std::ofstream& out, const std::vector<uint8_t>& code, const ConstantPool& pool, const StringPool& strings) {
+  std::vector<pushle::ModuleSection> sections;
+  uint64_t offset = sizeof(pushle::ModuleHeader) + 3 * sizeof(pushle::ModuleSection);
+  sections.push_back({ pushle::SECTION_CONSTANTS, 0, offset, pool.entries().size() * sizeof(uint64_t) });
+  offset += sections.back().size;
+  sections.push_back({ pushle::SECTION_STRINGS, 0, offset, strings.bytes().size() });
+  offset += sections.back().size;
+  sections.push_back({ pushle::SECTION_CODE, 0, offset, code.size() });
+
+  pushle::ModuleHeader header;
+  memcpy(header.magic, pushle::MODULE_MAGIC, sizeof(header.magic));
+  header.version = pushle::MODULE_VERSION;
+  header.section_count = sections.size();
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(pushle::ModuleSection));
+  out.write(reinterpret_cast<const char*>(pool.entries().data()), pool.entries().size() * sizeof(uint64_t));
+  out.write(reinterpret_cast<const char*>(strings.bytes().data()), strings.bytes().size());
+  out.write(reinterpret_cast<const char*>(code.data()), code.size());
+}
+
 int main(int argc, char** argv) {
-  if (argc != 3) {
-    fmt::print("Usage: {} <input> <output>\n", argv[0]);
+  int level = 1;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+      level = arg[2] - '0';
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 2) {
+    fmt::print("Usage: {} [-O0|-O1|-O2] <input> <output>\n", argv[0]);
     return 1;
   }
   
-  std::ifstream in(argv[1]);
-  std::ofstream out(argv[2]);
+  std::ifstream in(paths[0]);
+  std::ofstream out(paths[1]);
 
   std::vector<std::string> lines;
   std::string line;
@@ -138,6 +1572,13 @@ int main(int argc, char** argv) {
       } else if (in_string) {
         if (in_escape) {
           in_escape = false;
+          switch (c) {
+            case 'n': token += '\n'; break;
+            case 't': token += '\t'; break;
+            case 'r': token += '\r'; break;
+            case '0': token += '\0'; break;
+            default: token += c; break; // \\ and \"
+          }
         } else if (c == '\\') {
           in_escape = true;
         } else if (c == '"') {
@@ -186,201 +1627,16 @@ int main(int argc, char** argv) {
     // fmt::print("\n");
   }
 
-  std::vector<std::vector<Bytecode>> line_bytecode;
+  StringPool strings;
+  std::vector<Instruction> program = parse(program_tokens, strings);
 
-  for (auto tokens : program_tokens) {
-    std::vector<Bytecode> bytes;
-    std::vector<pushle::DataType> arg_types;
-    // pushle::DataType arg_types.push_back(pushle::DataType::_none);
-    for (auto token : tokens) {
-      if (token.is_label()) {
-        if (!arg_types.empty() && arg_types.front() != pushle::DataType::_u64) {
-          throw std::runtime_error("Label can only be used with u64");
-        } else if (!arg_types.empty()) {
-          arg_types.erase(arg_types.begin());
-        }
-        bytes.emplace_back(token.label());
-      } else if (token.is_string()) {
-        // TODO
-        throw std::runtime_error("String not implemented");
-      } else if (token.is_number()) {
-        // pop from front
-        pushle::DataType type = arg_types.front();
-        arg_types.erase(arg_types.begin());
-        switch (type) {
-          case pushle::DataType::_none: {
-            throw std::runtime_error("Unexpected number");
-          }
-          case pushle::DataType::_i8: {
-            // push i8 to bytes
-            bytes.emplace_back(std::stoi(token.text()));
-            break;
-          }
-          case pushle::DataType::_u8:
-          case pushle::DataType::_bool:  {// pretty much the same
-            // push u8 to bytes
-            bytes.emplace_back(std::stoul(token.text()));
-            break;
-          }
-          case pushle::DataType::_i16: {
-            // push i16 to bytes (little endian)
-            int16_t i16 = std::stoi(token.text());
-            bytes.emplace_back(i16 & 0xFF);
-            bytes.emplace_back(i16 >> 8);
-            break;
-          }
-          case pushle::DataType::_u16: {
-            // push u16 to bytes (little endian)
-            uint16_t u16 = std::stoul(token.text());
-            bytes.emplace_back(u16 & 0xFF);
-            bytes.emplace_back(u16 >> 8);
-            break;
-          }
-          case pushle::DataType::_i32: {
-            // push i32 to bytes (little endian)
-            int32_t i32 = std::stoi(token.text());
-            bytes.emplace_back(i32 & 0xFF);
-            bytes.emplace_back(i32 >> 8);
-            bytes.emplace_back(i32 >> 16);
-            bytes.emplace_back(i32 >> 24);
-            break;
-          }
-          case pushle::DataType::_u32: {
-            // push u32 to bytes (little endian)
-            uint32_t u32 = std::stoul(token.text());
-            bytes.emplace_back(u32 & 0xFF);
-            bytes.emplace_back(u32 >> 8);
-            bytes.emplace_back(u32 >> 16);
-            bytes.emplace_back(u32 >> 24);
-            break;
-          }
-          case pushle::DataType::_f32: {
-            // push f32 to bytes (little endian)
-            float f32 = std::stof(token.text());
-            uint32_t u32 = (union { float f; uint32_t u; }){f32}.u;
-            bytes.emplace_back(u32 & 0xFF);
-            bytes.emplace_back(u32 >> 8);
-            bytes.emplace_back(u32 >> 16);
-            bytes.emplace_back(u32 >> 24);
-            break;
-          }
-          case pushle::DataType::_i64: {
-            // push i64 to bytes (little endian)
-            int64_t i64 = std::stoll(token.text());
-            bytes.emplace_back(i64 & 0xFF);
-            bytes.emplace_back(i64 >> 8);
-            bytes.emplace_back(i64 >> 16);
-            bytes.emplace_back(i64 >> 24);
-            bytes.emplace_back(i64 >> 32);
-            bytes.emplace_back(i64 >> 40);
-            bytes.emplace_back(i64 >> 48);
-            bytes.emplace_back(i64 >> 56);
-            break;
-          }
-          case pushle::DataType::_u64: {
-            // push u64 to bytes (little endian)
-            uint64_t u64 = std::stoull(token.text());
-            bytes.emplace_back(u64 & 0xFF);
-            bytes.emplace_back(u64 >> 8);
-            bytes.emplace_back(u64 >> 16);
-            bytes.emplace_back(u64 >> 24);
-            bytes.emplace_back(u64 >> 32);
-            bytes.emplace_back(u64 >> 40);
-            bytes.emplace_back(u64 >> 48);
-            bytes.emplace_back(u64 >> 56);
-            break;
-          }
-          case pushle::DataType::_f64: {
-            // push f64 to bytes (little endian)
-            double f64 = std::stod(token.text());
-            uint64_t u64 = (union { double f; uint64_t u; }){f64}.u;
-            bytes.emplace_back(u64 & 0xFF);
-            bytes.emplace_back(u64 >> 8);
-            bytes.emplace_back(u64 >> 16);
-            bytes.emplace_back(u64 >> 24);
-            bytes.emplace_back(u64 >> 32);
-            bytes.emplace_back(u64 >> 40);
-            bytes.emplace_back(u64 >> 48);
-            bytes.emplace_back(u64 >> 56);
-            break;
-          }
-          default: {
-            throw std::runtime_error("Unknown type");
-          }
-        }
-      } else if (arg_types.size() > 0) {
-        throw std::runtime_error("Unexpected token (expected argument)");
-      } else {
-        std::string text = token.text();
-        auto registry = pushle::TokenRegistry::getInstance();
-        auto it = registry.getToken(text);
-        if (it.has_value()) {
-          auto token = it.value();
-          bytes.emplace_back(token.getOp());
-          arg_types = token.getArguments();
-        } else {
-          throw std::runtime_error("unknown opcode: " + text);
-        }
-      }
-    }
-    if (arg_types.size() > 0) {
-      fmt::print("{}\n", arg_types.size());
-      for (auto& t : arg_types) {
-        fmt::print("{}\n", t);
-      }
-      for (auto& t : tokens) {
-        fmt::print("{}\n", t.to_string());
-      }
-      throw std::runtime_error("unexpected end of instruction");
-    }
-    line_bytecode.push_back(bytes);
-  }
+  optimize(program, level);
 
-  std::vector<uint8_t> bytecode;
+  ConstantPool pool;
+  select_encodings(program, pool);
 
-  std::map<std::string, uint64_t> label_map;
-  std::map<uint64_t, std::string> label_map_usages;
-  for (auto& bytes : line_bytecode) {
-    if (bytes.size() == 1 && bytes[0].is_label()) {
-      // fmt::print("label DEFINE found: {} with bytecode.size() = {}\n", bytes[0].label(), bytecode.size());
-      label_map[bytes[0].label()] = bytecode.size();
-      continue;
-    }
-    for (auto& byte : bytes) {
-      if (byte.is_label()) {
-        label_map_usages[bytecode.size()] = byte.label();
-        for (unsigned int i = 0; i < 8; i++) {
-          bytecode.emplace_back(0xff);
-        }
-      } else {
-        bytecode.emplace_back(byte.op());
-      }
-    }
-  }
-  for (auto& [index, label] : label_map_usages) {
-    auto address = label_map[label];
-    // overwrite line_bytecode with the address as uint64_t little endian
-    if (bytecode[index] != 0xff
-      || bytecode[index + 1] != 0xff
-      || bytecode[index + 2] != 0xff
-      || bytecode[index + 3] != 0xff
-      || bytecode[index + 4] != 0xff
-      || bytecode[index + 5] != 0xff
-      || bytecode[index + 6] != 0xff
-      || bytecode[index + 7] != 0xff) {
-      throw std::runtime_error("label already used at index " + std::to_string(index));
-    }
-    bytecode[index] = address & 0xff;
-    bytecode[index + 1] = (address >> 8) & 0xff;
-    bytecode[index + 2] = (address >> 16) & 0xff;
-    bytecode[index + 3] = (address >> 24) & 0xff;
-    bytecode[index + 4] = (address >> 32) & 0xff;
-    bytecode[index + 5] = (address >> 40) & 0xff;
-    bytecode[index + 6] = (address >> 48) & 0xff;
-    bytecode[index + 7] = (address >> 56) & 0xff;
-  }
-
-  out.write(reinterpret_cast<char*>(bytecode.data()), bytecode.size());
+  std::vector<uint8_t> code = encode(program);
+  write_module(out, code, pool, strings);
   out.close();
 
   return 0;
@@ -0,0 +1,189 @@
+#include "embed.h"
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "metrics.h"
+#include "module.h"
+#include "pushle.h"
+
+struct pushle_vm {
+  pushle::VM vm;
+  std::string error;
+  std::unique_ptr<pushle::Tracer> tracer;
+};
+
+// Runs `body`, turning an exception into -1 and the stored error message.
+template <typename F>
+static int guard(pushle_vm *vm, F body) {
+  try {
+    vm->error.clear();
+    return body();
+  } catch (const std::exception &e) {
+    vm->error = e.what();
+    return -1;
+  }
+}
+
+// pushle_metrics mirrors pushle::Metrics field for field.
+#define PUSHLE_METRIC_OFFSET(name, kind, help) \
+  static_assert(offsetof(pushle_metrics, name) == offsetof(pushle::Metrics, name));
+PUSHLE_METRICS(PUSHLE_METRIC_OFFSET)
+#undef PUSHLE_METRIC_OFFSET
+static_assert(sizeof(pushle_metrics) == sizeof(pushle::Metrics));
+
+// Describes a trap that stopped the VM in `error`, as pushle_error() reports it.
+static int finish(pushle_vm *vm, pushle::RunStatus status) {
+  if (status == pushle::RUN_TRAPPED) {
+    vm->error = fmt::format("trap: {} at {:#x}", pushle::trap_name(vm->vm.trap_code()), vm->vm.trap_offset());
+  }
+  return (int)status;
+}
+
+extern "C" {
+
+pushle_vm *pushle_vm_new(void) {
+  try {
+    return new pushle_vm();
+  } catch (const std::exception &) {
+    return nullptr;
+  }
+}
+
+void pushle_vm_free(pushle_vm *vm) {
+  delete vm;
+}
+
+void pushle_vm_reset(pushle_vm *vm) {
+  vm->vm.reset();
+  vm->error.clear();
+}
+
+int pushle_run(pushle_vm *vm, const uint8_t *data, size_t size, size_t entry) {
+  return guard(vm, [&] {
+    return finish(vm, vm->vm.run(pushle::Module::load(data, size), entry));
+  });
+}
+
+int pushle_start(pushle_vm *vm, const uint8_t *data, size_t size, size_t entry) {
+  return guard(vm, [&] {
+    vm->vm.start(pushle::Module::load(data, size), entry);
+    return vm->vm.trap_code() != pushle::TRAP_NONE ? finish(vm, pushle::RUN_TRAPPED) : 0;
+  });
+}
+
+int pushle_resume(pushle_vm *vm, uint64_t budget) {
+  return guard(vm, [&] {
+    return finish(vm, vm->vm.resume(budget));
+  });
+}
+
+int pushle_trace(pushle_vm *vm, size_t capacity) {
+  return guard(vm, [&] {
+    vm->vm.trace(nullptr);
+    vm->tracer.reset();
+    if (capacity > 0) {
+      vm->tracer = std::make_unique<pushle::Tracer>(capacity);
+      vm->vm.trace(vm->tracer.get());
+    }
+    return 0;
+  });
+}
+
+int pushle_trace_write(pushle_vm *vm, const char *path) {
+  return guard(vm, [&] {
+    if (!vm->tracer) {
+      throw std::runtime_error("pushle_trace_write(): tracing is off");
+    }
+    vm->tracer->write(path);
+    return 0;
+  });
+}
+
+void pushle_vm_metrics(const pushle_vm *vm, pushle_metrics *metrics) {
+  pushle::Metrics snapshot = vm->vm.metrics();
+  memcpy(metrics, &snapshot, sizeof(*metrics));
+}
+
+void pushle_global_metrics(pushle_metrics *metrics) {
+  pushle::Metrics snapshot = pushle::global_metrics();
+  memcpy(metrics, &snapshot, sizeof(*metrics));
+}
+
+int pushle_trap(const pushle_vm *vm, size_t *offset) {
+  if (offset != nullptr) {
+    *offset = vm->vm.trap_offset();
+  }
+  return vm->vm.trap_code();
+}
+
+const char *pushle_error(const pushle_vm *vm) {
+  return vm->error.c_str();
+}
+
+#define EMBED_IMPL(type, native_type) \
+  int pushle_push_##type(pushle_vm *vm, native_type value) { \
+    return guard(vm, [&] { \
+      if (!vm->vm.push_arg<native_type>(value)) { \
+        throw std::out_of_range("pushle_push_" #type "(): stack overflow"); \
+      } \
+      return 0; \
+    }); \
+  } \
+  native_type pushle_result_##type(pushle_vm *vm, size_t depth) { \
+    native_type value = 0; \
+    guard(vm, [&] { \
+      if (!vm->vm.has_result<native_type>(depth)) { \
+        throw std::out_of_range("pushle_result_" #type "(): stack underflow"); \
+      } \
+      value = vm->vm.result<native_type>(depth); \
+      return 0; \
+    }); \
+    return value; \
+  }
+
+EMBED_IMPL(i8, int8_t)
+EMBED_IMPL(u8, uint8_t)
+EMBED_IMPL(bool, bool)
+EMBED_IMPL(i16, int16_t)
+EMBED_IMPL(u16, uint16_t)
+EMBED_IMPL(i32, int32_t)
+EMBED_IMPL(u32, uint32_t)
+EMBED_IMPL(f32, float)
+EMBED_IMPL(i64, int64_t)
+EMBED_IMPL(u64, uint64_t)
+EMBED_IMPL(f64, double)
+#undef EMBED_IMPL
+
+int pushle_push_span(pushle_vm *vm, void *data, size_t size) {
+  return guard(vm, [&] {
+    if (!vm->vm.push_span(data, size)) {
+      throw std::out_of_range("pushle_push_span(): stack overflow");
+    }
+    return 0;
+  });
+}
+
+void *pushle_result_span(pushle_vm *vm, size_t depth) {
+  void *data = nullptr;
+  guard(vm, [&] {
+    if (!vm->vm.has_result<uint64_t>(depth)) {
+      throw std::out_of_range("pushle_result_span(): stack underflow");
+    }
+    data = vm->vm.result_span<void>(depth);
+    return 0;
+  });
+  return data;
+}
+
+size_t pushle_stack_depth(const pushle_vm *vm) {
+  return vm->vm.stack_depth();
+}
+
+} // extern "C"
@@ -0,0 +1,105 @@
+#pragma once
+
+// C interface for embedding the VM. C++ hosts can use pushle::VM directly;
+// this wraps the same calls (push_arg, run, result, ...) behind an opaque
+// handle. Functions returning int give 0 (or a PUSHLE_ status) on success and
+// -1 if the VM raised an error, which pushle_error() then describes; failed
+// result reads give 0.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct pushle_vm pushle_vm;
+
+pushle_vm *pushle_vm_new(void);
+void pushle_vm_free(pushle_vm *vm);
+// Clears the stack, locals and registers and releases the whole heap.
+void pushle_vm_reset(pushle_vm *vm);
+
+// Statuses returned by pushle_run() and pushle_resume(), as in RunStatus.
+#define PUSHLE_DONE 0
+#define PUSHLE_YIELDED 1
+#define PUSHLE_BUDGET 2
+#define PUSHLE_TRAPPED 3
+
+// `data` is an assembled module (or raw code) and must stay alive until the
+// program is done; execution starts at byte `entry` of its code section.
+int pushle_run(pushle_vm *vm, const uint8_t *data, size_t size, size_t entry);
+// Prepares a run without executing anything; pushle_resume() then runs until
+// the program has taken `budget` backward branches (see spec.md) and may be
+// called again after a yield or a budget stop. An `entry` outside the code
+// gives PUSHLE_TRAPPED, as does every pushle_resume() after it.
+int pushle_start(pushle_vm *vm, const uint8_t *data, size_t size, size_t entry);
+int pushle_resume(pushle_vm *vm, uint64_t budget);
+// Describes the last error, or the trap after PUSHLE_TRAPPED.
+const char *pushle_error(const pushle_vm *vm);
+// The pushle::TrapCode that stopped the VM, 0 if none; `offset`, if not
+// NULL, receives the code offset of the instruction that raised it.
+int pushle_trap(const pushle_vm *vm, size_t *offset);
+
+// Keeps the last `capacity` instructions the VM executes, from the next
+// pushle_run() or pushle_resume() on; 0 turns tracing off again.
+int pushle_trace(pushle_vm *vm, size_t capacity);
+// Saves the kept instructions to `path` for the tracedump tool.
+int pushle_trace_write(pushle_vm *vm, const char *path);
+
+// Counters as in pushle::Metrics, see "Metrics" in spec.md.
+typedef struct pushle_metrics {
+  uint64_t runs;
+  uint64_t instructions;
+  uint64_t run_ns;
+  uint64_t completions;
+  uint64_t yields;
+  uint64_t budget_stops;
+  uint64_t traps;
+  uint64_t errors;
+  uint64_t stack_high_water;
+  uint64_t heap_live_bytes;
+  uint64_t heap_peak_bytes;
+} pushle_metrics;
+
+// Snapshot of one VM, taken while it is not running, or of all VMs.
+void pushle_vm_metrics(const pushle_vm *vm, pushle_metrics *metrics);
+void pushle_global_metrics(pushle_metrics *metrics);
+
+// Inputs, pushed in order before pushle_run().
+int pushle_push_i8(pushle_vm *vm, int8_t value);
+int pushle_push_u8(pushle_vm *vm, uint8_t value);
+int pushle_push_bool(pushle_vm *vm, bool value);
+int pushle_push_i16(pushle_vm *vm, int16_t value);
+int pushle_push_u16(pushle_vm *vm, uint16_t value);
+int pushle_push_i32(pushle_vm *vm, int32_t value);
+int pushle_push_u32(pushle_vm *vm, uint32_t value);
+int pushle_push_f32(pushle_vm *vm, float value);
+int pushle_push_i64(pushle_vm *vm, int64_t value);
+int pushle_push_u64(pushle_vm *vm, uint64_t value);
+int pushle_push_f64(pushle_vm *vm, double value);
+// Pushes the address of `size` bytes of host memory, which the program
+// accesses in place until the VM is reset.
+int pushle_push_span(pushle_vm *vm, void *data, size_t size);
+
+// Results, read from the stack without popping them. `depth` counts values
+// of the requested type below the top of the stack.
+int8_t pushle_result_i8(pushle_vm *vm, size_t depth);
+uint8_t pushle_result_u8(pushle_vm *vm, size_t depth);
+bool pushle_result_bool(pushle_vm *vm, size_t depth);
+int16_t pushle_result_i16(pushle_vm *vm, size_t depth);
+uint16_t pushle_result_u16(pushle_vm *vm, size_t depth);
+int32_t pushle_result_i32(pushle_vm *vm, size_t depth);
+uint32_t pushle_result_u32(pushle_vm *vm, size_t depth);
+float pushle_result_f32(pushle_vm *vm, size_t depth);
+int64_t pushle_result_i64(pushle_vm *vm, size_t depth);
+uint64_t pushle_result_u64(pushle_vm *vm, size_t depth);
+double pushle_result_f64(pushle_vm *vm, size_t depth);
+// Memory addressed by a u64 result, e.g. a block the program allocated.
+void *pushle_result_span(pushle_vm *vm, size_t depth);
+size_t pushle_stack_depth(const pushle_vm *vm);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,254 @@
+#include "heap.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace pushle {
+
+static inline size_t align_up(size_t size, size_t alignment) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static inline uint32_t size_class(size_t size) {
+  uint32_t c = 0;
+  while ((size_t)16 << c < size) {
+    c++;
+  }
+  return c;
+}
+
+Heap::~Heap() {
+  reset();
+  for (Chunk *c : chunks) {
+    std::free(c);
+  }
+}
+
+void *Heap::alloc(size_t size) {
+  return allocate(size, false);
+}
+
+void *Heap::alloc_temp(size_t size) {
+  return allocate(size, true);
+}
+
+void *Heap::allocate(size_t size, bool temp) {
+  if (size > HEAP_MAX_ALLOCATION) {
+    return nullptr;
+  }
+  Block *block;
+  if (size > HEAP_MAX_CLASS_SIZE) {
+    block = alloc_large(size);
+    if (block == nullptr) {
+      return nullptr;
+    }
+    if (!temp) {
+      _stats.large_allocations++;
+    }
+  } else {
+    uint32_t c = size_class(size);
+    if (free_lists[c] != nullptr) {
+      void *payload = free_lists[c];
+      free_lists[c] = *(void **)payload;
+      block = (Block *)payload - 1;
+      Chunk *chunk;
+      size_t index;
+      lookup(payload, chunk, index);
+      chunk->live[index / 64] |= (uint64_t)1 << (index % 64);
+      _stats.class_reuses[c]++;
+    } else {
+      block = carve(c);
+      if (block == nullptr) {
+        return nullptr;
+      }
+    }
+    if (!temp) {
+      _stats.class_allocations[c]++;
+    }
+  }
+  block->size = size;
+  block->temp = temp;
+  if (temp) {
+    _stats.temp_allocations++;
+    _stats.temp_bytes += size;
+    return block + 1;
+  }
+  _stats.allocations++;
+  _stats.live_bytes += size;
+  if (_stats.live_bytes > _stats.peak_live_bytes) {
+    _stats.peak_live_bytes = _stats.live_bytes;
+  }
+  return block + 1;
+}
+
+bool Heap::free(void *ptr) {
+  if (ptr == nullptr) {
+    return true;
+  }
+  Chunk *chunk;
+  size_t index;
+  Block *block = lookup(ptr, chunk, index);
+  if (block == nullptr || (void *)(block + 1) != ptr || block->temp) {
+    return false;
+  }
+  _stats.frees++;
+  _stats.live_bytes -= block->size;
+  if (chunk->size_class == LARGE_CLASS) {
+    free_large(chunk);
+    return true;
+  }
+  chunk->live[index / 64] &= ~((uint64_t)1 << (index % 64));
+  *(void **)ptr = free_lists[chunk->size_class];
+  free_lists[chunk->size_class] = ptr;
+  return true;
+}
+
+// The live block whose slot holds `ptr`, with its chunk and index there.
+// Anything the heap did not hand out, such as the stack, a module or a
+// block header, has no slot or a clear bit in the live bitmap.
+Heap::Block *Heap::lookup(const void *ptr, Chunk *&chunk, size_t &index) const {
+  auto it = regions.find((uintptr_t)ptr / HEAP_CHUNK_SIZE);
+  if (it == regions.end()) {
+    return nullptr;
+  }
+  chunk = it->second;
+  uintptr_t first = (uintptr_t)chunk + CHUNK_HEADER_SIZE;
+  if ((uintptr_t)ptr < first) {
+    return nullptr;
+  }
+  index = ((uintptr_t)ptr - first) / chunk->stride;
+  if (index >= chunk->count || !(chunk->live[index / 64] >> (index % 64) & 1)) {
+    return nullptr;
+  }
+  Block *block = (Block *)(first + index * chunk->stride);
+  return (uintptr_t)ptr < (uintptr_t)(block + 1) ? nullptr : block;
+}
+
+uint8_t *Heap::find(const void *ptr, size_t &size) const {
+  Chunk *chunk;
+  size_t index;
+  Block *block = lookup(ptr, chunk, index);
+  if (block == nullptr) {
+    return nullptr;
+  }
+  size = block->size;
+  return (uint8_t *)(block + 1);
+}
+
+bool Heap::contains(const void *ptr, size_t size) const {
+  size_t block_size;
+  uint8_t *data = find(ptr, block_size);
+  if (data == nullptr) {
+    return false;
+  }
+  size_t offset = (const uint8_t *)ptr - data;
+  return offset <= block_size && size <= block_size - offset;
+}
+
+void Heap::reset() {
+  while (large != nullptr) {
+    free_large(large);
+  }
+  for (size_t i = 0; i < chunks_used; i++) {
+    memset(chunks[i]->live, 0, (chunks[i]->count + 63) / 64 * sizeof(uint64_t));
+    chunks[i]->count = 0;
+  }
+  chunks_used = 0;
+  for (size_t i = 0; i < HEAP_SIZE_CLASS_COUNT; i++) {
+    current[i] = nullptr;
+    free_lists[i] = nullptr;
+  }
+  _stats.live_bytes = 0;
+  _stats.resets++;
+}
+
+// Takes the next block of class `c` from its chunk, moving on to a chunk
+// left over from before the last reset() or a new one when it is full.
+Heap::Block *Heap::carve(uint32_t c) {
+  Chunk *chunk = current[c];
+  if (chunk == nullptr || chunk->count == chunk->capacity) {
+    if (chunks_used < chunks.size()) {
+      chunk = chunks[chunks_used];
+    } else {
+      chunk = (Chunk *)std::aligned_alloc(HEAP_CHUNK_SIZE, HEAP_CHUNK_SIZE);
+      if (chunk == nullptr) {
+        return nullptr;
+      }
+      try {
+        chunks.push_back(chunk);
+        regions[(uintptr_t)chunk / HEAP_CHUNK_SIZE] = chunk;
+      } catch (const std::bad_alloc &) {
+        if (!chunks.empty() && chunks.back() == chunk) {
+          chunks.pop_back();
+        }
+        std::free(chunk);
+        return nullptr;
+      }
+      memset(chunk->live, 0, sizeof(chunk->live));
+      _stats.chunks++;
+      _stats.chunk_bytes += HEAP_CHUNK_SIZE;
+    }
+    chunks_used++;
+    chunk->size_class = c;
+    chunk->stride = sizeof(Block) + ((size_t)16 << c);
+    chunk->capacity = (HEAP_CHUNK_SIZE - CHUNK_HEADER_SIZE) / chunk->stride;
+    chunk->count = 0;
+    current[c] = chunk;
+  }
+  size_t index = chunk->count++;
+  chunk->live[index / 64] |= (uint64_t)1 << (index % 64);
+  return (Block *)((uint8_t *)chunk + CHUNK_HEADER_SIZE + index * chunk->stride);
+}
+
+// `size` is at most HEAP_MAX_ALLOCATION, so rounding up cannot wrap.
+Heap::Block *Heap::alloc_large(size_t size) {
+  size_t bytes = align_up(CHUNK_HEADER_SIZE + sizeof(Block) + size, HEAP_CHUNK_SIZE);
+  Chunk *chunk = (Chunk *)std::aligned_alloc(HEAP_CHUNK_SIZE, bytes);
+  if (chunk == nullptr) {
+    return nullptr;
+  }
+  uintptr_t granule = (uintptr_t)chunk / HEAP_CHUNK_SIZE;
+  size_t granules = bytes / HEAP_CHUNK_SIZE;
+  try {
+    for (size_t i = 0; i < granules; i++) {
+      regions[granule + i] = chunk;
+    }
+  } catch (const std::bad_alloc &) {
+    for (size_t i = 0; i < granules; i++) {
+      regions.erase(granule + i);
+    }
+    std::free(chunk);
+    return nullptr;
+  }
+  chunk->size_class = LARGE_CLASS;
+  chunk->stride = bytes - CHUNK_HEADER_SIZE;
+  chunk->capacity = 1;
+  chunk->count = 1;
+  chunk->live[0] = 1;
+  chunk->prev = nullptr;
+  chunk->next = large;
+  if (large != nullptr) {
+    large->prev = chunk;
+  }
+  large = chunk;
+  return (Block *)((uint8_t *)chunk + CHUNK_HEADER_SIZE);
+}
+
+void Heap::free_large(Chunk *chunk) {
+  if (chunk->prev != nullptr) {
+    chunk->prev->next = chunk->next;
+  } else {
+    large = chunk->next;
+  }
+  if (chunk->next != nullptr) {
+    chunk->next->prev = chunk->prev;
+  }
+  uintptr_t granule = (uintptr_t)chunk / HEAP_CHUNK_SIZE;
+  for (size_t i = 0; i < (CHUNK_HEADER_SIZE + chunk->stride) / HEAP_CHUNK_SIZE; i++) {
+    regions.erase(granule + i);
+  }
+  std::free(chunk);
+}
+
+} // namespace pushle
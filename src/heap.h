@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace pushle {
+  const size_t HEAP_CHUNK_SIZE = 1024 * 1024;
+  const size_t HEAP_ALIGNMENT = 16;
+  const size_t HEAP_SIZE_CLASS_COUNT = 8; // 16, 32, 64 ... 2048 bytes
+  const size_t HEAP_MAX_CLASS_SIZE = 16 << (HEAP_SIZE_CLASS_COUNT - 1);
+  const size_t HEAP_MAX_ALLOCATION = (size_t)1 << 40; // larger requests fail without reaching malloc
+
+  struct HeapStats {
+    uint64_t chunks = 0;              // arena chunks reserved from the system
+    uint64_t chunk_bytes = 0;
+    uint64_t temp_allocations = 0;    // released by reset() only
+    uint64_t temp_bytes = 0;
+    uint64_t allocations = 0;         // freeable allocations
+    uint64_t frees = 0;
+    uint64_t live_bytes = 0;          // requested bytes not yet freed
+    uint64_t peak_live_bytes = 0;
+    uint64_t large_allocations = 0;   // above HEAP_MAX_CLASS_SIZE
+    uint64_t class_allocations[HEAP_SIZE_CLASS_COUNT] = {};
+    uint64_t class_reuses[HEAP_SIZE_CLASS_COUNT] = {}; // served from a free list
+    uint64_t resets = 0;
+  };
+
+  // VM-owned allocator. Small objects are rounded up to a power-of-two size
+  // class and recycled through per-class free lists. Each class is carved out
+  // of its own chunks, which are kept across reset(), so a warmed-up VM never
+  // calls malloc for blocks of up to HEAP_MAX_CLASS_SIZE bytes. Larger blocks
+  // go straight to the system. Temporary data takes the same paths but can
+  // only be released by reset().
+  //
+  // Chunks and large blocks are aligned to HEAP_CHUNK_SIZE and indexed by
+  // address, and every chunk has a bitmap of its live blocks, so finding the
+  // block behind any pointer takes a hash lookup and a division.
+  class Heap {
+  public:
+    Heap() = default;
+    ~Heap();
+    Heap(const Heap &) = delete;
+    Heap &operator=(const Heap &) = delete;
+
+    // Return nullptr if `size` is above HEAP_MAX_ALLOCATION or the system
+    // is out of memory.
+    void *alloc(size_t size);
+    void *alloc_temp(size_t size);
+    // Returns false, leaving the heap untouched, if `ptr` is not the start of
+    // a live block from alloc().
+    bool free(void *ptr);
+    // Releases every allocation at once; chunks are kept for reuse.
+    void reset();
+
+    // Start and requested size of the live block, from alloc() or
+    // alloc_temp(), that `ptr` points into; nullptr if there is none.
+    uint8_t *find(const void *ptr, size_t &size) const;
+    // Whether the `size` bytes at `ptr` lie inside one live block.
+    bool contains(const void *ptr, size_t size) const;
+
+    inline const HeapStats &stats() const {
+      return _stats;
+    }
+
+  private:
+    struct Block {
+      uint64_t size; // requested size
+      uint64_t temp; // from alloc_temp(), so free() refuses it
+    };
+
+    // Smallest block stride, and so the most blocks a chunk can hold.
+    static const size_t CHUNK_MAX_BLOCKS = HEAP_CHUNK_SIZE / (sizeof(Block) + 16);
+
+    // Header of a size-class chunk, or of a single large block.
+    struct Chunk {
+      Chunk *prev;         // large blocks only, in `large`
+      Chunk *next;
+      uint32_t size_class; // LARGE_CLASS for a large block
+      size_t stride;       // bytes per block, header included
+      size_t capacity;     // blocks that fit
+      size_t count;        // blocks carved out so far
+      uint64_t live[CHUNK_MAX_BLOCKS / 64];
+    };
+
+    static const uint32_t LARGE_CLASS = UINT32_MAX;
+    static const size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + HEAP_ALIGNMENT - 1) & ~(HEAP_ALIGNMENT - 1);
+    static_assert(sizeof(Block) % HEAP_ALIGNMENT == 0);
+
+    std::unordered_map<uintptr_t, Chunk *> regions; // HEAP_CHUNK_SIZE granule -> chunk covering it
+    std::vector<Chunk *> chunks; // every size-class chunk, the first `chunks_used` assigned to a class
+    size_t chunks_used = 0;
+    Chunk *current[HEAP_SIZE_CLASS_COUNT] = {}; // chunk being carved, per class
+    void *free_lists[HEAP_SIZE_CLASS_COUNT] = {};
+    Chunk *large = nullptr;
+    HeapStats _stats;
+
+    void *allocate(size_t size, bool temp);
+    Block *carve(uint32_t size_class);
+    Block *alloc_large(size_t size);
+    void free_large(Chunk *chunk);
+    Block *lookup(const void *ptr, Chunk *&chunk, size_t &index) const;
+  };
+};
@@ -0,0 +1,188 @@
+#include "metrics.h"
+
+#include <fmt/core.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace pushle {
+
+namespace {
+
+struct GlobalMetrics {
+  #define PUSHLE_METRIC_FIELD(name, kind, help) std::atomic<uint64_t> name{0};
+  PUSHLE_METRICS(PUSHLE_METRIC_FIELD)
+  #undef PUSHLE_METRIC_FIELD
+};
+
+GlobalMetrics global;
+
+void raise_to(std::atomic<uint64_t> &peak, uint64_t value) {
+  uint64_t current = peak.load(std::memory_order_relaxed);
+  while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+// Sends `text` over a new connection to "tcp:<host>:<port>" or "unix:<path>".
+void send_to(const std::string &destination, const std::string &text) {
+  int fd = -1;
+  if (destination.starts_with("unix:")) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    std::string path = destination.substr(5);
+    if (path.size() >= sizeof(address.sun_path)) {
+      throw std::runtime_error("metrics: socket path too long");
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (sockaddr *)&address, sizeof(address)) != 0) {
+      close(fd);
+      fd = -1;
+    }
+  } else {
+    size_t colon = destination.rfind(':');
+    if (colon <= 4) {
+      throw std::runtime_error("metrics: expected tcp:<host>:<port>");
+    }
+    std::string host = destination.substr(4, colon - 4);
+    std::string port = destination.substr(colon + 1);
+    addrinfo hints = {};
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+      throw std::runtime_error("metrics: cannot resolve " + host);
+    }
+    for (addrinfo *a = addresses; a != nullptr && fd < 0; a = a->ai_next) {
+      fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+      if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+        close(fd);
+        fd = -1;
+      }
+    }
+    freeaddrinfo(addresses);
+  }
+  if (fd < 0) {
+    throw std::runtime_error("metrics: cannot connect to " + destination);
+  }
+
+  size_t sent = 0;
+  while (sent < text.size()) {
+    ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) {
+      close(fd);
+      throw std::runtime_error("metrics: send to " + destination + " failed");
+    }
+    sent += n;
+  }
+  close(fd);
+}
+
+} // namespace
+
+void publish_metrics(const Metrics &now, const Metrics &before) {
+  #define PUSHLE_METRIC_PUBLISH(name, kind, help) \
+    if (kind == METRIC_COUNTER && now.name != before.name) { \
+      global.name.fetch_add(now.name - before.name, std::memory_order_relaxed); \
+    }
+  PUSHLE_METRICS(PUSHLE_METRIC_PUBLISH)
+  #undef PUSHLE_METRIC_PUBLISH
+
+  // unsigned arithmetic, so a VM whose heap shrank subtracts its difference
+  global.heap_live_bytes.fetch_add(now.heap_live_bytes - before.heap_live_bytes, std::memory_order_relaxed);
+  raise_to(global.stack_high_water, now.stack_high_water);
+  raise_to(global.heap_peak_bytes, now.heap_peak_bytes);
+}
+
+Metrics global_metrics() {
+  Metrics metrics;
+  #define PUSHLE_METRIC_LOAD(name, kind, help) metrics.name = global.name.load(std::memory_order_relaxed);
+  PUSHLE_METRICS(PUSHLE_METRIC_LOAD)
+  #undef PUSHLE_METRIC_LOAD
+  return metrics;
+}
+
+std::string metrics_json(const Metrics &metrics) {
+  std::string out = "{";
+  #define PUSHLE_METRIC_JSON(name, kind, help) \
+    out += fmt::format("{}\"" #name "\": {}", out.size() > 1 ? ", " : "", metrics.name);
+  PUSHLE_METRICS(PUSHLE_METRIC_JSON)
+  #undef PUSHLE_METRIC_JSON
+  out += "}\n";
+  return out;
+}
+
+std::string metrics_prometheus(const Metrics &metrics, const std::string &prefix) {
+  std::string out;
+  #define PUSHLE_METRIC_PROMETHEUS(name, kind, help) { \
+      std::string metric = prefix + "_" #name + (kind == METRIC_COUNTER ? "_total" : ""); \
+      out += fmt::format("# HELP {} {}\n", metric, help); \
+      out += fmt::format("# TYPE {} {}\n", metric, kind == METRIC_COUNTER ? "counter" : "gauge"); \
+      out += fmt::format("{} {}\n", metric, metrics.name); \
+    }
+  PUSHLE_METRICS(PUSHLE_METRIC_PROMETHEUS)
+  #undef PUSHLE_METRIC_PROMETHEUS
+  return out;
+}
+
+MetricsExporter::MetricsExporter(std::string destination, MetricsFormat format, std::chrono::milliseconds interval,
+                                 std::function<Metrics()> source)
+    : destination(std::move(destination)), format(format), interval(interval), source(std::move(source)) {
+  if (interval.count() <= 0) {
+    throw std::runtime_error("MetricsExporter: interval must be positive");
+  }
+  worker = std::thread(&MetricsExporter::work, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeup.notify_all();
+  worker.join();
+  try {
+    export_now();
+  } catch (const std::exception &) {
+    // nowhere to report it; the destination keeps the previous snapshot
+  }
+}
+
+void MetricsExporter::export_now() {
+  Metrics metrics = source();
+  std::string text = format == METRICS_JSON ? metrics_json(metrics) : metrics_prometheus(metrics);
+  if (destination.starts_with("tcp:") || destination.starts_with("unix:")) {
+    send_to(destination, text);
+    return;
+  }
+  std::string temp = destination + ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out << text;
+    if (!out) {
+      throw std::runtime_error("metrics: cannot write " + temp);
+    }
+  }
+  std::filesystem::rename(temp, destination);
+}
+
+void MetricsExporter::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!wakeup.wait_for(lock, interval, [this] { return stopping; })) {
+    lock.unlock();
+    try {
+      export_now();
+    } catch (const std::exception &) {
+      // a collector that is down must not stop the exporter; retry next time
+    }
+    lock.lock();
+  }
+}
+
+} // namespace pushle
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace pushle {
+  enum MetricKind { METRIC_COUNTER, METRIC_GAUGE };
+
+  // name, kind, description
+  #define PUSHLE_METRICS(X) \
+    X(runs,             METRIC_COUNTER, "Programs started") \
+    X(instructions,     METRIC_COUNTER, "Instructions retired by the interpreter") \
+    X(run_ns,           METRIC_COUNTER, "Wall time spent in resume(), in nanoseconds") \
+    X(completions,      METRIC_COUNTER, "Runs that reached the end of the program") \
+    X(yields,           METRIC_COUNTER, "Suspensions at yield or awaitnative") \
+    X(budget_stops,     METRIC_COUNTER, "Suspensions after running out of budget") \
+    X(traps,            METRIC_COUNTER, "Traps raised, and runs ended by an exception") \
+    X(errors,           METRIC_COUNTER, "Times an instruction set the error register") \
+    X(stack_high_water, METRIC_GAUGE,   "Most stack bytes in use at once") \
+    X(heap_live_bytes,  METRIC_GAUGE,   "Heap bytes allocated and not yet freed") \
+    X(heap_peak_bytes,  METRIC_GAUGE,   "Most heap bytes live at once")
+
+  // Counters of one VM (VM::metrics()) or of every VM in the process
+  // (global_metrics()). In the global view the stack and heap peaks are the
+  // largest of any VM and heap_live_bytes is the sum over all VMs.
+  struct Metrics {
+    #define PUSHLE_METRIC_FIELD(name, kind, help) uint64_t name = 0;
+    PUSHLE_METRICS(PUSHLE_METRIC_FIELD)
+    #undef PUSHLE_METRIC_FIELD
+  };
+
+  // Adds what a VM counted since it last published (`now` - `before`) to the
+  // global metrics. VMs call this when resume() returns, so the shared
+  // counters are touched once per slice rather than once per instruction.
+  void publish_metrics(const Metrics &now, const Metrics &before);
+  Metrics global_metrics();
+
+  std::string metrics_json(const Metrics &metrics);
+  // Prometheus text exposition format, each metric named `prefix`_<name>.
+  std::string metrics_prometheus(const Metrics &metrics, const std::string &prefix = "pushle");
+
+  enum MetricsFormat { METRICS_JSON, METRICS_PROMETHEUS };
+
+  // Writes a snapshot every `interval` on a background thread, and once more
+  // when destroyed. `destination` is a file path, replaced atomically so that
+  // readers never see a partial snapshot, or "tcp:<host>:<port>" or
+  // "unix:<path>" to send each snapshot over a new stream connection.
+  // Snapshots come from global_metrics() unless `source` is given.
+  class MetricsExporter {
+  public:
+    MetricsExporter(std::string destination, MetricsFormat format, std::chrono::milliseconds interval,
+                    std::function<Metrics()> source = global_metrics);
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+    // Writes a snapshot now; throws if the destination cannot be written.
+    void export_now();
+
+  private:
+    std::string destination;
+    MetricsFormat format;
+    std::chrono::milliseconds interval;
+    std::function<Metrics()> source;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool stopping = false;
+    std::thread worker;
+
+    void work();
+  };
+};
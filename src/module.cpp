@@ -0,0 +1,51 @@
+#include "module.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace pushle {
+
+Module Module::load(const uint8_t *data, size_t size) {
+  Module module;
+  if (size < sizeof(ModuleHeader) || memcmp(data, MODULE_MAGIC, sizeof(MODULE_MAGIC)) != 0) {
+    module.code = data;
+    module.code_size = size;
+    return module;
+  }
+
+  ModuleHeader header;
+  memcpy(&header, data, sizeof(header));
+  if (header.version != MODULE_VERSION) {
+    throw std::runtime_error("load(): unsupported module version");
+  }
+  if (sizeof(ModuleHeader) + header.section_count * sizeof(ModuleSection) > size) {
+    throw std::runtime_error("load(): truncated section table");
+  }
+
+  for (size_t i = 0; i < header.section_count; i++) {
+    ModuleSection section;
+    memcpy(&section, data + sizeof(ModuleHeader) + i * sizeof(ModuleSection), sizeof(section));
+    if (section.offset > size || section.size > size - section.offset) {
+      throw std::runtime_error("load(): section out of bounds");
+    }
+    switch (section.kind) {
+      case SECTION_CODE:
+        module.code = data + section.offset;
+        module.code_size = section.size;
+        break;
+      case SECTION_CONSTANTS:
+        module.constants = data + section.offset;
+        module.constant_count = section.size / sizeof(uint64_t);
+        break;
+      case SECTION_STRINGS:
+        module.strings = data + section.offset;
+        module.strings_size = section.size;
+        break;
+      default:
+        break; // unknown sections are skipped so newer assemblers stay loadable
+    }
+  }
+  return module;
+}
+
+} // namespace pushle
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pushle {
+  const char MODULE_MAGIC[4] = { 'P', 'S', 'H', 'L' };
+  const uint16_t MODULE_VERSION = 1;
+
+  enum SectionKind : uint32_t {
+    SECTION_CODE = 1,
+    SECTION_CONSTANTS = 2, // u64 entries referenced by pushk/setlk
+    SECTION_STRINGS = 3,   // StringHeader entries referenced by strk
+  };
+
+  // An assembled module is a ModuleHeader, `section_count` ModuleSection
+  // entries, then the section contents, each starting at an 8-byte boundary.
+  struct ModuleHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t section_count;
+  };
+
+  struct ModuleSection {
+    uint32_t kind;
+    uint32_t reserved;
+    uint64_t offset; // from the start of the module
+    uint64_t size;   // in bytes
+  };
+
+  const uint32_t STRING_INTERNED = 1; // lives in a strings section, deduplicated
+
+  // Precedes the bytes of every string, both in the strings section and on
+  // the heap. The bytes are followed by a NUL; section entries are padded to
+  // an 8-byte boundary. A string handle is the u64 address of its first byte.
+  struct StringHeader {
+    uint64_t hash; // string_hash() of the bytes
+    uint32_t length;
+    uint32_t flags;
+  };
+
+  // 64-bit FNV-1a.
+  inline uint64_t string_hash(const uint8_t *data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ data[i]) * 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  // View over an assembled module. Nothing is copied: every pointer refers
+  // into the buffer given to load(), which must outlive the Module.
+  struct Module {
+    const uint8_t *code = nullptr;
+    size_t code_size = 0;
+    const uint8_t *constants = nullptr;
+    size_t constant_count = 0;
+    const uint8_t *strings = nullptr;
+    size_t strings_size = 0; // in bytes
+
+    // Buffers that do not start with MODULE_MAGIC are taken to be raw code.
+    static Module load(const uint8_t *data, size_t size);
+  };
+};
@@ -1,7 +1,10 @@
 #pragma once
 
-#define _OP_T(prefix) \
-  prefix##I8, \
+#include <cstddef>
+
+// Optional trailing arguments are pasted after the first entry, e.g. `= 0x100`.
+#define _OP_T(prefix, ...) \
+  prefix##I8 __VA_ARGS__, \
   prefix##U8, \
   prefix##BOOL, \
   prefix##I16, \
@@ -13,8 +16,8 @@
   prefix##U64, \
   prefix##F64
 
-#define _OP_N(prefix) \
-  prefix##I8, \
+#define _OP_N(prefix, ...) \
+  prefix##I8 __VA_ARGS__, \
   prefix##U8, \
   prefix##I16, \
   prefix##U16, \
@@ -33,6 +36,20 @@
   prefix##I64, \
   prefix##F64
 
+#define _OP_F(prefix, ...) \
+  prefix##F32 __VA_ARGS__, \
+  prefix##F64
+
+#define _OP_Z(prefix, ...) \
+  prefix##I8 __VA_ARGS__, \
+  prefix##U8, \
+  prefix##I16, \
+  prefix##U16, \
+  prefix##I32, \
+  prefix##U32, \
+  prefix##I64, \
+  prefix##U64
+
 #define _OP_S(prefix) \
   prefix##1, \
   prefix##2, \
@@ -40,7 +57,53 @@
   prefix##8, \
   prefix##16
 
+// 128-bit types, kept out of the families above so that their opcodes can
+// live on a page of their own.
+#define _OP_W(prefix, ...) \
+  prefix##I128 __VA_ARGS__, \
+  prefix##U128, \
+  prefix##F128
+
+#define _OP_K(prefix) \
+  prefix##I64, \
+  prefix##U64, \
+  prefix##F64
+
+#define _OP_SI(prefix) \
+  prefix##I32, \
+  prefix##U32, \
+  prefix##I64, \
+  prefix##U64, \
+  prefix##F64
+
+#define _OP_V(prefix, ...) \
+  prefix##I8X16 __VA_ARGS__, \
+  prefix##U8X16, \
+  prefix##I16X8, \
+  prefix##U16X8, \
+  prefix##I32X4, \
+  prefix##U32X4, \
+  prefix##F32X4, \
+  prefix##I64X2, \
+  prefix##U64X2, \
+  prefix##F64X2, \
+  prefix##I8X32, \
+  prefix##U8X32, \
+  prefix##I16X16, \
+  prefix##U16X16, \
+  prefix##I32X8, \
+  prefix##U32X8, \
+  prefix##F32X8, \
+  prefix##I64X4, \
+  prefix##U64X4, \
+  prefix##F64X4
+
 namespace pushle {
+  // Opcodes below 0x100 are encoded as a single byte. Larger opcodes are
+  // encoded as a page prefix byte followed by the low byte of the opcode,
+  // where the prefix is OP_PAGE_PREFIX + (opcode >> 8) - 1.
+  const unsigned OP_PAGE_PREFIX = 0xf0;
+
   enum DataType {
     _none,
     _i8,
@@ -54,6 +117,10 @@ namespace pushle {
     _i64,
     _u64,
     _f64,
+    _ref,
+    _i128,
+    _u128,
+    _f128,
   };
 
   enum Op {
@@ -92,5 +159,213 @@ namespace pushle {
     RET,
     DBG,
     SIG,
+
+    // Constant pool (u8 or u16 index) and short immediates (one byte,
+    // widened to the type). The assembler picks these automatically.
+    PUSHK,
+    PUSHKW,
+    _OP_K(SETLK_),
+    _OP_K(SETLKW_),
+    _OP_SI(PUSHS_),
+    _OP_SI(SETLS_),
+
+    // Error register, see "Error Register" in spec.md.
+    JERR,
+    CLRERR,
+
+    // Calls a host function from the VM's native table, see "Native
+    // Functions" in spec.md.
+    CALLNATIVE,
+
+    // Suspend the VM until the host resumes it, see "Program Execution".
+    AWAITNATIVE,
+    YIELD,
+
+    // Packed vectors, see simd.h. Binary families overwrite the top vector
+    // with the lane-wise result, reductions replace the vector with a scalar.
+    _OP_V(VADD_, = 0x100),
+    _OP_V(VSUB_),
+    _OP_V(VMUL_),
+    _OP_V(VMIN_),
+    _OP_V(VMAX_),
+    _OP_V(VCMPEQ_),
+    _OP_V(VCMPLT_),
+    _OP_V(VSUM_),
+    _OP_V(VHMIN_),
+    _OP_V(VHMAX_),
+
+    // Heap, see heap.h. Addresses are u64 values on the stack.
+    HALLOC = 0x200,
+    HALLOCT,
+    HFREE,
+    HLOADG,
+    _OP_T(HLOAD_),
+    HSTOREG,
+    _OP_T(HSTORE_),
+
+    // Reference-counted objects, see "Reference-counted Pointers" in spec.md.
+    RNEW = 0x300,
+    RNEWL,
+    RRETAIN,
+    RRELEASE,
+    RFLUSH,
+    RCOUNT,
+    PUSHL_REF,
+    POPL_REF,
+    _OP_T(RLOAD_),
+    RLOAD_REF,
+    _OP_T(RSTORE_),
+    RSTORE_REF,
+
+    // Register-style ops that work on locals directly instead of going
+    // through the stack. The assembler lowers stack sequences to these.
+    _OP_T(MOVL_, = 0x400),
+    _OP_N(ADDL_),
+    _OP_N(SUBL_),
+    _OP_N(MULL_),
+    _OP_N(DIVL_),
+    _OP_N(REML_),
+    _OP_N(CMPL_),
+    _OP_N(CMPLI_),
+    _OP_N(CMPI_),
+    _OP_N(BRLI_Z_),
+    _OP_N(BRLI_NZ_),
+    _OP_N(BRLI_L_),
+    _OP_N(BRLI_G_),
+    _OP_N(BRLI_NL_),
+    _OP_N(BRLI_NG_),
+
+    // Pop two values, compare and branch without going through reg_cmp.
+    _OP_N(BR_Z_),
+    _OP_N(BR_NZ_),
+    _OP_N(BR_L_),
+    _OP_N(BR_G_),
+    _OP_N(BR_NL_),
+    _OP_N(BR_NG_),
+
+    // Integer arithmetic that detects overflow: checked ops wrap and set
+    // reg_err, saturating ops clamp to the type's range.
+    _OP_Z(ADDC_, = 0x500),
+    _OP_Z(SUBC_),
+    _OP_Z(MULC_),
+    _OP_Z(ADDS_),
+    _OP_Z(SUBS_),
+    _OP_Z(MULS_),
+
+    // Bitwise ops on the two's complement bits. Shift and rotate counts are
+    // taken modulo the width; shr is logical and sar arithmetic for every type.
+    _OP_Z(AND_, = 0x600),
+    _OP_Z(OR_),
+    _OP_Z(XOR_),
+    _OP_Z(NOT_),
+    _OP_Z(SHL_),
+    _OP_Z(SHR_),
+    _OP_Z(SAR_),
+    _OP_Z(ROTL_),
+    _OP_Z(ROTR_),
+    _OP_Z(POPCNT_),
+    _OP_Z(CLZ_),
+    _OP_Z(CTZ_),
+
+    // 128-bit integers and IEEE quad floats. Immediates are 16 bytes inline.
+    _OP_W(PUSH_, = 0x700),
+    _OP_W(PUSHL_),
+    _OP_W(POPL_),
+    _OP_W(SETL_),
+    _OP_W(ADD_),
+    _OP_W(SUB_),
+    _OP_W(MUL_),
+    _OP_W(DIV_),
+    _OP_W(REM_),
+    _OP_W(CMP_),
+
+    // Math intrinsics. Unary and ternary float ops overwrite the top value;
+    // min and max overwrite the top like the other binary ops.
+    _OP_F(SQRT_, = 0x800),
+    _OP_F(FLOOR_),
+    _OP_F(CEIL_),
+    _OP_F(ROUND_),
+    _OP_F(TRUNC_),
+    _OP_F(FMA_),
+    _OP_N(MIN_),
+    _OP_N(MAX_),
+
+    // Conversions, laid out as a matrix: CVT_<from>_<to>. They pop a value
+    // and push it converted, so the stack width changes with the type.
+    _OP_N(CVT_I8_),
+    _OP_N(CVT_U8_),
+    _OP_N(CVT_I16_),
+    _OP_N(CVT_U16_),
+    _OP_N(CVT_I32_),
+    _OP_N(CVT_U32_),
+    _OP_N(CVT_F32_),
+    _OP_N(CVT_I64_),
+    _OP_N(CVT_U64_),
+    _OP_N(CVT_F64_),
+
+    // Counted loops on a local. loop adds one and branches back while the
+    // local is below the limit; djnz subtracts one and branches back while
+    // it is non-zero. Both leave the comparison in reg_cmp like cmpli.
+    _OP_N(LOOP_, = 0x900),
+    _OP_N(DJNZ_),
+
+    // Typed arrays, see "Arrays" in spec.md. The local forms take the array
+    // and the u64 index from locals; the unchecked ones are emitted by the
+    // assembler for loops it has proved stay in bounds.
+    _OP_T(ANEW_, = 0xA00),
+    ALEN,
+    ASLICE,
+    _OP_T(ALOAD_),
+    _OP_T(ASTORE_),
+    _OP_T(ALOADL_),
+    _OP_T(ASTOREL_),
+    _OP_T(ALOADLU_),
+    _OP_T(ASTORELU_),
+    BRSIZE,
+
+    // Bulk memory on u64 addresses: heap blocks, host spans, or the stack
+    // through saddr. The byte count is popped first, as a u64.
+    SADDR = 0xB00,
+    MEMCOPY,
+    MEMFILL,
+    MEMCMP,
+    MEMFIND,
+
+    // Strings, see "Strings" in spec.md. Handles are u64 addresses; strk
+    // pushes an interned string from the module, the rest pop their operands
+    // and allocate results on the heap, to be released with strfree.
+    STRK = 0xC00,
+    STRLEN,
+    STRCAT,
+    STRCMP,
+    STREQ,
+    STRHASH,
+    STRSUB,
+    STRFREE,
+
+    // Traps, see "Traps" in spec.md. ontrap installs the handler for the
+    // next trap, raise pops a u8 trap code and raises it.
+    ONTRAP = 0xD00,
+    OFFTRAP,
+    RAISE,
+
+    // Fused pairs of local ops. bri_<cc> compares the top value with an
+    // immediate like cmpi and branches on it; movl2 is two movl in a row.
+    _OP_N(BRI_Z_, = 0xE00),
+    _OP_N(BRI_NZ_),
+    _OP_N(BRI_L_),
+    _OP_N(BRI_G_),
+    _OP_N(BRI_NL_),
+    _OP_N(BRI_NG_),
+    _OP_T(MOVL2_),
+
+    // Counted loop on the top value: while it is below the limit, loopt adds
+    // one to it and branches back. It leaves the comparison in reg_cmp.
+    _OP_N(LOOPT_),
   };
+
+  // Number of bytes the opcode itself takes up in bytecode.
+  inline size_t op_size(Op op) {
+    return op < 0x100 ? 1 : 2;
+  }
 };
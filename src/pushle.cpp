@@ -1,44 +1,279 @@
 #include "pushle.h"
 
-#include <exception>
-#include <stdexcept>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// fmt has no formatter for __float128; debug output goes through long double.
+template <>
+struct fmt::formatter<pushle::float128_t> : fmt::formatter<long double> {
+  auto format(pushle::float128_t value, fmt::format_context &ctx) const {
+    return fmt::formatter<long double>::format((long double)value, ctx);
+  }
+};
 
 namespace pushle {
 
 VM::VM() {
   for (size_t i = 0; i < VM_STACK_SIZE; i++)
     stack[i] = 0;
-  stack_top = nullptr;
+  sp = stack;
+  stack_peak = stack;
 
   program = nullptr;
   program_size = 0;
   instruction = nullptr;
+  constants = nullptr;
+  constant_count = 0;
+  strings = nullptr;
+  strings_size = 0;
+
+  vec = &simd::kernels();
 
   reg_cmp = 0;
   reg_err = 0;
+  reg_trap = TRAP_NONE;
+  trap_at = 0;
+  trap_handler = VM_NO_TRAP_HANDLER;
+  trap_depth = 0;
   reg_ret = nullptr;
+  stop_request = RUN_DONE;
+  budget = VM_NO_BUDGET;
 
-  // TODO: heap
+  release_count = 0;
+  tracer = nullptr;
 
   VM_DEBUG_1("VM initialized");
 }
 
-void VM::run(const uint8_t *program, size_t size) {
-  this->program = program;
-  this->program_size = size;
+VM::~VM() {
+  // take this VM's heap back out of the global live bytes
+  Metrics now = metrics();
+  now.heap_live_bytes = 0;
+  publish_metrics(now, published);
+}
+
+Metrics VM::metrics() const {
+  Metrics metrics = counters;
+  metrics.stack_high_water = stack_peak - stack;
+  metrics.heap_live_bytes = heap.stats().live_bytes;
+  metrics.heap_peak_bytes = heap.stats().peak_live_bytes;
+  return metrics;
+}
+
+void VM::reset() {
+  sp = stack;
   instruction = program;
-  // TODO: locate start instruction and set instruction pointer
-  while (step()) {
-    // usleep(10000);
+  scope = VMScope();
+  reg_cmp = 0;
+  reg_err = 0;
+  reg_trap = TRAP_NONE;
+  trap_handler = VM_NO_TRAP_HANDLER;
+  reg_ret = nullptr;
+  stop_request = RUN_DONE;
+  budget = VM_NO_BUDGET;
+  release_count = 0;
+  spans.clear();
+  heap.reset();
+}
+
+RunStatus VM::run(const uint8_t *program, size_t size) {
+  Module module;
+  module.code = program;
+  module.code_size = size;
+  return run(module);
+}
+
+RunStatus VM::run(const Module &module) {
+  return run(module, 0);
+}
+
+RunStatus VM::run(const Module &module, size_t entry) {
+  start(module, entry);
+  return resume();
+}
+
+void VM::start(const Module &module, size_t entry) {
+  program = module.code;
+  program_size = module.code_size;
+  constants = module.constants;
+  constant_count = module.constant_count;
+  strings = module.strings;
+  strings_size = module.strings_size;
+  instruction = program + entry;
+  stop_request = RUN_DONE;
+  reg_trap = TRAP_NONE;
+  trap_handler = VM_NO_TRAP_HANDLER;
+  counters.runs++;
+  if (entry > program_size) {
+    // resume() then stops on the trap before executing anything
+    instruction = program;
+    trap_at = entry;
+    trap(TRAP_BOUNDS);
+  }
+}
+
+RunStatus VM::resume(uint64_t budget) {
+  // Straight-line code always reaches a branch or the end of the program, so
+  // the budget only needs to be checked where execution can go backwards.
+  this->budget = budget;
+  if (reg_trap != TRAP_NONE) {
+    return RUN_TRAPPED;
+  }
+  if (budget == 0) {
+    return RUN_BUDGET;
+  }
+  auto begin = std::chrono::steady_clock::now();
+  RunStatus status = tracer != nullptr ? dispatch<true>() : dispatch<false>();
+  switch (status) {
+    case RUN_DONE:    counters.completions++; break;
+    case RUN_YIELDED: counters.yields++; break;
+    case RUN_BUDGET:  counters.budget_stops++; break;
+    case RUN_TRAPPED: break; // counted by trap()
+  }
+  end_slice(begin);
+  return status;
+}
+
+void VM::end_slice(std::chrono::steady_clock::time_point begin) {
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  counters.run_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  Metrics now = metrics();
+  publish_metrics(now, published);
+  published = now;
+}
+
+// The traced loop is a separate instantiation, so an untraced VM does not
+// even test whether tracing is on between instructions.
+template <bool Traced>
+RunStatus VM::dispatch() {
+  for (;;) {
+    const uint8_t *start = instruction;
+    if constexpr (Traced) {
+      trace_step();
+    }
+    if (!step()) {
+      break;
+    }
+    counters.instructions++;
+    RunStatus status;
+    if (stop_request != RUN_DONE && stopped(start, status)) {
+      return status;
+    }
     VM_DEBUG_2("");
     VM_DEBUG_2("");
   }
+  flush_releases();
+  return RUN_DONE;
+}
+
+// The single exit from dispatch() for yields, budget stops and traps, taken
+// after the instruction at `start` asked to stop. Returns false if a trap
+// handler took over and execution goes on.
+bool VM::stopped(const uint8_t *start, RunStatus &status) {
+  status = stop_request;
+  stop_request = RUN_DONE;
+  if (reg_trap == TRAP_NONE) {
+    return true;
+  }
+  trap_at = start - program;
+  size_t handler = enter_trap_handler();
+  if (handler == VM_NO_TRAP_HANDLER) {
+    status = RUN_TRAPPED;
+    return true;
+  }
+  instruction = program + handler;
+  // Entering a handler at or before the faulting instruction is charged like
+  // a backward branch, so a loop through the handler is still preempted; a
+  // budget stop in the faulting instruction also ends the slice.
+  if (budget == 0 || (instruction <= start && --budget == 0)) {
+    status = RUN_BUDGET;
+  }
+  return status != RUN_TRAPPED;
+}
+
+// Raises `code`; the first trap of an instruction wins. Operands that fault
+// read as zeros from trap_scratch so the instruction can finish safely.
+void VM::trap(TrapCode code) {
+  VM_DEBUG_1("trap: {}", trap_name(code));
+  dbg(-1);
+  if (reg_trap == TRAP_NONE) {
+    reg_trap = code;
+    counters.traps++;
+  }
+  stop_request = RUN_TRAPPED;
+  memset(trap_scratch, 0, sizeof(trap_scratch));
+}
+
+// Clears the pending trap and makes the stack what the handler expects: as
+// it was at `ontrap`, plus the u64 faulting offset and the u8 trap code.
+// Returns the handler's code offset, or VM_NO_TRAP_HANDLER.
+size_t VM::enter_trap_handler() {
+  size_t handler = trap_handler;
+  if (handler == VM_NO_TRAP_HANDLER) {
+    return handler;
+  }
+  // a trap in the handler itself is not caught by it
+  trap_handler = VM_NO_TRAP_HANDLER;
+  uint64_t offset = trap_at;
+  uint8_t code = reg_trap;
+  reg_trap = TRAP_NONE;
+  stop_request = RUN_DONE;
+  sp = stack + trap_depth;
+  push(&offset, sizeof(offset));
+  push(&code, sizeof(code));
+  return handler;
+}
+
+const char *trap_name(TrapCode code) {
+  switch (code) {
+    case TRAP_NONE:            return "no trap";
+    case TRAP_CODE_BOUNDS:     return "code out of bounds";
+    case TRAP_BAD_OPCODE:      return "unknown opcode";
+    case TRAP_STACK_OVERFLOW:  return "stack overflow";
+    case TRAP_STACK_UNDERFLOW: return "stack underflow";
+    case TRAP_NULL:            return "null address";
+    case TRAP_BOUNDS:          return "out of bounds";
+    case TRAP_TOO_LARGE:       return "length too large";
+    case TRAP_BAD_FREE:        return "bad free";
+    case TRAP_NO_NATIVE:       return "no native function";
+    case TRAP_TYPE:            return "wrong local type";
+    default:                   return code >= TRAP_USER ? "user trap" : "unknown trap";
+  }
+}
+
+// Records the instruction step() is about to execute.
+void VM::trace_step() {
+  if (instruction == nullptr || instruction >= program + program_size) {
+    return;
+  }
+  uint32_t opcode = *instruction;
+  if (opcode >= OP_PAGE_PREFIX && instruction + 1 < program + program_size) {
+    opcode = ((opcode - OP_PAGE_PREFIX + 1) << 8) | instruction[1];
+  }
+  size_t depth = sp - stack;
+  size_t n = depth < sizeof(uint64_t) ? depth : sizeof(uint64_t);
+  uint64_t top = 0;
+  memcpy(&top, sp - n, n);
+  tracer->record(instruction - program, opcode, depth, top);
+}
+
+void VM::branch(size_t offset) {
+  const uint8_t *target = program + offset;
+  if (target <= instruction && --budget == 0) {
+    stop_request = RUN_BUDGET;
+  }
+  instruction = target;
 }
 
 void *VM::read(size_t size) {
   VM_DEBUG_2("->read {}", size);
   if (instruction + size > program + program_size) {
-    throw std::runtime_error("read(): out of bounds");
+    trap(TRAP_CODE_BOUNDS);
+    return trap_scratch;
   }
   this->instruction += size;
   return (void *)(this->instruction - size);
@@ -53,55 +288,77 @@ bool VM::step() { // returns false if VM is finished
 
   Op opcode = (Op) *instruction;
   instruction++;
+  if (opcode >= OP_PAGE_PREFIX) {
+    opcode = (Op) (((opcode - OP_PAGE_PREFIX + 1) << 8) | load<uint8_t>(read(1)));
+  }
 
   switch (opcode) {
-    case PUSH_I8:   VM_DEBUG_2("i:PUSH_I8");         push_i8(*(int8_t *)read(1)); break;
-    case PUSH_U8:   VM_DEBUG_2("i:PUSH_U8");         push_u8(*(uint8_t *)read(1)); break;
-    case PUSH_BOOL: VM_DEBUG_2("i:PUSH_BOOL");       push_bool(*(bool *)read(1)); break;
-    case PUSH_I16:  VM_DEBUG_2("i:PUSH_I16");        push_i16(*(int16_t *)read(2)); break;
-    case PUSH_U16:  VM_DEBUG_2("i:PUSH_U16");        push_u16(*(uint16_t *)read(2)); break;
-    case PUSH_I32:  VM_DEBUG_2("i:PUSH_I32");        push_i32(*(int32_t *)read(4)); break;
-    case PUSH_U32:  VM_DEBUG_2("i:PUSH_U32");        push_u32(*(uint32_t *)read(4)); break;
-    case PUSH_F32:  VM_DEBUG_2("i:PUSH_F32");        push_f32(*(float *)read(4)); break;
-    case PUSH_I64:  VM_DEBUG_2("i:PUSH_I64");        push_i64(*(int64_t *)read(8)); break;
-    case PUSH_U64:  VM_DEBUG_2("i:PUSH_U64");        push_u64(*(uint64_t *)read(8)); break;
-    case PUSH_F64:  VM_DEBUG_2("i:PUSH_F64");        push_f64(*(double *)read(8)); break;
+    case PUSH_I8:   VM_DEBUG_2("i:PUSH_I8");         push_i8(load<int8_t>(read(1))); break;
+    case PUSH_U8:   VM_DEBUG_2("i:PUSH_U8");         push_u8(load<uint8_t>(read(1))); break;
+    case PUSH_BOOL: VM_DEBUG_2("i:PUSH_BOOL");       push_bool(load<bool>(read(1))); break;
+    case PUSH_I16:  VM_DEBUG_2("i:PUSH_I16");        push_i16(load<int16_t>(read(2))); break;
+    case PUSH_U16:  VM_DEBUG_2("i:PUSH_U16");        push_u16(load<uint16_t>(read(2))); break;
+    case PUSH_I32:  VM_DEBUG_2("i:PUSH_I32");        push_i32(load<int32_t>(read(4))); break;
+    case PUSH_U32:  VM_DEBUG_2("i:PUSH_U32");        push_u32(load<uint32_t>(read(4))); break;
+    case PUSH_F32:  VM_DEBUG_2("i:PUSH_F32");        push_f32(load<float>(read(4))); break;
+    case PUSH_I64:  VM_DEBUG_2("i:PUSH_I64");        push_i64(load<int64_t>(read(8))); break;
+    case PUSH_U64:  VM_DEBUG_2("i:PUSH_U64");        push_u64(load<uint64_t>(read(8))); break;
+    case PUSH_F64:  VM_DEBUG_2("i:PUSH_F64");        push_f64(load<double>(read(8))); break;
     
-    case POPL_I8:  VM_DEBUG_2("i:POPL_I8");          popl_i8(&scope, *(uint8_t *)read(1)); break;
-    case POPL_U8:  VM_DEBUG_2("i:POPL_U8");          popl_u8(&scope, *(uint8_t *)read(1)); break;
-    case POPL_BOOL:VM_DEBUG_2("i:POPL_BOOL");        popl_bool(&scope, *(uint8_t *)read(1)); break;
-    case POPL_I16: VM_DEBUG_2("i:POPL_I16");         popl_i16(&scope, *(uint8_t *)read(1)); break;
-    case POPL_U16: VM_DEBUG_2("i:POPL_U16");         popl_u16(&scope, *(uint8_t *)read(1)); break;
-    case POPL_I32: VM_DEBUG_2("i:POPL_I32");         popl_i32(&scope, *(uint8_t *)read(1)); break;
-    case POPL_U32: VM_DEBUG_2("i:POPL_U32");         popl_u32(&scope, *(uint8_t *)read(1)); break;
-    case POPL_F32: VM_DEBUG_2("i:POPL_F32");         popl_f32(&scope, *(uint8_t *)read(1)); break;
-    case POPL_I64: VM_DEBUG_2("i:POPL_I64");         popl_i64(&scope, *(uint8_t *)read(1)); break;
-    case POPL_U64: VM_DEBUG_2("i:POPL_U64");         popl_u64(&scope, *(uint8_t *)read(1)); break;
-    case POPL_F64: VM_DEBUG_2("i:POPL_F64");         popl_f64(&scope, *(uint8_t *)read(1)); break;
+    case POPL_I8:  VM_DEBUG_2("i:POPL_I8");          popl_i8(&scope, load<uint8_t>(read(1))); break;
+    case POPL_U8:  VM_DEBUG_2("i:POPL_U8");          popl_u8(&scope, load<uint8_t>(read(1))); break;
+    case POPL_BOOL:VM_DEBUG_2("i:POPL_BOOL");        popl_bool(&scope, load<uint8_t>(read(1))); break;
+    case POPL_I16: VM_DEBUG_2("i:POPL_I16");         popl_i16(&scope, load<uint8_t>(read(1))); break;
+    case POPL_U16: VM_DEBUG_2("i:POPL_U16");         popl_u16(&scope, load<uint8_t>(read(1))); break;
+    case POPL_I32: VM_DEBUG_2("i:POPL_I32");         popl_i32(&scope, load<uint8_t>(read(1))); break;
+    case POPL_U32: VM_DEBUG_2("i:POPL_U32");         popl_u32(&scope, load<uint8_t>(read(1))); break;
+    case POPL_F32: VM_DEBUG_2("i:POPL_F32");         popl_f32(&scope, load<uint8_t>(read(1))); break;
+    case POPL_I64: VM_DEBUG_2("i:POPL_I64");         popl_i64(&scope, load<uint8_t>(read(1))); break;
+    case POPL_U64: VM_DEBUG_2("i:POPL_U64");         popl_u64(&scope, load<uint8_t>(read(1))); break;
+    case POPL_F64: VM_DEBUG_2("i:POPL_F64");         popl_f64(&scope, load<uint8_t>(read(1))); break;
       
-    case PUSHL_I8:  VM_DEBUG_2("i:PUSHL_I8");        pushl_i8(&scope, *(int8_t *)read(1)); break;
-    case PUSHL_U8:  VM_DEBUG_2("i:PUSHL_U8");        pushl_u8(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_BOOL:VM_DEBUG_2("i:PUSHL_BOOL");      pushl_bool(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_I16: VM_DEBUG_2("i:PUSHL_I16");       pushl_i16(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_U16: VM_DEBUG_2("i:PUSHL_U16");       pushl_u16(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_I32: VM_DEBUG_2("i:PUSHL_I32");       pushl_i32(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_U32: VM_DEBUG_2("i:PUSHL_U32");       pushl_u32(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_F32: VM_DEBUG_2("i:PUSHL_F32");       pushl_f32(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_I64: VM_DEBUG_2("i:PUSHL_I64");       pushl_i64(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_U64: VM_DEBUG_2("i:PUSHL_U64");       pushl_u64(&scope, *(uint8_t *)read(1)); break;
-    case PUSHL_F64: VM_DEBUG_2("i:PUSHL_F64");       pushl_f64(&scope, *(uint8_t *)read(1)); break;
+    case PUSHL_I8:  VM_DEBUG_2("i:PUSHL_I8");        pushl_i8(&scope, load<int8_t>(read(1))); break;
+    case PUSHL_U8:  VM_DEBUG_2("i:PUSHL_U8");        pushl_u8(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_BOOL:VM_DEBUG_2("i:PUSHL_BOOL");      pushl_bool(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_I16: VM_DEBUG_2("i:PUSHL_I16");       pushl_i16(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_U16: VM_DEBUG_2("i:PUSHL_U16");       pushl_u16(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_I32: VM_DEBUG_2("i:PUSHL_I32");       pushl_i32(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_U32: VM_DEBUG_2("i:PUSHL_U32");       pushl_u32(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_F32: VM_DEBUG_2("i:PUSHL_F32");       pushl_f32(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_I64: VM_DEBUG_2("i:PUSHL_I64");       pushl_i64(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_U64: VM_DEBUG_2("i:PUSHL_U64");       pushl_u64(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_F64: VM_DEBUG_2("i:PUSHL_F64");       pushl_f64(&scope, load<uint8_t>(read(1))); break;
     
-    case SETL_I8:   VM_DEBUG_2("i:SETL_I8");        { int8_t index = *(uint8_t *)read(1);  int8_t      value = *(int8_t *)read(1);       setl_i8(value, &scope, index);   break; }
-    case SETL_U8:   VM_DEBUG_2("i:SETL_U8");        { int8_t index = *(uint8_t *)read(1);  uint8_t     value = *(uint8_t *)read(1);      setl_u8(value, &scope, index);   break; }
-    case SETL_BOOL: VM_DEBUG_2("i:SETL_BOOL");      { int8_t index = *(uint8_t *)read(1);  bool        value = *(bool *)read(1);         setl_bool(value, &scope, index); break; }
-    case SETL_I16:  VM_DEBUG_2("i:SETL_I16");       { int8_t index = *(uint8_t *)read(1);  int16_t     value = *(int16_t *)read(2);      setl_i16(value, &scope, index);  break; }
-    case SETL_U16:  VM_DEBUG_2("i:SETL_U16");       { int8_t index = *(uint8_t *)read(1);  uint16_t    value = *(uint16_t *)read(2);     setl_u16(value, &scope, index);  break; }
-    case SETL_I32:  VM_DEBUG_2("i:SETL_I32");       { int8_t index = *(uint8_t *)read(1);  int32_t     value = *(int32_t *)read(4);      setl_i32(value, &scope, index);  break; }
-    case SETL_U32:  VM_DEBUG_2("i:SETL_U32");       { int8_t index = *(uint8_t *)read(1);  uint32_t    value = *(uint32_t *)read(4);     setl_u32(value, &scope, index);  break; }
-    case SETL_F32:  VM_DEBUG_2("i:SETL_F32");       { int8_t index = *(uint8_t *)read(1);  float       value = *(float *)read(4);        setl_f32(value, &scope, index);  break; }
-    case SETL_I64:  VM_DEBUG_2("i:SETL_I64");       { int8_t index = *(uint8_t *)read(1);  int64_t     value = *(int64_t *)read(8);      setl_i64(value, &scope, index);  break; }
-    case SETL_U64:  VM_DEBUG_2("i:SETL_U64");       { int8_t index = *(uint8_t *)read(1);  uint64_t    value = *(uint64_t *)read(8);     setl_u64(value, &scope, index);  break; }
-    case SETL_F64:  VM_DEBUG_2("i:SETL_F64");       { int8_t index = *(uint8_t *)read(1);  double      value = *(double *)read(8);       setl_f64(value, &scope, index);  break; }
+    case SETL_I8:   VM_DEBUG_2("i:SETL_I8");        { int8_t index = load<uint8_t>(read(1));  int8_t      value = load<int8_t>(read(1));       setl_i8(value, &scope, index);   break; }
+    case SETL_U8:   VM_DEBUG_2("i:SETL_U8");        { int8_t index = load<uint8_t>(read(1));  uint8_t     value = load<uint8_t>(read(1));      setl_u8(value, &scope, index);   break; }
+    case SETL_BOOL: VM_DEBUG_2("i:SETL_BOOL");      { int8_t index = load<uint8_t>(read(1));  bool        value = load<bool>(read(1));         setl_bool(value, &scope, index); break; }
+    case SETL_I16:  VM_DEBUG_2("i:SETL_I16");       { int8_t index = load<uint8_t>(read(1));  int16_t     value = load<int16_t>(read(2));      setl_i16(value, &scope, index);  break; }
+    case SETL_U16:  VM_DEBUG_2("i:SETL_U16");       { int8_t index = load<uint8_t>(read(1));  uint16_t    value = load<uint16_t>(read(2));     setl_u16(value, &scope, index);  break; }
+    case SETL_I32:  VM_DEBUG_2("i:SETL_I32");       { int8_t index = load<uint8_t>(read(1));  int32_t     value = load<int32_t>(read(4));      setl_i32(value, &scope, index);  break; }
+    case SETL_U32:  VM_DEBUG_2("i:SETL_U32");       { int8_t index = load<uint8_t>(read(1));  uint32_t    value = load<uint32_t>(read(4));     setl_u32(value, &scope, index);  break; }
+    case SETL_F32:  VM_DEBUG_2("i:SETL_F32");       { int8_t index = load<uint8_t>(read(1));  float       value = load<float>(read(4));        setl_f32(value, &scope, index);  break; }
+    case SETL_I64:  VM_DEBUG_2("i:SETL_I64");       { int8_t index = load<uint8_t>(read(1));  int64_t     value = load<int64_t>(read(8));      setl_i64(value, &scope, index);  break; }
+    case SETL_U64:  VM_DEBUG_2("i:SETL_U64");       { int8_t index = load<uint8_t>(read(1));  uint64_t    value = load<uint64_t>(read(8));     setl_u64(value, &scope, index);  break; }
+    case SETL_F64:  VM_DEBUG_2("i:SETL_F64");       { int8_t index = load<uint8_t>(read(1));  double      value = load<double>(read(8));       setl_f64(value, &scope, index);  break; }
+
+    case PUSHK:     VM_DEBUG_2("i:PUSHK");           push(constant(load<uint8_t>(read(1))), 8); break;
+    case PUSHKW:    VM_DEBUG_2("i:PUSHKW");          push(constant(load<uint16_t>(read(2))), 8); break;
+    case SETLK_I64: VM_DEBUG_2("i:SETLK_I64");       { uint8_t index = load<uint8_t>(read(1)); setl_i64(load<int64_t>(constant(load<uint8_t>(read(1)))), &scope, index); break; }
+    case SETLK_U64: VM_DEBUG_2("i:SETLK_U64");       { uint8_t index = load<uint8_t>(read(1)); setl_u64(load<uint64_t>(constant(load<uint8_t>(read(1)))), &scope, index); break; }
+    case SETLK_F64: VM_DEBUG_2("i:SETLK_F64");       { uint8_t index = load<uint8_t>(read(1)); setl_f64(load<double>(constant(load<uint8_t>(read(1)))), &scope, index); break; }
+    case SETLKW_I64:VM_DEBUG_2("i:SETLKW_I64");      { uint8_t index = load<uint8_t>(read(1)); setl_i64(load<int64_t>(constant(load<uint16_t>(read(2)))), &scope, index); break; }
+    case SETLKW_U64:VM_DEBUG_2("i:SETLKW_U64");      { uint8_t index = load<uint8_t>(read(1)); setl_u64(load<uint64_t>(constant(load<uint16_t>(read(2)))), &scope, index); break; }
+    case SETLKW_F64:VM_DEBUG_2("i:SETLKW_F64");      { uint8_t index = load<uint8_t>(read(1)); setl_f64(load<double>(constant(load<uint16_t>(read(2)))), &scope, index); break; }
+    case PUSHS_I32: VM_DEBUG_2("i:PUSHS_I32");       push_i32(load<int8_t>(read(1))); break;
+    case PUSHS_U32: VM_DEBUG_2("i:PUSHS_U32");       push_u32(load<uint8_t>(read(1))); break;
+    case PUSHS_I64: VM_DEBUG_2("i:PUSHS_I64");       push_i64(load<int8_t>(read(1))); break;
+    case PUSHS_U64: VM_DEBUG_2("i:PUSHS_U64");       push_u64(load<uint8_t>(read(1))); break;
+    case PUSHS_F64: VM_DEBUG_2("i:PUSHS_F64");       push_f64(load<int8_t>(read(1))); break;
+    case SETLS_I32: VM_DEBUG_2("i:SETLS_I32");       { uint8_t index = load<uint8_t>(read(1)); setl_i32(load<int8_t>(read(1)), &scope, index); break; }
+    case SETLS_U32: VM_DEBUG_2("i:SETLS_U32");       { uint8_t index = load<uint8_t>(read(1)); setl_u32(load<uint8_t>(read(1)), &scope, index); break; }
+    case SETLS_I64: VM_DEBUG_2("i:SETLS_I64");       { uint8_t index = load<uint8_t>(read(1)); setl_i64(load<int8_t>(read(1)), &scope, index); break; }
+    case SETLS_U64: VM_DEBUG_2("i:SETLS_U64");       { uint8_t index = load<uint8_t>(read(1)); setl_u64(load<uint8_t>(read(1)), &scope, index); break; }
+    case SETLS_F64: VM_DEBUG_2("i:SETLS_F64");       { uint8_t index = load<uint8_t>(read(1)); setl_f64(load<int8_t>(read(1)), &scope, index); break; }
 
     case ADD_I8:    VM_DEBUG_2("i:ADD_I8");          add_i8(); break;
     case ADD_U8:    VM_DEBUG_2("i:ADD_U8");          add_u8(); break;
@@ -165,6 +422,468 @@ bool VM::step() { // returns false if VM is finished
     case ABS_I64:   VM_DEBUG_2("i:ABS_I64");         abs_i64(); break;
     case ABS_F64:   VM_DEBUG_2("i:ABS_F64");         abs_f64(); break;
     
+    case ADDC_I8:   VM_DEBUG_2("i:ADDC_I8");         addc_i8(); break;
+    case ADDC_U8:   VM_DEBUG_2("i:ADDC_U8");         addc_u8(); break;
+    case ADDC_I16:  VM_DEBUG_2("i:ADDC_I16");        addc_i16(); break;
+    case ADDC_U16:  VM_DEBUG_2("i:ADDC_U16");        addc_u16(); break;
+    case ADDC_I32:  VM_DEBUG_2("i:ADDC_I32");        addc_i32(); break;
+    case ADDC_U32:  VM_DEBUG_2("i:ADDC_U32");        addc_u32(); break;
+    case ADDC_I64:  VM_DEBUG_2("i:ADDC_I64");        addc_i64(); break;
+    case ADDC_U64:  VM_DEBUG_2("i:ADDC_U64");        addc_u64(); break;
+
+    case SUBC_I8:   VM_DEBUG_2("i:SUBC_I8");         subc_i8(); break;
+    case SUBC_U8:   VM_DEBUG_2("i:SUBC_U8");         subc_u8(); break;
+    case SUBC_I16:  VM_DEBUG_2("i:SUBC_I16");        subc_i16(); break;
+    case SUBC_U16:  VM_DEBUG_2("i:SUBC_U16");        subc_u16(); break;
+    case SUBC_I32:  VM_DEBUG_2("i:SUBC_I32");        subc_i32(); break;
+    case SUBC_U32:  VM_DEBUG_2("i:SUBC_U32");        subc_u32(); break;
+    case SUBC_I64:  VM_DEBUG_2("i:SUBC_I64");        subc_i64(); break;
+    case SUBC_U64:  VM_DEBUG_2("i:SUBC_U64");        subc_u64(); break;
+
+    case MULC_I8:   VM_DEBUG_2("i:MULC_I8");         mulc_i8(); break;
+    case MULC_U8:   VM_DEBUG_2("i:MULC_U8");         mulc_u8(); break;
+    case MULC_I16:  VM_DEBUG_2("i:MULC_I16");        mulc_i16(); break;
+    case MULC_U16:  VM_DEBUG_2("i:MULC_U16");        mulc_u16(); break;
+    case MULC_I32:  VM_DEBUG_2("i:MULC_I32");        mulc_i32(); break;
+    case MULC_U32:  VM_DEBUG_2("i:MULC_U32");        mulc_u32(); break;
+    case MULC_I64:  VM_DEBUG_2("i:MULC_I64");        mulc_i64(); break;
+    case MULC_U64:  VM_DEBUG_2("i:MULC_U64");        mulc_u64(); break;
+
+    case ADDS_I8:   VM_DEBUG_2("i:ADDS_I8");         adds_i8(); break;
+    case ADDS_U8:   VM_DEBUG_2("i:ADDS_U8");         adds_u8(); break;
+    case ADDS_I16:  VM_DEBUG_2("i:ADDS_I16");        adds_i16(); break;
+    case ADDS_U16:  VM_DEBUG_2("i:ADDS_U16");        adds_u16(); break;
+    case ADDS_I32:  VM_DEBUG_2("i:ADDS_I32");        adds_i32(); break;
+    case ADDS_U32:  VM_DEBUG_2("i:ADDS_U32");        adds_u32(); break;
+    case ADDS_I64:  VM_DEBUG_2("i:ADDS_I64");        adds_i64(); break;
+    case ADDS_U64:  VM_DEBUG_2("i:ADDS_U64");        adds_u64(); break;
+
+    case SUBS_I8:   VM_DEBUG_2("i:SUBS_I8");         subs_i8(); break;
+    case SUBS_U8:   VM_DEBUG_2("i:SUBS_U8");         subs_u8(); break;
+    case SUBS_I16:  VM_DEBUG_2("i:SUBS_I16");        subs_i16(); break;
+    case SUBS_U16:  VM_DEBUG_2("i:SUBS_U16");        subs_u16(); break;
+    case SUBS_I32:  VM_DEBUG_2("i:SUBS_I32");        subs_i32(); break;
+    case SUBS_U32:  VM_DEBUG_2("i:SUBS_U32");        subs_u32(); break;
+    case SUBS_I64:  VM_DEBUG_2("i:SUBS_I64");        subs_i64(); break;
+    case SUBS_U64:  VM_DEBUG_2("i:SUBS_U64");        subs_u64(); break;
+
+    case MULS_I8:   VM_DEBUG_2("i:MULS_I8");         muls_i8(); break;
+    case MULS_U8:   VM_DEBUG_2("i:MULS_U8");         muls_u8(); break;
+    case MULS_I16:  VM_DEBUG_2("i:MULS_I16");        muls_i16(); break;
+    case MULS_U16:  VM_DEBUG_2("i:MULS_U16");        muls_u16(); break;
+    case MULS_I32:  VM_DEBUG_2("i:MULS_I32");        muls_i32(); break;
+    case MULS_U32:  VM_DEBUG_2("i:MULS_U32");        muls_u32(); break;
+    case MULS_I64:  VM_DEBUG_2("i:MULS_I64");        muls_i64(); break;
+    case MULS_U64:  VM_DEBUG_2("i:MULS_U64");        muls_u64(); break;
+
+    case AND_I8:    VM_DEBUG_2("i:AND_I8");          and_i8(); break;
+    case AND_U8:    VM_DEBUG_2("i:AND_U8");          and_u8(); break;
+    case AND_I16:   VM_DEBUG_2("i:AND_I16");         and_i16(); break;
+    case AND_U16:   VM_DEBUG_2("i:AND_U16");         and_u16(); break;
+    case AND_I32:   VM_DEBUG_2("i:AND_I32");         and_i32(); break;
+    case AND_U32:   VM_DEBUG_2("i:AND_U32");         and_u32(); break;
+    case AND_I64:   VM_DEBUG_2("i:AND_I64");         and_i64(); break;
+    case AND_U64:   VM_DEBUG_2("i:AND_U64");         and_u64(); break;
+
+    case OR_I8:     VM_DEBUG_2("i:OR_I8");           or_i8(); break;
+    case OR_U8:     VM_DEBUG_2("i:OR_U8");           or_u8(); break;
+    case OR_I16:    VM_DEBUG_2("i:OR_I16");          or_i16(); break;
+    case OR_U16:    VM_DEBUG_2("i:OR_U16");          or_u16(); break;
+    case OR_I32:    VM_DEBUG_2("i:OR_I32");          or_i32(); break;
+    case OR_U32:    VM_DEBUG_2("i:OR_U32");          or_u32(); break;
+    case OR_I64:    VM_DEBUG_2("i:OR_I64");          or_i64(); break;
+    case OR_U64:    VM_DEBUG_2("i:OR_U64");          or_u64(); break;
+
+    case XOR_I8:    VM_DEBUG_2("i:XOR_I8");          xor_i8(); break;
+    case XOR_U8:    VM_DEBUG_2("i:XOR_U8");          xor_u8(); break;
+    case XOR_I16:   VM_DEBUG_2("i:XOR_I16");         xor_i16(); break;
+    case XOR_U16:   VM_DEBUG_2("i:XOR_U16");         xor_u16(); break;
+    case XOR_I32:   VM_DEBUG_2("i:XOR_I32");         xor_i32(); break;
+    case XOR_U32:   VM_DEBUG_2("i:XOR_U32");         xor_u32(); break;
+    case XOR_I64:   VM_DEBUG_2("i:XOR_I64");         xor_i64(); break;
+    case XOR_U64:   VM_DEBUG_2("i:XOR_U64");         xor_u64(); break;
+
+    case NOT_I8:    VM_DEBUG_2("i:NOT_I8");          not_i8(); break;
+    case NOT_U8:    VM_DEBUG_2("i:NOT_U8");          not_u8(); break;
+    case NOT_I16:   VM_DEBUG_2("i:NOT_I16");         not_i16(); break;
+    case NOT_U16:   VM_DEBUG_2("i:NOT_U16");         not_u16(); break;
+    case NOT_I32:   VM_DEBUG_2("i:NOT_I32");         not_i32(); break;
+    case NOT_U32:   VM_DEBUG_2("i:NOT_U32");         not_u32(); break;
+    case NOT_I64:   VM_DEBUG_2("i:NOT_I64");         not_i64(); break;
+    case NOT_U64:   VM_DEBUG_2("i:NOT_U64");         not_u64(); break;
+
+    case SHL_I8:    VM_DEBUG_2("i:SHL_I8");          shl_i8(); break;
+    case SHL_U8:    VM_DEBUG_2("i:SHL_U8");          shl_u8(); break;
+    case SHL_I16:   VM_DEBUG_2("i:SHL_I16");         shl_i16(); break;
+    case SHL_U16:   VM_DEBUG_2("i:SHL_U16");         shl_u16(); break;
+    case SHL_I32:   VM_DEBUG_2("i:SHL_I32");         shl_i32(); break;
+    case SHL_U32:   VM_DEBUG_2("i:SHL_U32");         shl_u32(); break;
+    case SHL_I64:   VM_DEBUG_2("i:SHL_I64");         shl_i64(); break;
+    case SHL_U64:   VM_DEBUG_2("i:SHL_U64");         shl_u64(); break;
+
+    case SHR_I8:    VM_DEBUG_2("i:SHR_I8");          shr_i8(); break;
+    case SHR_U8:    VM_DEBUG_2("i:SHR_U8");          shr_u8(); break;
+    case SHR_I16:   VM_DEBUG_2("i:SHR_I16");         shr_i16(); break;
+    case SHR_U16:   VM_DEBUG_2("i:SHR_U16");         shr_u16(); break;
+    case SHR_I32:   VM_DEBUG_2("i:SHR_I32");         shr_i32(); break;
+    case SHR_U32:   VM_DEBUG_2("i:SHR_U32");         shr_u32(); break;
+    case SHR_I64:   VM_DEBUG_2("i:SHR_I64");         shr_i64(); break;
+    case SHR_U64:   VM_DEBUG_2("i:SHR_U64");         shr_u64(); break;
+
+    case SAR_I8:    VM_DEBUG_2("i:SAR_I8");          sar_i8(); break;
+    case SAR_U8:    VM_DEBUG_2("i:SAR_U8");          sar_u8(); break;
+    case SAR_I16:   VM_DEBUG_2("i:SAR_I16");         sar_i16(); break;
+    case SAR_U16:   VM_DEBUG_2("i:SAR_U16");         sar_u16(); break;
+    case SAR_I32:   VM_DEBUG_2("i:SAR_I32");         sar_i32(); break;
+    case SAR_U32:   VM_DEBUG_2("i:SAR_U32");         sar_u32(); break;
+    case SAR_I64:   VM_DEBUG_2("i:SAR_I64");         sar_i64(); break;
+    case SAR_U64:   VM_DEBUG_2("i:SAR_U64");         sar_u64(); break;
+
+    case ROTL_I8:   VM_DEBUG_2("i:ROTL_I8");         rotl_i8(); break;
+    case ROTL_U8:   VM_DEBUG_2("i:ROTL_U8");         rotl_u8(); break;
+    case ROTL_I16:  VM_DEBUG_2("i:ROTL_I16");        rotl_i16(); break;
+    case ROTL_U16:  VM_DEBUG_2("i:ROTL_U16");        rotl_u16(); break;
+    case ROTL_I32:  VM_DEBUG_2("i:ROTL_I32");        rotl_i32(); break;
+    case ROTL_U32:  VM_DEBUG_2("i:ROTL_U32");        rotl_u32(); break;
+    case ROTL_I64:  VM_DEBUG_2("i:ROTL_I64");        rotl_i64(); break;
+    case ROTL_U64:  VM_DEBUG_2("i:ROTL_U64");        rotl_u64(); break;
+
+    case ROTR_I8:   VM_DEBUG_2("i:ROTR_I8");         rotr_i8(); break;
+    case ROTR_U8:   VM_DEBUG_2("i:ROTR_U8");         rotr_u8(); break;
+    case ROTR_I16:  VM_DEBUG_2("i:ROTR_I16");        rotr_i16(); break;
+    case ROTR_U16:  VM_DEBUG_2("i:ROTR_U16");        rotr_u16(); break;
+    case ROTR_I32:  VM_DEBUG_2("i:ROTR_I32");        rotr_i32(); break;
+    case ROTR_U32:  VM_DEBUG_2("i:ROTR_U32");        rotr_u32(); break;
+    case ROTR_I64:  VM_DEBUG_2("i:ROTR_I64");        rotr_i64(); break;
+    case ROTR_U64:  VM_DEBUG_2("i:ROTR_U64");        rotr_u64(); break;
+
+    case POPCNT_I8: VM_DEBUG_2("i:POPCNT_I8");       popcnt_i8(); break;
+    case POPCNT_U8: VM_DEBUG_2("i:POPCNT_U8");       popcnt_u8(); break;
+    case POPCNT_I16:VM_DEBUG_2("i:POPCNT_I16");      popcnt_i16(); break;
+    case POPCNT_U16:VM_DEBUG_2("i:POPCNT_U16");      popcnt_u16(); break;
+    case POPCNT_I32:VM_DEBUG_2("i:POPCNT_I32");      popcnt_i32(); break;
+    case POPCNT_U32:VM_DEBUG_2("i:POPCNT_U32");      popcnt_u32(); break;
+    case POPCNT_I64:VM_DEBUG_2("i:POPCNT_I64");      popcnt_i64(); break;
+    case POPCNT_U64:VM_DEBUG_2("i:POPCNT_U64");      popcnt_u64(); break;
+
+    case CLZ_I8:    VM_DEBUG_2("i:CLZ_I8");          clz_i8(); break;
+    case CLZ_U8:    VM_DEBUG_2("i:CLZ_U8");          clz_u8(); break;
+    case CLZ_I16:   VM_DEBUG_2("i:CLZ_I16");         clz_i16(); break;
+    case CLZ_U16:   VM_DEBUG_2("i:CLZ_U16");         clz_u16(); break;
+    case CLZ_I32:   VM_DEBUG_2("i:CLZ_I32");         clz_i32(); break;
+    case CLZ_U32:   VM_DEBUG_2("i:CLZ_U32");         clz_u32(); break;
+    case CLZ_I64:   VM_DEBUG_2("i:CLZ_I64");         clz_i64(); break;
+    case CLZ_U64:   VM_DEBUG_2("i:CLZ_U64");         clz_u64(); break;
+
+    case CTZ_I8:    VM_DEBUG_2("i:CTZ_I8");          ctz_i8(); break;
+    case CTZ_U8:    VM_DEBUG_2("i:CTZ_U8");          ctz_u8(); break;
+    case CTZ_I16:   VM_DEBUG_2("i:CTZ_I16");         ctz_i16(); break;
+    case CTZ_U16:   VM_DEBUG_2("i:CTZ_U16");         ctz_u16(); break;
+    case CTZ_I32:   VM_DEBUG_2("i:CTZ_I32");         ctz_i32(); break;
+    case CTZ_U32:   VM_DEBUG_2("i:CTZ_U32");         ctz_u32(); break;
+    case CTZ_I64:   VM_DEBUG_2("i:CTZ_I64");         ctz_i64(); break;
+    case CTZ_U64:   VM_DEBUG_2("i:CTZ_U64");         ctz_u64(); break;
+
+    case PUSH_I128: VM_DEBUG_2("i:PUSH_I128");       push_i128(load<int128_t>(read(16))); break;
+    case PUSH_U128: VM_DEBUG_2("i:PUSH_U128");       push_u128(load<uint128_t>(read(16))); break;
+    case PUSH_F128: VM_DEBUG_2("i:PUSH_F128");       push_f128(load<float128_t>(read(16))); break;
+
+    case POPL_I128: VM_DEBUG_2("i:POPL_I128");       popl_i128(&scope, load<uint8_t>(read(1))); break;
+    case POPL_U128: VM_DEBUG_2("i:POPL_U128");       popl_u128(&scope, load<uint8_t>(read(1))); break;
+    case POPL_F128: VM_DEBUG_2("i:POPL_F128");       popl_f128(&scope, load<uint8_t>(read(1))); break;
+
+    case PUSHL_I128:VM_DEBUG_2("i:PUSHL_I128");      pushl_i128(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_U128:VM_DEBUG_2("i:PUSHL_U128");      pushl_u128(&scope, load<uint8_t>(read(1))); break;
+    case PUSHL_F128:VM_DEBUG_2("i:PUSHL_F128");      pushl_f128(&scope, load<uint8_t>(read(1))); break;
+
+    case SETL_I128: VM_DEBUG_2("i:SETL_I128");       { uint8_t index = load<uint8_t>(read(1)); int128_t value = load<int128_t>(read(16)); setl_i128(value, &scope, index); break; }
+    case SETL_U128: VM_DEBUG_2("i:SETL_U128");       { uint8_t index = load<uint8_t>(read(1)); uint128_t value = load<uint128_t>(read(16)); setl_u128(value, &scope, index); break; }
+    case SETL_F128: VM_DEBUG_2("i:SETL_F128");       { uint8_t index = load<uint8_t>(read(1)); float128_t value = load<float128_t>(read(16)); setl_f128(value, &scope, index); break; }
+
+    case ADD_I128:  VM_DEBUG_2("i:ADD_I128");        add_i128(); break;
+    case ADD_U128:  VM_DEBUG_2("i:ADD_U128");        add_u128(); break;
+    case ADD_F128:  VM_DEBUG_2("i:ADD_F128");        add_f128(); break;
+
+    case SUB_I128:  VM_DEBUG_2("i:SUB_I128");        sub_i128(); break;
+    case SUB_U128:  VM_DEBUG_2("i:SUB_U128");        sub_u128(); break;
+    case SUB_F128:  VM_DEBUG_2("i:SUB_F128");        sub_f128(); break;
+
+    case MUL_I128:  VM_DEBUG_2("i:MUL_I128");        mul_i128(); break;
+    case MUL_U128:  VM_DEBUG_2("i:MUL_U128");        mul_u128(); break;
+    case MUL_F128:  VM_DEBUG_2("i:MUL_F128");        mul_f128(); break;
+
+    case DIV_I128:  VM_DEBUG_2("i:DIV_I128");        div_i128(); break;
+    case DIV_U128:  VM_DEBUG_2("i:DIV_U128");        div_u128(); break;
+    case DIV_F128:  VM_DEBUG_2("i:DIV_F128");        div_f128(); break;
+
+    case REM_I128:  VM_DEBUG_2("i:REM_I128");        rem_i128(); break;
+    case REM_U128:  VM_DEBUG_2("i:REM_U128");        rem_u128(); break;
+    case REM_F128:  VM_DEBUG_2("i:REM_F128");        rem_f128(); break;
+
+    case CMP_I128:  VM_DEBUG_2("i:CMP_I128");        cmp_i128(); break;
+    case CMP_U128:  VM_DEBUG_2("i:CMP_U128");        cmp_u128(); break;
+    case CMP_F128:  VM_DEBUG_2("i:CMP_F128");        cmp_f128(); break;
+
+    case SQRT_F32:  VM_DEBUG_2("i:SQRT_F32");        sqrt_f32(); break;
+    case SQRT_F64:  VM_DEBUG_2("i:SQRT_F64");        sqrt_f64(); break;
+
+    case FLOOR_F32: VM_DEBUG_2("i:FLOOR_F32");       floor_f32(); break;
+    case FLOOR_F64: VM_DEBUG_2("i:FLOOR_F64");       floor_f64(); break;
+
+    case CEIL_F32:  VM_DEBUG_2("i:CEIL_F32");        ceil_f32(); break;
+    case CEIL_F64:  VM_DEBUG_2("i:CEIL_F64");        ceil_f64(); break;
+
+    case ROUND_F32: VM_DEBUG_2("i:ROUND_F32");       round_f32(); break;
+    case ROUND_F64: VM_DEBUG_2("i:ROUND_F64");       round_f64(); break;
+
+    case TRUNC_F32: VM_DEBUG_2("i:TRUNC_F32");       trunc_f32(); break;
+    case TRUNC_F64: VM_DEBUG_2("i:TRUNC_F64");       trunc_f64(); break;
+
+    case FMA_F32:   VM_DEBUG_2("i:FMA_F32");         fma_f32(); break;
+    case FMA_F64:   VM_DEBUG_2("i:FMA_F64");         fma_f64(); break;
+
+    case MIN_I8:    VM_DEBUG_2("i:MIN_I8");          min_i8(); break;
+    case MIN_U8:    VM_DEBUG_2("i:MIN_U8");          min_u8(); break;
+    case MIN_I16:   VM_DEBUG_2("i:MIN_I16");         min_i16(); break;
+    case MIN_U16:   VM_DEBUG_2("i:MIN_U16");         min_u16(); break;
+    case MIN_I32:   VM_DEBUG_2("i:MIN_I32");         min_i32(); break;
+    case MIN_U32:   VM_DEBUG_2("i:MIN_U32");         min_u32(); break;
+    case MIN_F32:   VM_DEBUG_2("i:MIN_F32");         min_f32(); break;
+    case MIN_I64:   VM_DEBUG_2("i:MIN_I64");         min_i64(); break;
+    case MIN_U64:   VM_DEBUG_2("i:MIN_U64");         min_u64(); break;
+    case MIN_F64:   VM_DEBUG_2("i:MIN_F64");         min_f64(); break;
+
+    case MAX_I8:    VM_DEBUG_2("i:MAX_I8");          max_i8(); break;
+    case MAX_U8:    VM_DEBUG_2("i:MAX_U8");          max_u8(); break;
+    case MAX_I16:   VM_DEBUG_2("i:MAX_I16");         max_i16(); break;
+    case MAX_U16:   VM_DEBUG_2("i:MAX_U16");         max_u16(); break;
+    case MAX_I32:   VM_DEBUG_2("i:MAX_I32");         max_i32(); break;
+    case MAX_U32:   VM_DEBUG_2("i:MAX_U32");         max_u32(); break;
+    case MAX_F32:   VM_DEBUG_2("i:MAX_F32");         max_f32(); break;
+    case MAX_I64:   VM_DEBUG_2("i:MAX_I64");         max_i64(); break;
+    case MAX_U64:   VM_DEBUG_2("i:MAX_U64");         max_u64(); break;
+    case MAX_F64:   VM_DEBUG_2("i:MAX_F64");         max_f64(); break;
+
+    case CVT_I8_I8: VM_DEBUG_2("i:CVT_I8_I8");       cvt_i8_i8(); break;
+    case CVT_I8_U8: VM_DEBUG_2("i:CVT_I8_U8");       cvt_i8_u8(); break;
+    case CVT_I8_I16:VM_DEBUG_2("i:CVT_I8_I16");      cvt_i8_i16(); break;
+    case CVT_I8_U16:VM_DEBUG_2("i:CVT_I8_U16");      cvt_i8_u16(); break;
+    case CVT_I8_I32:VM_DEBUG_2("i:CVT_I8_I32");      cvt_i8_i32(); break;
+    case CVT_I8_U32:VM_DEBUG_2("i:CVT_I8_U32");      cvt_i8_u32(); break;
+    case CVT_I8_F32:VM_DEBUG_2("i:CVT_I8_F32");      cvt_i8_f32(); break;
+    case CVT_I8_I64:VM_DEBUG_2("i:CVT_I8_I64");      cvt_i8_i64(); break;
+    case CVT_I8_U64:VM_DEBUG_2("i:CVT_I8_U64");      cvt_i8_u64(); break;
+    case CVT_I8_F64:VM_DEBUG_2("i:CVT_I8_F64");      cvt_i8_f64(); break;
+
+    case CVT_U8_I8: VM_DEBUG_2("i:CVT_U8_I8");       cvt_u8_i8(); break;
+    case CVT_U8_U8: VM_DEBUG_2("i:CVT_U8_U8");       cvt_u8_u8(); break;
+    case CVT_U8_I16:VM_DEBUG_2("i:CVT_U8_I16");      cvt_u8_i16(); break;
+    case CVT_U8_U16:VM_DEBUG_2("i:CVT_U8_U16");      cvt_u8_u16(); break;
+    case CVT_U8_I32:VM_DEBUG_2("i:CVT_U8_I32");      cvt_u8_i32(); break;
+    case CVT_U8_U32:VM_DEBUG_2("i:CVT_U8_U32");      cvt_u8_u32(); break;
+    case CVT_U8_F32:VM_DEBUG_2("i:CVT_U8_F32");      cvt_u8_f32(); break;
+    case CVT_U8_I64:VM_DEBUG_2("i:CVT_U8_I64");      cvt_u8_i64(); break;
+    case CVT_U8_U64:VM_DEBUG_2("i:CVT_U8_U64");      cvt_u8_u64(); break;
+    case CVT_U8_F64:VM_DEBUG_2("i:CVT_U8_F64");      cvt_u8_f64(); break;
+
+    case CVT_I16_I8:VM_DEBUG_2("i:CVT_I16_I8");      cvt_i16_i8(); break;
+    case CVT_I16_U8:VM_DEBUG_2("i:CVT_I16_U8");      cvt_i16_u8(); break;
+    case CVT_I16_I16:VM_DEBUG_2("i:CVT_I16_I16"); cvt_i16_i16(); break;
+    case CVT_I16_U16:VM_DEBUG_2("i:CVT_I16_U16"); cvt_i16_u16(); break;
+    case CVT_I16_I32:VM_DEBUG_2("i:CVT_I16_I32"); cvt_i16_i32(); break;
+    case CVT_I16_U32:VM_DEBUG_2("i:CVT_I16_U32"); cvt_i16_u32(); break;
+    case CVT_I16_F32:VM_DEBUG_2("i:CVT_I16_F32"); cvt_i16_f32(); break;
+    case CVT_I16_I64:VM_DEBUG_2("i:CVT_I16_I64"); cvt_i16_i64(); break;
+    case CVT_I16_U64:VM_DEBUG_2("i:CVT_I16_U64"); cvt_i16_u64(); break;
+    case CVT_I16_F64:VM_DEBUG_2("i:CVT_I16_F64"); cvt_i16_f64(); break;
+
+    case CVT_U16_I8:VM_DEBUG_2("i:CVT_U16_I8");      cvt_u16_i8(); break;
+    case CVT_U16_U8:VM_DEBUG_2("i:CVT_U16_U8");      cvt_u16_u8(); break;
+    case CVT_U16_I16:VM_DEBUG_2("i:CVT_U16_I16"); cvt_u16_i16(); break;
+    case CVT_U16_U16:VM_DEBUG_2("i:CVT_U16_U16"); cvt_u16_u16(); break;
+    case CVT_U16_I32:VM_DEBUG_2("i:CVT_U16_I32"); cvt_u16_i32(); break;
+    case CVT_U16_U32:VM_DEBUG_2("i:CVT_U16_U32"); cvt_u16_u32(); break;
+    case CVT_U16_F32:VM_DEBUG_2("i:CVT_U16_F32"); cvt_u16_f32(); break;
+    case CVT_U16_I64:VM_DEBUG_2("i:CVT_U16_I64"); cvt_u16_i64(); break;
+    case CVT_U16_U64:VM_DEBUG_2("i:CVT_U16_U64"); cvt_u16_u64(); break;
+    case CVT_U16_F64:VM_DEBUG_2("i:CVT_U16_F64"); cvt_u16_f64(); break;
+
+    case CVT_I32_I8:VM_DEBUG_2("i:CVT_I32_I8");      cvt_i32_i8(); break;
+    case CVT_I32_U8:VM_DEBUG_2("i:CVT_I32_U8");      cvt_i32_u8(); break;
+    case CVT_I32_I16:VM_DEBUG_2("i:CVT_I32_I16"); cvt_i32_i16(); break;
+    case CVT_I32_U16:VM_DEBUG_2("i:CVT_I32_U16"); cvt_i32_u16(); break;
+    case CVT_I32_I32:VM_DEBUG_2("i:CVT_I32_I32"); cvt_i32_i32(); break;
+    case CVT_I32_U32:VM_DEBUG_2("i:CVT_I32_U32"); cvt_i32_u32(); break;
+    case CVT_I32_F32:VM_DEBUG_2("i:CVT_I32_F32"); cvt_i32_f32(); break;
+    case CVT_I32_I64:VM_DEBUG_2("i:CVT_I32_I64"); cvt_i32_i64(); break;
+    case CVT_I32_U64:VM_DEBUG_2("i:CVT_I32_U64"); cvt_i32_u64(); break;
+    case CVT_I32_F64:VM_DEBUG_2("i:CVT_I32_F64"); cvt_i32_f64(); break;
+
+    case CVT_U32_I8:VM_DEBUG_2("i:CVT_U32_I8");      cvt_u32_i8(); break;
+    case CVT_U32_U8:VM_DEBUG_2("i:CVT_U32_U8");      cvt_u32_u8(); break;
+    case CVT_U32_I16:VM_DEBUG_2("i:CVT_U32_I16"); cvt_u32_i16(); break;
+    case CVT_U32_U16:VM_DEBUG_2("i:CVT_U32_U16"); cvt_u32_u16(); break;
+    case CVT_U32_I32:VM_DEBUG_2("i:CVT_U32_I32"); cvt_u32_i32(); break;
+    case CVT_U32_U32:VM_DEBUG_2("i:CVT_U32_U32"); cvt_u32_u32(); break;
+    case CVT_U32_F32:VM_DEBUG_2("i:CVT_U32_F32"); cvt_u32_f32(); break;
+    case CVT_U32_I64:VM_DEBUG_2("i:CVT_U32_I64"); cvt_u32_i64(); break;
+    case CVT_U32_U64:VM_DEBUG_2("i:CVT_U32_U64"); cvt_u32_u64(); break;
+    case CVT_U32_F64:VM_DEBUG_2("i:CVT_U32_F64"); cvt_u32_f64(); break;
+
+    case CVT_F32_I8:VM_DEBUG_2("i:CVT_F32_I8");      cvt_f32_i8(); break;
+    case CVT_F32_U8:VM_DEBUG_2("i:CVT_F32_U8");      cvt_f32_u8(); break;
+    case CVT_F32_I16:VM_DEBUG_2("i:CVT_F32_I16"); cvt_f32_i16(); break;
+    case CVT_F32_U16:VM_DEBUG_2("i:CVT_F32_U16"); cvt_f32_u16(); break;
+    case CVT_F32_I32:VM_DEBUG_2("i:CVT_F32_I32"); cvt_f32_i32(); break;
+    case CVT_F32_U32:VM_DEBUG_2("i:CVT_F32_U32"); cvt_f32_u32(); break;
+    case CVT_F32_F32:VM_DEBUG_2("i:CVT_F32_F32"); cvt_f32_f32(); break;
+    case CVT_F32_I64:VM_DEBUG_2("i:CVT_F32_I64"); cvt_f32_i64(); break;
+    case CVT_F32_U64:VM_DEBUG_2("i:CVT_F32_U64"); cvt_f32_u64(); break;
+    case CVT_F32_F64:VM_DEBUG_2("i:CVT_F32_F64"); cvt_f32_f64(); break;
+
+    case CVT_I64_I8:VM_DEBUG_2("i:CVT_I64_I8");      cvt_i64_i8(); break;
+    case CVT_I64_U8:VM_DEBUG_2("i:CVT_I64_U8");      cvt_i64_u8(); break;
+    case CVT_I64_I16:VM_DEBUG_2("i:CVT_I64_I16"); cvt_i64_i16(); break;
+    case CVT_I64_U16:VM_DEBUG_2("i:CVT_I64_U16"); cvt_i64_u16(); break;
+    case CVT_I64_I32:VM_DEBUG_2("i:CVT_I64_I32"); cvt_i64_i32(); break;
+    case CVT_I64_U32:VM_DEBUG_2("i:CVT_I64_U32"); cvt_i64_u32(); break;
+    case CVT_I64_F32:VM_DEBUG_2("i:CVT_I64_F32"); cvt_i64_f32(); break;
+    case CVT_I64_I64:VM_DEBUG_2("i:CVT_I64_I64"); cvt_i64_i64(); break;
+    case CVT_I64_U64:VM_DEBUG_2("i:CVT_I64_U64"); cvt_i64_u64(); break;
+    case CVT_I64_F64:VM_DEBUG_2("i:CVT_I64_F64"); cvt_i64_f64(); break;
+
+    case CVT_U64_I8:VM_DEBUG_2("i:CVT_U64_I8");      cvt_u64_i8(); break;
+    case CVT_U64_U8:VM_DEBUG_2("i:CVT_U64_U8");      cvt_u64_u8(); break;
+    case CVT_U64_I16:VM_DEBUG_2("i:CVT_U64_I16"); cvt_u64_i16(); break;
+    case CVT_U64_U16:VM_DEBUG_2("i:CVT_U64_U16"); cvt_u64_u16(); break;
+    case CVT_U64_I32:VM_DEBUG_2("i:CVT_U64_I32"); cvt_u64_i32(); break;
+    case CVT_U64_U32:VM_DEBUG_2("i:CVT_U64_U32"); cvt_u64_u32(); break;
+    case CVT_U64_F32:VM_DEBUG_2("i:CVT_U64_F32"); cvt_u64_f32(); break;
+    case CVT_U64_I64:VM_DEBUG_2("i:CVT_U64_I64"); cvt_u64_i64(); break;
+    case CVT_U64_U64:VM_DEBUG_2("i:CVT_U64_U64"); cvt_u64_u64(); break;
+    case CVT_U64_F64:VM_DEBUG_2("i:CVT_U64_F64"); cvt_u64_f64(); break;
+
+    case CVT_F64_I8:VM_DEBUG_2("i:CVT_F64_I8");      cvt_f64_i8(); break;
+    case CVT_F64_U8:VM_DEBUG_2("i:CVT_F64_U8");      cvt_f64_u8(); break;
+    case CVT_F64_I16:VM_DEBUG_2("i:CVT_F64_I16"); cvt_f64_i16(); break;
+    case CVT_F64_U16:VM_DEBUG_2("i:CVT_F64_U16"); cvt_f64_u16(); break;
+    case CVT_F64_I32:VM_DEBUG_2("i:CVT_F64_I32"); cvt_f64_i32(); break;
+    case CVT_F64_U32:VM_DEBUG_2("i:CVT_F64_U32"); cvt_f64_u32(); break;
+    case CVT_F64_F32:VM_DEBUG_2("i:CVT_F64_F32"); cvt_f64_f32(); break;
+    case CVT_F64_I64:VM_DEBUG_2("i:CVT_F64_I64"); cvt_f64_i64(); break;
+    case CVT_F64_U64:VM_DEBUG_2("i:CVT_F64_U64"); cvt_f64_u64(); break;
+    case CVT_F64_F64:VM_DEBUG_2("i:CVT_F64_F64"); cvt_f64_f64(); break;
+
+    case LOOP_I8:   VM_DEBUG_2("i:LOOP_I8");         { uint8_t index = load<uint8_t>(read(1)); int8_t limit = load<int8_t>(read(1)); loop_i8(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_U8:   VM_DEBUG_2("i:LOOP_U8");         { uint8_t index = load<uint8_t>(read(1)); uint8_t limit = load<uint8_t>(read(1)); loop_u8(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_I16:  VM_DEBUG_2("i:LOOP_I16");        { uint8_t index = load<uint8_t>(read(1)); int16_t limit = load<int16_t>(read(2)); loop_i16(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_U16:  VM_DEBUG_2("i:LOOP_U16");        { uint8_t index = load<uint8_t>(read(1)); uint16_t limit = load<uint16_t>(read(2)); loop_u16(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_I32:  VM_DEBUG_2("i:LOOP_I32");        { uint8_t index = load<uint8_t>(read(1)); int32_t limit = load<int32_t>(read(4)); loop_i32(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_U32:  VM_DEBUG_2("i:LOOP_U32");        { uint8_t index = load<uint8_t>(read(1)); uint32_t limit = load<uint32_t>(read(4)); loop_u32(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_F32:  VM_DEBUG_2("i:LOOP_F32");        { uint8_t index = load<uint8_t>(read(1)); float limit = load<float>(read(4)); loop_f32(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_I64:  VM_DEBUG_2("i:LOOP_I64");        { uint8_t index = load<uint8_t>(read(1)); int64_t limit = load<int64_t>(read(8)); loop_i64(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_U64:  VM_DEBUG_2("i:LOOP_U64");        { uint8_t index = load<uint8_t>(read(1)); uint64_t limit = load<uint64_t>(read(8)); loop_u64(limit, &scope, index, load<size_t>(read(8))); break; }
+    case LOOP_F64:  VM_DEBUG_2("i:LOOP_F64");        { uint8_t index = load<uint8_t>(read(1)); double limit = load<double>(read(8)); loop_f64(limit, &scope, index, load<size_t>(read(8))); break; }
+
+    case DJNZ_I8:   VM_DEBUG_2("i:DJNZ_I8");         { uint8_t index = load<uint8_t>(read(1)); djnz_i8(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_U8:   VM_DEBUG_2("i:DJNZ_U8");         { uint8_t index = load<uint8_t>(read(1)); djnz_u8(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_I16:  VM_DEBUG_2("i:DJNZ_I16");        { uint8_t index = load<uint8_t>(read(1)); djnz_i16(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_U16:  VM_DEBUG_2("i:DJNZ_U16");        { uint8_t index = load<uint8_t>(read(1)); djnz_u16(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_I32:  VM_DEBUG_2("i:DJNZ_I32");        { uint8_t index = load<uint8_t>(read(1)); djnz_i32(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_U32:  VM_DEBUG_2("i:DJNZ_U32");        { uint8_t index = load<uint8_t>(read(1)); djnz_u32(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_F32:  VM_DEBUG_2("i:DJNZ_F32");        { uint8_t index = load<uint8_t>(read(1)); djnz_f32(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_I64:  VM_DEBUG_2("i:DJNZ_I64");        { uint8_t index = load<uint8_t>(read(1)); djnz_i64(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_U64:  VM_DEBUG_2("i:DJNZ_U64");        { uint8_t index = load<uint8_t>(read(1)); djnz_u64(&scope, index, load<size_t>(read(8))); break; }
+    case DJNZ_F64:  VM_DEBUG_2("i:DJNZ_F64");        { uint8_t index = load<uint8_t>(read(1)); djnz_f64(&scope, index, load<size_t>(read(8))); break; }
+
+    case ANEW_I8:   VM_DEBUG_2("i:ANEW_I8");         anew_i8(); break;
+    case ANEW_U8:   VM_DEBUG_2("i:ANEW_U8");         anew_u8(); break;
+    case ANEW_BOOL: VM_DEBUG_2("i:ANEW_BOOL");       anew_bool(); break;
+    case ANEW_I16:  VM_DEBUG_2("i:ANEW_I16");        anew_i16(); break;
+    case ANEW_U16:  VM_DEBUG_2("i:ANEW_U16");        anew_u16(); break;
+    case ANEW_I32:  VM_DEBUG_2("i:ANEW_I32");        anew_i32(); break;
+    case ANEW_U32:  VM_DEBUG_2("i:ANEW_U32");        anew_u32(); break;
+    case ANEW_F32:  VM_DEBUG_2("i:ANEW_F32");        anew_f32(); break;
+    case ANEW_I64:  VM_DEBUG_2("i:ANEW_I64");        anew_i64(); break;
+    case ANEW_U64:  VM_DEBUG_2("i:ANEW_U64");        anew_u64(); break;
+    case ANEW_F64:  VM_DEBUG_2("i:ANEW_F64");        anew_f64(); break;
+    case ALEN:      VM_DEBUG_2("i:ALEN");            alen(); break;
+    case ASLICE:    VM_DEBUG_2("i:ASLICE");          aslice(); break;
+
+    case ALOAD_I8:  VM_DEBUG_2("i:ALOAD_I8");        aload_i8(); break;
+    case ALOAD_U8:  VM_DEBUG_2("i:ALOAD_U8");        aload_u8(); break;
+    case ALOAD_BOOL: VM_DEBUG_2("i:ALOAD_BOOL");     aload_bool(); break;
+    case ALOAD_I16: VM_DEBUG_2("i:ALOAD_I16");       aload_i16(); break;
+    case ALOAD_U16: VM_DEBUG_2("i:ALOAD_U16");       aload_u16(); break;
+    case ALOAD_I32: VM_DEBUG_2("i:ALOAD_I32");       aload_i32(); break;
+    case ALOAD_U32: VM_DEBUG_2("i:ALOAD_U32");       aload_u32(); break;
+    case ALOAD_F32: VM_DEBUG_2("i:ALOAD_F32");       aload_f32(); break;
+    case ALOAD_I64: VM_DEBUG_2("i:ALOAD_I64");       aload_i64(); break;
+    case ALOAD_U64: VM_DEBUG_2("i:ALOAD_U64");       aload_u64(); break;
+    case ALOAD_F64: VM_DEBUG_2("i:ALOAD_F64");       aload_f64(); break;
+
+    case ASTORE_I8: VM_DEBUG_2("i:ASTORE_I8");       astore_i8(); break;
+    case ASTORE_U8: VM_DEBUG_2("i:ASTORE_U8");       astore_u8(); break;
+    case ASTORE_BOOL: VM_DEBUG_2("i:ASTORE_BOOL");   astore_bool(); break;
+    case ASTORE_I16: VM_DEBUG_2("i:ASTORE_I16");     astore_i16(); break;
+    case ASTORE_U16: VM_DEBUG_2("i:ASTORE_U16");     astore_u16(); break;
+    case ASTORE_I32: VM_DEBUG_2("i:ASTORE_I32");     astore_i32(); break;
+    case ASTORE_U32: VM_DEBUG_2("i:ASTORE_U32");     astore_u32(); break;
+    case ASTORE_F32: VM_DEBUG_2("i:ASTORE_F32");     astore_f32(); break;
+    case ASTORE_I64: VM_DEBUG_2("i:ASTORE_I64");     astore_i64(); break;
+    case ASTORE_U64: VM_DEBUG_2("i:ASTORE_U64");     astore_u64(); break;
+    case ASTORE_F64: VM_DEBUG_2("i:ASTORE_F64");     astore_f64(); break;
+
+    case ALOADL_I8: VM_DEBUG_2("i:ALOADL_I8");       { uint8_t array = load<uint8_t>(read(1)); aloadl_i8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_U8: VM_DEBUG_2("i:ALOADL_U8");       { uint8_t array = load<uint8_t>(read(1)); aloadl_u8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_BOOL: VM_DEBUG_2("i:ALOADL_BOOL");   { uint8_t array = load<uint8_t>(read(1)); aloadl_bool(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_I16: VM_DEBUG_2("i:ALOADL_I16");     { uint8_t array = load<uint8_t>(read(1)); aloadl_i16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_U16: VM_DEBUG_2("i:ALOADL_U16");     { uint8_t array = load<uint8_t>(read(1)); aloadl_u16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_I32: VM_DEBUG_2("i:ALOADL_I32");     { uint8_t array = load<uint8_t>(read(1)); aloadl_i32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_U32: VM_DEBUG_2("i:ALOADL_U32");     { uint8_t array = load<uint8_t>(read(1)); aloadl_u32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_F32: VM_DEBUG_2("i:ALOADL_F32");     { uint8_t array = load<uint8_t>(read(1)); aloadl_f32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_I64: VM_DEBUG_2("i:ALOADL_I64");     { uint8_t array = load<uint8_t>(read(1)); aloadl_i64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_U64: VM_DEBUG_2("i:ALOADL_U64");     { uint8_t array = load<uint8_t>(read(1)); aloadl_u64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADL_F64: VM_DEBUG_2("i:ALOADL_F64");     { uint8_t array = load<uint8_t>(read(1)); aloadl_f64(&scope, array, load<uint8_t>(read(1))); break; }
+
+    case ASTOREL_I8: VM_DEBUG_2("i:ASTOREL_I8");     { uint8_t array = load<uint8_t>(read(1)); astorel_i8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_U8: VM_DEBUG_2("i:ASTOREL_U8");     { uint8_t array = load<uint8_t>(read(1)); astorel_u8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_BOOL: VM_DEBUG_2("i:ASTOREL_BOOL"); { uint8_t array = load<uint8_t>(read(1)); astorel_bool(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_I16: VM_DEBUG_2("i:ASTOREL_I16");   { uint8_t array = load<uint8_t>(read(1)); astorel_i16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_U16: VM_DEBUG_2("i:ASTOREL_U16");   { uint8_t array = load<uint8_t>(read(1)); astorel_u16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_I32: VM_DEBUG_2("i:ASTOREL_I32");   { uint8_t array = load<uint8_t>(read(1)); astorel_i32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_U32: VM_DEBUG_2("i:ASTOREL_U32");   { uint8_t array = load<uint8_t>(read(1)); astorel_u32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_F32: VM_DEBUG_2("i:ASTOREL_F32");   { uint8_t array = load<uint8_t>(read(1)); astorel_f32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_I64: VM_DEBUG_2("i:ASTOREL_I64");   { uint8_t array = load<uint8_t>(read(1)); astorel_i64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_U64: VM_DEBUG_2("i:ASTOREL_U64");   { uint8_t array = load<uint8_t>(read(1)); astorel_u64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTOREL_F64: VM_DEBUG_2("i:ASTOREL_F64");   { uint8_t array = load<uint8_t>(read(1)); astorel_f64(&scope, array, load<uint8_t>(read(1))); break; }
+
+    case ALOADLU_I8: VM_DEBUG_2("i:ALOADLU_I8");     { uint8_t array = load<uint8_t>(read(1)); aloadlu_i8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_U8: VM_DEBUG_2("i:ALOADLU_U8");     { uint8_t array = load<uint8_t>(read(1)); aloadlu_u8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_BOOL: VM_DEBUG_2("i:ALOADLU_BOOL"); { uint8_t array = load<uint8_t>(read(1)); aloadlu_bool(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_I16: VM_DEBUG_2("i:ALOADLU_I16");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_i16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_U16: VM_DEBUG_2("i:ALOADLU_U16");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_u16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_I32: VM_DEBUG_2("i:ALOADLU_I32");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_i32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_U32: VM_DEBUG_2("i:ALOADLU_U32");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_u32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_F32: VM_DEBUG_2("i:ALOADLU_F32");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_f32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_I64: VM_DEBUG_2("i:ALOADLU_I64");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_i64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_U64: VM_DEBUG_2("i:ALOADLU_U64");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_u64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ALOADLU_F64: VM_DEBUG_2("i:ALOADLU_F64");   { uint8_t array = load<uint8_t>(read(1)); aloadlu_f64(&scope, array, load<uint8_t>(read(1))); break; }
+
+    case ASTORELU_I8: VM_DEBUG_2("i:ASTORELU_I8");   { uint8_t array = load<uint8_t>(read(1)); astorelu_i8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_U8: VM_DEBUG_2("i:ASTORELU_U8");   { uint8_t array = load<uint8_t>(read(1)); astorelu_u8(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_BOOL: VM_DEBUG_2("i:ASTORELU_BOOL"); { uint8_t array = load<uint8_t>(read(1)); astorelu_bool(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_I16: VM_DEBUG_2("i:ASTORELU_I16"); { uint8_t array = load<uint8_t>(read(1)); astorelu_i16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_U16: VM_DEBUG_2("i:ASTORELU_U16"); { uint8_t array = load<uint8_t>(read(1)); astorelu_u16(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_I32: VM_DEBUG_2("i:ASTORELU_I32"); { uint8_t array = load<uint8_t>(read(1)); astorelu_i32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_U32: VM_DEBUG_2("i:ASTORELU_U32"); { uint8_t array = load<uint8_t>(read(1)); astorelu_u32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_F32: VM_DEBUG_2("i:ASTORELU_F32"); { uint8_t array = load<uint8_t>(read(1)); astorelu_f32(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_I64: VM_DEBUG_2("i:ASTORELU_I64"); { uint8_t array = load<uint8_t>(read(1)); astorelu_i64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_U64: VM_DEBUG_2("i:ASTORELU_U64"); { uint8_t array = load<uint8_t>(read(1)); astorelu_u64(&scope, array, load<uint8_t>(read(1))); break; }
+    case ASTORELU_F64: VM_DEBUG_2("i:ASTORELU_F64"); { uint8_t array = load<uint8_t>(read(1)); astorelu_f64(&scope, array, load<uint8_t>(read(1))); break; }
+
+    case BRSIZE:    VM_DEBUG_2("i:BRSIZE");          { uint8_t array = load<uint8_t>(read(1)); uint64_t bytes = load<uint64_t>(read(8)); brsize(&scope, array, bytes, load<size_t>(read(8))); break; }
+
     case DEC_I8:    VM_DEBUG_2("i:DEC_I8");          dec_i8(); break;
     case DEC_U8:    VM_DEBUG_2("i:DEC_U8");          dec_u8(); break;
     case DEC_I16:   VM_DEBUG_2("i:DEC_I16");         dec_i16(); break;
@@ -187,23 +906,26 @@ bool VM::step() { // returns false if VM is finished
     case INC_U64:   VM_DEBUG_2("i:INC_U64");         inc_u64(); break;
     case INC_F64:   VM_DEBUG_2("i:INC_F64");         inc_f64(); break;
 
-    case DUPG:      VM_DEBUG_2("i:DUPG");            dupg(*(uint8_t *)read(1)); break;
+    case DUPG:      VM_DEBUG_2("i:DUPG");            dupg(load<uint8_t>(read(1))); break;
     case DUP1:      VM_DEBUG_2("i:DUP1");            dup1(); break;
     case DUP2:      VM_DEBUG_2("i:DUP2");            dup2(); break;
     case DUP4:      VM_DEBUG_2("i:DUP4");            dup4(); break;
     case DUP8:      VM_DEBUG_2("i:DUP8");            dup8(); break;
+    case DUP16:     VM_DEBUG_2("i:DUP16");           dup16(); break;
     
-    case SWAPG:     VM_DEBUG_2("i:SWAPG");           swapg(*(uint8_t *)read(1)); break;
+    case SWAPG:     VM_DEBUG_2("i:SWAPG");           swapg(load<uint8_t>(read(1))); break;
     case SWAP1:     VM_DEBUG_2("i:SWAP1");           swap1(); break;
     case SWAP2:     VM_DEBUG_2("i:SWAP2");           swap2(); break;
     case SWAP4:     VM_DEBUG_2("i:SWAP4");           swap4(); break;
     case SWAP8:     VM_DEBUG_2("i:SWAP8");           swap8(); break;
+    case SWAP16:    VM_DEBUG_2("i:SWAP16");          swap16(); break;
 
-    case POPG:      VM_DEBUG_2("i:POPG");            popg(*(uint8_t *)read(1)); break;
+    case POPG:      VM_DEBUG_2("i:POPG");            popg(load<uint8_t>(read(1))); break;
     case POP1:      VM_DEBUG_2("i:POP1");            pop1(); break;
     case POP2:      VM_DEBUG_2("i:POP2");            pop2(); break;
     case POP4:      VM_DEBUG_2("i:POP4");            pop4(); break;
     case POP8:      VM_DEBUG_2("i:POP8");            pop8(); break;
+    case POP16:     VM_DEBUG_2("i:POP16");           pop16(); break;
 
     case CMP_I8:    VM_DEBUG_2("i:CMP_I8");          cmp_i8(); break;
     case CMP_U8:    VM_DEBUG_2("i:CMP_U8");          cmp_u8(); break;
@@ -216,68 +938,674 @@ bool VM::step() { // returns false if VM is finished
     case CMP_U64:   VM_DEBUG_2("i:CMP_U64");         cmp_u64(); break;
     case CMP_F64:   VM_DEBUG_2("i:CMP_F64");         cmp_f64(); break;
 
-    case JZ:        VM_DEBUG_2("i:JZ");              jz(*(size_t *)read(8)); break;
-    case JNZ:       VM_DEBUG_2("i:JNZ");             jnz(*(size_t *)read(8)); break;
-    case JL:        VM_DEBUG_2("i:JL");              jl(*(size_t *)read(8)); break;
-    case JG:        VM_DEBUG_2("i:JG");              jg(*(size_t *)read(8)); break;
-    case JNL:       VM_DEBUG_2("i:JNL");             jnl(*(size_t *)read(8)); break;
-    case JNG:       VM_DEBUG_2("i:JNG");             jng(*(size_t *)read(8)); break;
-    case JMP:       VM_DEBUG_2("i:JMP");             jmp(*(size_t *)read(8)); break;
+    case VADD_I8X16 ... VCMPLT_F64X4: {
+      unsigned i = opcode - VADD_I8X16;
+      VM_DEBUG_2("i:VBINARY {} {}", i / simd::SHAPE_COUNT, i % simd::SHAPE_COUNT);
+      vbinary((simd::BinaryOp) (i / simd::SHAPE_COUNT), (simd::Shape) (i % simd::SHAPE_COUNT));
+      break;
+    }
+    case VSUM_I8X16 ... VHMAX_F64X4: {
+      unsigned i = opcode - VSUM_I8X16;
+      VM_DEBUG_2("i:VREDUCE {} {}", i / simd::SHAPE_COUNT, i % simd::SHAPE_COUNT);
+      vreduce((simd::ReduceOp) (i / simd::SHAPE_COUNT), (simd::Shape) (i % simd::SHAPE_COUNT));
+      break;
+    }
+
+    case HALLOC:    VM_DEBUG_2("i:HALLOC");          halloc(); break;
+    case HALLOCT:   VM_DEBUG_2("i:HALLOCT");         halloct(); break;
+    case HFREE:     VM_DEBUG_2("i:HFREE");           hfree(); break;
+    case HLOADG:    VM_DEBUG_2("i:HLOADG");          { uint8_t n = load<uint8_t>(read(1)); hloadg(n, load<uint32_t>(read(4))); break; }
+    case HLOAD_I8:  VM_DEBUG_2("i:HLOAD_I8");        hload_i8(load<uint32_t>(read(4))); break;
+    case HLOAD_U8:  VM_DEBUG_2("i:HLOAD_U8");        hload_u8(load<uint32_t>(read(4))); break;
+    case HLOAD_BOOL:VM_DEBUG_2("i:HLOAD_BOOL");      hload_bool(load<uint32_t>(read(4))); break;
+    case HLOAD_I16: VM_DEBUG_2("i:HLOAD_I16");       hload_i16(load<uint32_t>(read(4))); break;
+    case HLOAD_U16: VM_DEBUG_2("i:HLOAD_U16");       hload_u16(load<uint32_t>(read(4))); break;
+    case HLOAD_I32: VM_DEBUG_2("i:HLOAD_I32");       hload_i32(load<uint32_t>(read(4))); break;
+    case HLOAD_U32: VM_DEBUG_2("i:HLOAD_U32");       hload_u32(load<uint32_t>(read(4))); break;
+    case HLOAD_F32: VM_DEBUG_2("i:HLOAD_F32");       hload_f32(load<uint32_t>(read(4))); break;
+    case HLOAD_I64: VM_DEBUG_2("i:HLOAD_I64");       hload_i64(load<uint32_t>(read(4))); break;
+    case HLOAD_U64: VM_DEBUG_2("i:HLOAD_U64");       hload_u64(load<uint32_t>(read(4))); break;
+    case HLOAD_F64: VM_DEBUG_2("i:HLOAD_F64");       hload_f64(load<uint32_t>(read(4))); break;
+    case HSTOREG:   VM_DEBUG_2("i:HSTOREG");         { uint8_t n = load<uint8_t>(read(1)); hstoreg(n, load<uint32_t>(read(4))); break; }
+    case HSTORE_I8: VM_DEBUG_2("i:HSTORE_I8");       hstore_i8(load<uint32_t>(read(4))); break;
+    case HSTORE_U8: VM_DEBUG_2("i:HSTORE_U8");       hstore_u8(load<uint32_t>(read(4))); break;
+    case HSTORE_BOOL:VM_DEBUG_2("i:HSTORE_BOOL");     hstore_bool(load<uint32_t>(read(4))); break;
+    case HSTORE_I16:VM_DEBUG_2("i:HSTORE_I16");      hstore_i16(load<uint32_t>(read(4))); break;
+    case HSTORE_U16:VM_DEBUG_2("i:HSTORE_U16");      hstore_u16(load<uint32_t>(read(4))); break;
+    case HSTORE_I32:VM_DEBUG_2("i:HSTORE_I32");      hstore_i32(load<uint32_t>(read(4))); break;
+    case HSTORE_U32:VM_DEBUG_2("i:HSTORE_U32");      hstore_u32(load<uint32_t>(read(4))); break;
+    case HSTORE_F32:VM_DEBUG_2("i:HSTORE_F32");      hstore_f32(load<uint32_t>(read(4))); break;
+    case HSTORE_I64:VM_DEBUG_2("i:HSTORE_I64");      hstore_i64(load<uint32_t>(read(4))); break;
+    case HSTORE_U64:VM_DEBUG_2("i:HSTORE_U64");      hstore_u64(load<uint32_t>(read(4))); break;
+    case HSTORE_F64:VM_DEBUG_2("i:HSTORE_F64");      hstore_f64(load<uint32_t>(read(4))); break;
+
+    case SADDR:     VM_DEBUG_2("i:SADDR");           saddr(load<uint32_t>(read(4))); break;
+    case MEMCOPY:   VM_DEBUG_2("i:MEMCOPY");         memcopy(); break;
+    case MEMFILL:   VM_DEBUG_2("i:MEMFILL");         memfill(); break;
+    case MEMCMP:    VM_DEBUG_2("i:MEMCMP");          memcmp(); break;
+    case MEMFIND:   VM_DEBUG_2("i:MEMFIND");         memfind(); break;
+
+    case STRK:      VM_DEBUG_2("i:STRK");            strk(load<uint32_t>(read(4))); break;
+    case STRLEN:    VM_DEBUG_2("i:STRLEN");          strlen(); break;
+    case STRCAT:    VM_DEBUG_2("i:STRCAT");          strcat(); break;
+    case STRCMP:    VM_DEBUG_2("i:STRCMP");          strcmp(); break;
+    case STREQ:     VM_DEBUG_2("i:STREQ");           streq(); break;
+    case STRHASH:   VM_DEBUG_2("i:STRHASH");         strhash(); break;
+    case STRSUB:    VM_DEBUG_2("i:STRSUB");          strsub(); break;
+    case STRFREE:   VM_DEBUG_2("i:STRFREE");         strfree(); break;
+
+    case RNEW:      VM_DEBUG_2("i:RNEW");            rnew(); break;
+    case RNEWL:     VM_DEBUG_2("i:RNEWL");           rnewl(); break;
+    case RRETAIN:   VM_DEBUG_2("i:RRETAIN");         rretain(); break;
+    case RRELEASE:  VM_DEBUG_2("i:RRELEASE");        rrelease(); break;
+    case RFLUSH:    VM_DEBUG_2("i:RFLUSH");          rflush(); break;
+    case RCOUNT:    VM_DEBUG_2("i:RCOUNT");          rcount(); break;
+    case PUSHL_REF: VM_DEBUG_2("i:PUSHL_REF");       pushl_ref(&scope, load<uint8_t>(read(1))); break;
+    case POPL_REF:  VM_DEBUG_2("i:POPL_REF");        popl_ref(&scope, load<uint8_t>(read(1))); break;
+    case RLOAD_I8:  VM_DEBUG_2("i:RLOAD_I8");        rload_i8(load<uint32_t>(read(4))); break;
+    case RLOAD_U8:  VM_DEBUG_2("i:RLOAD_U8");        rload_u8(load<uint32_t>(read(4))); break;
+    case RLOAD_BOOL:VM_DEBUG_2("i:RLOAD_BOOL");      rload_bool(load<uint32_t>(read(4))); break;
+    case RLOAD_I16: VM_DEBUG_2("i:RLOAD_I16");       rload_i16(load<uint32_t>(read(4))); break;
+    case RLOAD_U16: VM_DEBUG_2("i:RLOAD_U16");       rload_u16(load<uint32_t>(read(4))); break;
+    case RLOAD_I32: VM_DEBUG_2("i:RLOAD_I32");       rload_i32(load<uint32_t>(read(4))); break;
+    case RLOAD_U32: VM_DEBUG_2("i:RLOAD_U32");       rload_u32(load<uint32_t>(read(4))); break;
+    case RLOAD_F32: VM_DEBUG_2("i:RLOAD_F32");       rload_f32(load<uint32_t>(read(4))); break;
+    case RLOAD_I64: VM_DEBUG_2("i:RLOAD_I64");       rload_i64(load<uint32_t>(read(4))); break;
+    case RLOAD_U64: VM_DEBUG_2("i:RLOAD_U64");       rload_u64(load<uint32_t>(read(4))); break;
+    case RLOAD_F64: VM_DEBUG_2("i:RLOAD_F64");       rload_f64(load<uint32_t>(read(4))); break;
+    case RLOAD_REF: VM_DEBUG_2("i:RLOAD_REF");       rload_ref(load<uint32_t>(read(4))); break;
+    case RSTORE_I8: VM_DEBUG_2("i:RSTORE_I8");       rstore_i8(load<uint32_t>(read(4))); break;
+    case RSTORE_U8: VM_DEBUG_2("i:RSTORE_U8");       rstore_u8(load<uint32_t>(read(4))); break;
+    case RSTORE_BOOL:VM_DEBUG_2("i:RSTORE_BOOL");     rstore_bool(load<uint32_t>(read(4))); break;
+    case RSTORE_I16:VM_DEBUG_2("i:RSTORE_I16");      rstore_i16(load<uint32_t>(read(4))); break;
+    case RSTORE_U16:VM_DEBUG_2("i:RSTORE_U16");      rstore_u16(load<uint32_t>(read(4))); break;
+    case RSTORE_I32:VM_DEBUG_2("i:RSTORE_I32");      rstore_i32(load<uint32_t>(read(4))); break;
+    case RSTORE_U32:VM_DEBUG_2("i:RSTORE_U32");      rstore_u32(load<uint32_t>(read(4))); break;
+    case RSTORE_F32:VM_DEBUG_2("i:RSTORE_F32");      rstore_f32(load<uint32_t>(read(4))); break;
+    case RSTORE_I64:VM_DEBUG_2("i:RSTORE_I64");      rstore_i64(load<uint32_t>(read(4))); break;
+    case RSTORE_U64:VM_DEBUG_2("i:RSTORE_U64");      rstore_u64(load<uint32_t>(read(4))); break;
+    case RSTORE_F64:VM_DEBUG_2("i:RSTORE_F64");      rstore_f64(load<uint32_t>(read(4))); break;
+    case RSTORE_REF:VM_DEBUG_2("i:RSTORE_REF");      rstore_ref(load<uint32_t>(read(4))); break;
+
+    case MOVL_I8:   VM_DEBUG_2("i:MOVL_I8");         { uint8_t dst = load<uint8_t>(read(1)); movl_i8(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_U8:   VM_DEBUG_2("i:MOVL_U8");         { uint8_t dst = load<uint8_t>(read(1)); movl_u8(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_BOOL: VM_DEBUG_2("i:MOVL_BOOL");       { uint8_t dst = load<uint8_t>(read(1)); movl_bool(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_I16:  VM_DEBUG_2("i:MOVL_I16");        { uint8_t dst = load<uint8_t>(read(1)); movl_i16(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_U16:  VM_DEBUG_2("i:MOVL_U16");        { uint8_t dst = load<uint8_t>(read(1)); movl_u16(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_I32:  VM_DEBUG_2("i:MOVL_I32");        { uint8_t dst = load<uint8_t>(read(1)); movl_i32(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_U32:  VM_DEBUG_2("i:MOVL_U32");        { uint8_t dst = load<uint8_t>(read(1)); movl_u32(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_F32:  VM_DEBUG_2("i:MOVL_F32");        { uint8_t dst = load<uint8_t>(read(1)); movl_f32(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_I64:  VM_DEBUG_2("i:MOVL_I64");        { uint8_t dst = load<uint8_t>(read(1)); movl_i64(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_U64:  VM_DEBUG_2("i:MOVL_U64");        { uint8_t dst = load<uint8_t>(read(1)); movl_u64(&scope, dst, load<uint8_t>(read(1))); break; }
+    case MOVL_F64:  VM_DEBUG_2("i:MOVL_F64");        { uint8_t dst = load<uint8_t>(read(1)); movl_f64(&scope, dst, load<uint8_t>(read(1))); break; }
+
+    case ADDL_I8:   VM_DEBUG_2("i:ADDL_I8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_i8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_U8:   VM_DEBUG_2("i:ADDL_U8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_u8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_I16:  VM_DEBUG_2("i:ADDL_I16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_i16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_U16:  VM_DEBUG_2("i:ADDL_U16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_u16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_I32:  VM_DEBUG_2("i:ADDL_I32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_i32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_U32:  VM_DEBUG_2("i:ADDL_U32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_u32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_F32:  VM_DEBUG_2("i:ADDL_F32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_f32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_I64:  VM_DEBUG_2("i:ADDL_I64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_i64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_U64:  VM_DEBUG_2("i:ADDL_U64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_u64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case ADDL_F64:  VM_DEBUG_2("i:ADDL_F64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); addl_f64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+
+    case SUBL_I8:   VM_DEBUG_2("i:SUBL_I8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_i8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_U8:   VM_DEBUG_2("i:SUBL_U8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_u8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_I16:  VM_DEBUG_2("i:SUBL_I16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_i16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_U16:  VM_DEBUG_2("i:SUBL_U16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_u16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_I32:  VM_DEBUG_2("i:SUBL_I32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_i32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_U32:  VM_DEBUG_2("i:SUBL_U32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_u32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_F32:  VM_DEBUG_2("i:SUBL_F32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_f32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_I64:  VM_DEBUG_2("i:SUBL_I64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_i64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_U64:  VM_DEBUG_2("i:SUBL_U64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_u64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case SUBL_F64:  VM_DEBUG_2("i:SUBL_F64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); subl_f64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+
+    case MULL_I8:   VM_DEBUG_2("i:MULL_I8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_i8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_U8:   VM_DEBUG_2("i:MULL_U8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_u8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_I16:  VM_DEBUG_2("i:MULL_I16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_i16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_U16:  VM_DEBUG_2("i:MULL_U16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_u16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_I32:  VM_DEBUG_2("i:MULL_I32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_i32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_U32:  VM_DEBUG_2("i:MULL_U32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_u32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_F32:  VM_DEBUG_2("i:MULL_F32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_f32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_I64:  VM_DEBUG_2("i:MULL_I64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_i64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_U64:  VM_DEBUG_2("i:MULL_U64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_u64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case MULL_F64:  VM_DEBUG_2("i:MULL_F64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); mull_f64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+
+    case DIVL_I8:   VM_DEBUG_2("i:DIVL_I8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_i8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_U8:   VM_DEBUG_2("i:DIVL_U8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_u8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_I16:  VM_DEBUG_2("i:DIVL_I16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_i16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_U16:  VM_DEBUG_2("i:DIVL_U16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_u16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_I32:  VM_DEBUG_2("i:DIVL_I32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_i32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_U32:  VM_DEBUG_2("i:DIVL_U32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_u32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_F32:  VM_DEBUG_2("i:DIVL_F32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_f32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_I64:  VM_DEBUG_2("i:DIVL_I64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_i64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_U64:  VM_DEBUG_2("i:DIVL_U64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_u64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case DIVL_F64:  VM_DEBUG_2("i:DIVL_F64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); divl_f64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+
+    case REML_I8:   VM_DEBUG_2("i:REML_I8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_i8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_U8:   VM_DEBUG_2("i:REML_U8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_u8(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_I16:  VM_DEBUG_2("i:REML_I16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_i16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_U16:  VM_DEBUG_2("i:REML_U16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_u16(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_I32:  VM_DEBUG_2("i:REML_I32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_i32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_U32:  VM_DEBUG_2("i:REML_U32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_u32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_F32:  VM_DEBUG_2("i:REML_F32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_f32(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_I64:  VM_DEBUG_2("i:REML_I64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_i64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_U64:  VM_DEBUG_2("i:REML_U64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_u64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+    case REML_F64:  VM_DEBUG_2("i:REML_F64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t a = load<uint8_t>(read(1)); reml_f64(&scope, dst, a, load<uint8_t>(read(1))); break; }
+
+    case CMPL_I8:   VM_DEBUG_2("i:CMPL_I8");         { uint8_t a = load<uint8_t>(read(1)); cmpl_i8(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_U8:   VM_DEBUG_2("i:CMPL_U8");         { uint8_t a = load<uint8_t>(read(1)); cmpl_u8(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_I16:  VM_DEBUG_2("i:CMPL_I16");        { uint8_t a = load<uint8_t>(read(1)); cmpl_i16(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_U16:  VM_DEBUG_2("i:CMPL_U16");        { uint8_t a = load<uint8_t>(read(1)); cmpl_u16(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_I32:  VM_DEBUG_2("i:CMPL_I32");        { uint8_t a = load<uint8_t>(read(1)); cmpl_i32(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_U32:  VM_DEBUG_2("i:CMPL_U32");        { uint8_t a = load<uint8_t>(read(1)); cmpl_u32(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_F32:  VM_DEBUG_2("i:CMPL_F32");        { uint8_t a = load<uint8_t>(read(1)); cmpl_f32(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_I64:  VM_DEBUG_2("i:CMPL_I64");        { uint8_t a = load<uint8_t>(read(1)); cmpl_i64(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_U64:  VM_DEBUG_2("i:CMPL_U64");        { uint8_t a = load<uint8_t>(read(1)); cmpl_u64(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPL_F64:  VM_DEBUG_2("i:CMPL_F64");        { uint8_t a = load<uint8_t>(read(1)); cmpl_f64(&scope, a, load<uint8_t>(read(1))); break; }
+    case CMPLI_I8:  VM_DEBUG_2("i:CMPLI_I8");        { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); break; }
+    case CMPLI_U8:  VM_DEBUG_2("i:CMPLI_U8");        { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); break; }
+    case CMPLI_I16: VM_DEBUG_2("i:CMPLI_I16");       { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); break; }
+    case CMPLI_U16: VM_DEBUG_2("i:CMPLI_U16");       { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); break; }
+    case CMPLI_I32: VM_DEBUG_2("i:CMPLI_I32");       { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); break; }
+    case CMPLI_U32: VM_DEBUG_2("i:CMPLI_U32");       { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); break; }
+    case CMPLI_F32: VM_DEBUG_2("i:CMPLI_F32");       { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); break; }
+    case CMPLI_I64: VM_DEBUG_2("i:CMPLI_I64");       { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); break; }
+    case CMPLI_U64: VM_DEBUG_2("i:CMPLI_U64");       { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); break; }
+    case CMPLI_F64: VM_DEBUG_2("i:CMPLI_F64");       { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); break; }
+    case CMPI_I8:   VM_DEBUG_2("i:CMPI_I8");         cmpi_i8(load<int8_t>(read(1))); break;
+    case CMPI_U8:   VM_DEBUG_2("i:CMPI_U8");         cmpi_u8(load<uint8_t>(read(1))); break;
+    case CMPI_I16:  VM_DEBUG_2("i:CMPI_I16");        cmpi_i16(load<int16_t>(read(2))); break;
+    case CMPI_U16:  VM_DEBUG_2("i:CMPI_U16");        cmpi_u16(load<uint16_t>(read(2))); break;
+    case CMPI_I32:  VM_DEBUG_2("i:CMPI_I32");        cmpi_i32(load<int32_t>(read(4))); break;
+    case CMPI_U32:  VM_DEBUG_2("i:CMPI_U32");        cmpi_u32(load<uint32_t>(read(4))); break;
+    case CMPI_F32:  VM_DEBUG_2("i:CMPI_F32");        cmpi_f32(load<float>(read(4))); break;
+    case CMPI_I64:  VM_DEBUG_2("i:CMPI_I64");        cmpi_i64(load<int64_t>(read(8))); break;
+    case CMPI_U64:  VM_DEBUG_2("i:CMPI_U64");        cmpi_u64(load<uint64_t>(read(8))); break;
+    case CMPI_F64:  VM_DEBUG_2("i:CMPI_F64");        cmpi_f64(load<double>(read(8))); break;
+
+    case BRLI_Z_I8: VM_DEBUG_2("i:BRLI_Z_I8");       { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_U8: VM_DEBUG_2("i:BRLI_Z_U8");       { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_I16:VM_DEBUG_2("i:BRLI_Z_I16");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_U16:VM_DEBUG_2("i:BRLI_Z_U16");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_I32:VM_DEBUG_2("i:BRLI_Z_I32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_U32:VM_DEBUG_2("i:BRLI_Z_U32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_F32:VM_DEBUG_2("i:BRLI_Z_F32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_I64:VM_DEBUG_2("i:BRLI_Z_I64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_U64:VM_DEBUG_2("i:BRLI_Z_U64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); jz(load<size_t>(read(8))); break; }
+    case BRLI_Z_F64:VM_DEBUG_2("i:BRLI_Z_F64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); jz(load<size_t>(read(8))); break; }
+
+    case BRLI_NZ_I8:VM_DEBUG_2("i:BRLI_NZ_I8");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_U8:VM_DEBUG_2("i:BRLI_NZ_U8");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_I16:VM_DEBUG_2("i:BRLI_NZ_I16");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_U16:VM_DEBUG_2("i:BRLI_NZ_U16");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_I32:VM_DEBUG_2("i:BRLI_NZ_I32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_U32:VM_DEBUG_2("i:BRLI_NZ_U32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_F32:VM_DEBUG_2("i:BRLI_NZ_F32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_I64:VM_DEBUG_2("i:BRLI_NZ_I64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_U64:VM_DEBUG_2("i:BRLI_NZ_U64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); jnz(load<size_t>(read(8))); break; }
+    case BRLI_NZ_F64:VM_DEBUG_2("i:BRLI_NZ_F64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); jnz(load<size_t>(read(8))); break; }
+
+    case BRLI_L_I8: VM_DEBUG_2("i:BRLI_L_I8");       { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_U8: VM_DEBUG_2("i:BRLI_L_U8");       { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_I16:VM_DEBUG_2("i:BRLI_L_I16");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_U16:VM_DEBUG_2("i:BRLI_L_U16");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_I32:VM_DEBUG_2("i:BRLI_L_I32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_U32:VM_DEBUG_2("i:BRLI_L_U32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_F32:VM_DEBUG_2("i:BRLI_L_F32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_I64:VM_DEBUG_2("i:BRLI_L_I64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_U64:VM_DEBUG_2("i:BRLI_L_U64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); jl(load<size_t>(read(8))); break; }
+    case BRLI_L_F64:VM_DEBUG_2("i:BRLI_L_F64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); jl(load<size_t>(read(8))); break; }
+
+    case BRLI_G_I8: VM_DEBUG_2("i:BRLI_G_I8");       { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_U8: VM_DEBUG_2("i:BRLI_G_U8");       { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_I16:VM_DEBUG_2("i:BRLI_G_I16");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_U16:VM_DEBUG_2("i:BRLI_G_U16");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_I32:VM_DEBUG_2("i:BRLI_G_I32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_U32:VM_DEBUG_2("i:BRLI_G_U32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_F32:VM_DEBUG_2("i:BRLI_G_F32");      { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_I64:VM_DEBUG_2("i:BRLI_G_I64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_U64:VM_DEBUG_2("i:BRLI_G_U64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); jg(load<size_t>(read(8))); break; }
+    case BRLI_G_F64:VM_DEBUG_2("i:BRLI_G_F64");      { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); jg(load<size_t>(read(8))); break; }
+
+    case BRLI_NL_I8:VM_DEBUG_2("i:BRLI_NL_I8");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_U8:VM_DEBUG_2("i:BRLI_NL_U8");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_I16:VM_DEBUG_2("i:BRLI_NL_I16");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_U16:VM_DEBUG_2("i:BRLI_NL_U16");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_I32:VM_DEBUG_2("i:BRLI_NL_I32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_U32:VM_DEBUG_2("i:BRLI_NL_U32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_F32:VM_DEBUG_2("i:BRLI_NL_F32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_I64:VM_DEBUG_2("i:BRLI_NL_I64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_U64:VM_DEBUG_2("i:BRLI_NL_U64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); jnl(load<size_t>(read(8))); break; }
+    case BRLI_NL_F64:VM_DEBUG_2("i:BRLI_NL_F64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); jnl(load<size_t>(read(8))); break; }
+
+    case BRLI_NG_I8:VM_DEBUG_2("i:BRLI_NG_I8");      { uint8_t index = load<uint8_t>(read(1)); cmpli_i8(load<int8_t>(read(1)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_U8:VM_DEBUG_2("i:BRLI_NG_U8");      { uint8_t index = load<uint8_t>(read(1)); cmpli_u8(load<uint8_t>(read(1)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_I16:VM_DEBUG_2("i:BRLI_NG_I16");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i16(load<int16_t>(read(2)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_U16:VM_DEBUG_2("i:BRLI_NG_U16");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u16(load<uint16_t>(read(2)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_I32:VM_DEBUG_2("i:BRLI_NG_I32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i32(load<int32_t>(read(4)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_U32:VM_DEBUG_2("i:BRLI_NG_U32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u32(load<uint32_t>(read(4)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_F32:VM_DEBUG_2("i:BRLI_NG_F32");     { uint8_t index = load<uint8_t>(read(1)); cmpli_f32(load<float>(read(4)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_I64:VM_DEBUG_2("i:BRLI_NG_I64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_i64(load<int64_t>(read(8)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_U64:VM_DEBUG_2("i:BRLI_NG_U64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_u64(load<uint64_t>(read(8)), &scope, index); jng(load<size_t>(read(8))); break; }
+    case BRLI_NG_F64:VM_DEBUG_2("i:BRLI_NG_F64");     { uint8_t index = load<uint8_t>(read(1)); cmpli_f64(load<double>(read(8)), &scope, index); jng(load<size_t>(read(8))); break; }
+
+    case BR_Z_I8:   VM_DEBUG_2("i:BR_Z_I8");         br_z_i8(load<size_t>(read(8))); break;
+    case BR_Z_U8:   VM_DEBUG_2("i:BR_Z_U8");         br_z_u8(load<size_t>(read(8))); break;
+    case BR_Z_I16:  VM_DEBUG_2("i:BR_Z_I16");        br_z_i16(load<size_t>(read(8))); break;
+    case BR_Z_U16:  VM_DEBUG_2("i:BR_Z_U16");        br_z_u16(load<size_t>(read(8))); break;
+    case BR_Z_I32:  VM_DEBUG_2("i:BR_Z_I32");        br_z_i32(load<size_t>(read(8))); break;
+    case BR_Z_U32:  VM_DEBUG_2("i:BR_Z_U32");        br_z_u32(load<size_t>(read(8))); break;
+    case BR_Z_F32:  VM_DEBUG_2("i:BR_Z_F32");        br_z_f32(load<size_t>(read(8))); break;
+    case BR_Z_I64:  VM_DEBUG_2("i:BR_Z_I64");        br_z_i64(load<size_t>(read(8))); break;
+    case BR_Z_U64:  VM_DEBUG_2("i:BR_Z_U64");        br_z_u64(load<size_t>(read(8))); break;
+    case BR_Z_F64:  VM_DEBUG_2("i:BR_Z_F64");        br_z_f64(load<size_t>(read(8))); break;
+
+    case BR_NZ_I8:  VM_DEBUG_2("i:BR_NZ_I8");        br_nz_i8(load<size_t>(read(8))); break;
+    case BR_NZ_U8:  VM_DEBUG_2("i:BR_NZ_U8");        br_nz_u8(load<size_t>(read(8))); break;
+    case BR_NZ_I16: VM_DEBUG_2("i:BR_NZ_I16");       br_nz_i16(load<size_t>(read(8))); break;
+    case BR_NZ_U16: VM_DEBUG_2("i:BR_NZ_U16");       br_nz_u16(load<size_t>(read(8))); break;
+    case BR_NZ_I32: VM_DEBUG_2("i:BR_NZ_I32");       br_nz_i32(load<size_t>(read(8))); break;
+    case BR_NZ_U32: VM_DEBUG_2("i:BR_NZ_U32");       br_nz_u32(load<size_t>(read(8))); break;
+    case BR_NZ_F32: VM_DEBUG_2("i:BR_NZ_F32");       br_nz_f32(load<size_t>(read(8))); break;
+    case BR_NZ_I64: VM_DEBUG_2("i:BR_NZ_I64");       br_nz_i64(load<size_t>(read(8))); break;
+    case BR_NZ_U64: VM_DEBUG_2("i:BR_NZ_U64");       br_nz_u64(load<size_t>(read(8))); break;
+    case BR_NZ_F64: VM_DEBUG_2("i:BR_NZ_F64");       br_nz_f64(load<size_t>(read(8))); break;
+
+    case BR_L_I8:   VM_DEBUG_2("i:BR_L_I8");         br_l_i8(load<size_t>(read(8))); break;
+    case BR_L_U8:   VM_DEBUG_2("i:BR_L_U8");         br_l_u8(load<size_t>(read(8))); break;
+    case BR_L_I16:  VM_DEBUG_2("i:BR_L_I16");        br_l_i16(load<size_t>(read(8))); break;
+    case BR_L_U16:  VM_DEBUG_2("i:BR_L_U16");        br_l_u16(load<size_t>(read(8))); break;
+    case BR_L_I32:  VM_DEBUG_2("i:BR_L_I32");        br_l_i32(load<size_t>(read(8))); break;
+    case BR_L_U32:  VM_DEBUG_2("i:BR_L_U32");        br_l_u32(load<size_t>(read(8))); break;
+    case BR_L_F32:  VM_DEBUG_2("i:BR_L_F32");        br_l_f32(load<size_t>(read(8))); break;
+    case BR_L_I64:  VM_DEBUG_2("i:BR_L_I64");        br_l_i64(load<size_t>(read(8))); break;
+    case BR_L_U64:  VM_DEBUG_2("i:BR_L_U64");        br_l_u64(load<size_t>(read(8))); break;
+    case BR_L_F64:  VM_DEBUG_2("i:BR_L_F64");        br_l_f64(load<size_t>(read(8))); break;
+
+    case BR_G_I8:   VM_DEBUG_2("i:BR_G_I8");         br_g_i8(load<size_t>(read(8))); break;
+    case BR_G_U8:   VM_DEBUG_2("i:BR_G_U8");         br_g_u8(load<size_t>(read(8))); break;
+    case BR_G_I16:  VM_DEBUG_2("i:BR_G_I16");        br_g_i16(load<size_t>(read(8))); break;
+    case BR_G_U16:  VM_DEBUG_2("i:BR_G_U16");        br_g_u16(load<size_t>(read(8))); break;
+    case BR_G_I32:  VM_DEBUG_2("i:BR_G_I32");        br_g_i32(load<size_t>(read(8))); break;
+    case BR_G_U32:  VM_DEBUG_2("i:BR_G_U32");        br_g_u32(load<size_t>(read(8))); break;
+    case BR_G_F32:  VM_DEBUG_2("i:BR_G_F32");        br_g_f32(load<size_t>(read(8))); break;
+    case BR_G_I64:  VM_DEBUG_2("i:BR_G_I64");        br_g_i64(load<size_t>(read(8))); break;
+    case BR_G_U64:  VM_DEBUG_2("i:BR_G_U64");        br_g_u64(load<size_t>(read(8))); break;
+    case BR_G_F64:  VM_DEBUG_2("i:BR_G_F64");        br_g_f64(load<size_t>(read(8))); break;
+
+    case BR_NL_I8:  VM_DEBUG_2("i:BR_NL_I8");        br_nl_i8(load<size_t>(read(8))); break;
+    case BR_NL_U8:  VM_DEBUG_2("i:BR_NL_U8");        br_nl_u8(load<size_t>(read(8))); break;
+    case BR_NL_I16: VM_DEBUG_2("i:BR_NL_I16");       br_nl_i16(load<size_t>(read(8))); break;
+    case BR_NL_U16: VM_DEBUG_2("i:BR_NL_U16");       br_nl_u16(load<size_t>(read(8))); break;
+    case BR_NL_I32: VM_DEBUG_2("i:BR_NL_I32");       br_nl_i32(load<size_t>(read(8))); break;
+    case BR_NL_U32: VM_DEBUG_2("i:BR_NL_U32");       br_nl_u32(load<size_t>(read(8))); break;
+    case BR_NL_F32: VM_DEBUG_2("i:BR_NL_F32");       br_nl_f32(load<size_t>(read(8))); break;
+    case BR_NL_I64: VM_DEBUG_2("i:BR_NL_I64");       br_nl_i64(load<size_t>(read(8))); break;
+    case BR_NL_U64: VM_DEBUG_2("i:BR_NL_U64");       br_nl_u64(load<size_t>(read(8))); break;
+    case BR_NL_F64: VM_DEBUG_2("i:BR_NL_F64");       br_nl_f64(load<size_t>(read(8))); break;
+
+    case BR_NG_I8:  VM_DEBUG_2("i:BR_NG_I8");        br_ng_i8(load<size_t>(read(8))); break;
+    case BR_NG_U8:  VM_DEBUG_2("i:BR_NG_U8");        br_ng_u8(load<size_t>(read(8))); break;
+    case BR_NG_I16: VM_DEBUG_2("i:BR_NG_I16");       br_ng_i16(load<size_t>(read(8))); break;
+    case BR_NG_U16: VM_DEBUG_2("i:BR_NG_U16");       br_ng_u16(load<size_t>(read(8))); break;
+    case BR_NG_I32: VM_DEBUG_2("i:BR_NG_I32");       br_ng_i32(load<size_t>(read(8))); break;
+    case BR_NG_U32: VM_DEBUG_2("i:BR_NG_U32");       br_ng_u32(load<size_t>(read(8))); break;
+    case BR_NG_F32: VM_DEBUG_2("i:BR_NG_F32");       br_ng_f32(load<size_t>(read(8))); break;
+    case BR_NG_I64: VM_DEBUG_2("i:BR_NG_I64");       br_ng_i64(load<size_t>(read(8))); break;
+    case BR_NG_U64: VM_DEBUG_2("i:BR_NG_U64");       br_ng_u64(load<size_t>(read(8))); break;
+    case BR_NG_F64: VM_DEBUG_2("i:BR_NG_F64");       br_ng_f64(load<size_t>(read(8))); break;
+
+    case BRI_Z_I8:  VM_DEBUG_2("i:BRI_Z_I8");         cmpi_i8(load<int8_t>(read(1))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_U8:  VM_DEBUG_2("i:BRI_Z_U8");         cmpi_u8(load<uint8_t>(read(1))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_I16: VM_DEBUG_2("i:BRI_Z_I16");        cmpi_i16(load<int16_t>(read(2))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_U16: VM_DEBUG_2("i:BRI_Z_U16");        cmpi_u16(load<uint16_t>(read(2))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_I32: VM_DEBUG_2("i:BRI_Z_I32");        cmpi_i32(load<int32_t>(read(4))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_U32: VM_DEBUG_2("i:BRI_Z_U32");        cmpi_u32(load<uint32_t>(read(4))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_F32: VM_DEBUG_2("i:BRI_Z_F32");        cmpi_f32(load<float>(read(4))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_I64: VM_DEBUG_2("i:BRI_Z_I64");        cmpi_i64(load<int64_t>(read(8))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_U64: VM_DEBUG_2("i:BRI_Z_U64");        cmpi_u64(load<uint64_t>(read(8))); jz(load<size_t>(read(8))); break;
+    case BRI_Z_F64: VM_DEBUG_2("i:BRI_Z_F64");        cmpi_f64(load<double>(read(8))); jz(load<size_t>(read(8))); break;
+
+    case BRI_NZ_I8: VM_DEBUG_2("i:BRI_NZ_I8");        cmpi_i8(load<int8_t>(read(1))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_U8: VM_DEBUG_2("i:BRI_NZ_U8");        cmpi_u8(load<uint8_t>(read(1))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_I16:VM_DEBUG_2("i:BRI_NZ_I16");       cmpi_i16(load<int16_t>(read(2))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_U16:VM_DEBUG_2("i:BRI_NZ_U16");       cmpi_u16(load<uint16_t>(read(2))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_I32:VM_DEBUG_2("i:BRI_NZ_I32");       cmpi_i32(load<int32_t>(read(4))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_U32:VM_DEBUG_2("i:BRI_NZ_U32");       cmpi_u32(load<uint32_t>(read(4))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_F32:VM_DEBUG_2("i:BRI_NZ_F32");       cmpi_f32(load<float>(read(4))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_I64:VM_DEBUG_2("i:BRI_NZ_I64");       cmpi_i64(load<int64_t>(read(8))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_U64:VM_DEBUG_2("i:BRI_NZ_U64");       cmpi_u64(load<uint64_t>(read(8))); jnz(load<size_t>(read(8))); break;
+    case BRI_NZ_F64:VM_DEBUG_2("i:BRI_NZ_F64");       cmpi_f64(load<double>(read(8))); jnz(load<size_t>(read(8))); break;
+
+    case BRI_L_I8:  VM_DEBUG_2("i:BRI_L_I8");         cmpi_i8(load<int8_t>(read(1))); jl(load<size_t>(read(8))); break;
+    case BRI_L_U8:  VM_DEBUG_2("i:BRI_L_U8");         cmpi_u8(load<uint8_t>(read(1))); jl(load<size_t>(read(8))); break;
+    case BRI_L_I16: VM_DEBUG_2("i:BRI_L_I16");        cmpi_i16(load<int16_t>(read(2))); jl(load<size_t>(read(8))); break;
+    case BRI_L_U16: VM_DEBUG_2("i:BRI_L_U16");        cmpi_u16(load<uint16_t>(read(2))); jl(load<size_t>(read(8))); break;
+    case BRI_L_I32: VM_DEBUG_2("i:BRI_L_I32");        cmpi_i32(load<int32_t>(read(4))); jl(load<size_t>(read(8))); break;
+    case BRI_L_U32: VM_DEBUG_2("i:BRI_L_U32");        cmpi_u32(load<uint32_t>(read(4))); jl(load<size_t>(read(8))); break;
+    case BRI_L_F32: VM_DEBUG_2("i:BRI_L_F32");        cmpi_f32(load<float>(read(4))); jl(load<size_t>(read(8))); break;
+    case BRI_L_I64: VM_DEBUG_2("i:BRI_L_I64");        cmpi_i64(load<int64_t>(read(8))); jl(load<size_t>(read(8))); break;
+    case BRI_L_U64: VM_DEBUG_2("i:BRI_L_U64");        cmpi_u64(load<uint64_t>(read(8))); jl(load<size_t>(read(8))); break;
+    case BRI_L_F64: VM_DEBUG_2("i:BRI_L_F64");        cmpi_f64(load<double>(read(8))); jl(load<size_t>(read(8))); break;
+
+    case BRI_G_I8:  VM_DEBUG_2("i:BRI_G_I8");         cmpi_i8(load<int8_t>(read(1))); jg(load<size_t>(read(8))); break;
+    case BRI_G_U8:  VM_DEBUG_2("i:BRI_G_U8");         cmpi_u8(load<uint8_t>(read(1))); jg(load<size_t>(read(8))); break;
+    case BRI_G_I16: VM_DEBUG_2("i:BRI_G_I16");        cmpi_i16(load<int16_t>(read(2))); jg(load<size_t>(read(8))); break;
+    case BRI_G_U16: VM_DEBUG_2("i:BRI_G_U16");        cmpi_u16(load<uint16_t>(read(2))); jg(load<size_t>(read(8))); break;
+    case BRI_G_I32: VM_DEBUG_2("i:BRI_G_I32");        cmpi_i32(load<int32_t>(read(4))); jg(load<size_t>(read(8))); break;
+    case BRI_G_U32: VM_DEBUG_2("i:BRI_G_U32");        cmpi_u32(load<uint32_t>(read(4))); jg(load<size_t>(read(8))); break;
+    case BRI_G_F32: VM_DEBUG_2("i:BRI_G_F32");        cmpi_f32(load<float>(read(4))); jg(load<size_t>(read(8))); break;
+    case BRI_G_I64: VM_DEBUG_2("i:BRI_G_I64");        cmpi_i64(load<int64_t>(read(8))); jg(load<size_t>(read(8))); break;
+    case BRI_G_U64: VM_DEBUG_2("i:BRI_G_U64");        cmpi_u64(load<uint64_t>(read(8))); jg(load<size_t>(read(8))); break;
+    case BRI_G_F64: VM_DEBUG_2("i:BRI_G_F64");        cmpi_f64(load<double>(read(8))); jg(load<size_t>(read(8))); break;
+
+    case BRI_NL_I8: VM_DEBUG_2("i:BRI_NL_I8");        cmpi_i8(load<int8_t>(read(1))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_U8: VM_DEBUG_2("i:BRI_NL_U8");        cmpi_u8(load<uint8_t>(read(1))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_I16:VM_DEBUG_2("i:BRI_NL_I16");       cmpi_i16(load<int16_t>(read(2))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_U16:VM_DEBUG_2("i:BRI_NL_U16");       cmpi_u16(load<uint16_t>(read(2))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_I32:VM_DEBUG_2("i:BRI_NL_I32");       cmpi_i32(load<int32_t>(read(4))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_U32:VM_DEBUG_2("i:BRI_NL_U32");       cmpi_u32(load<uint32_t>(read(4))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_F32:VM_DEBUG_2("i:BRI_NL_F32");       cmpi_f32(load<float>(read(4))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_I64:VM_DEBUG_2("i:BRI_NL_I64");       cmpi_i64(load<int64_t>(read(8))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_U64:VM_DEBUG_2("i:BRI_NL_U64");       cmpi_u64(load<uint64_t>(read(8))); jnl(load<size_t>(read(8))); break;
+    case BRI_NL_F64:VM_DEBUG_2("i:BRI_NL_F64");       cmpi_f64(load<double>(read(8))); jnl(load<size_t>(read(8))); break;
+
+    case BRI_NG_I8: VM_DEBUG_2("i:BRI_NG_I8");        cmpi_i8(load<int8_t>(read(1))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_U8: VM_DEBUG_2("i:BRI_NG_U8");        cmpi_u8(load<uint8_t>(read(1))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_I16:VM_DEBUG_2("i:BRI_NG_I16");       cmpi_i16(load<int16_t>(read(2))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_U16:VM_DEBUG_2("i:BRI_NG_U16");       cmpi_u16(load<uint16_t>(read(2))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_I32:VM_DEBUG_2("i:BRI_NG_I32");       cmpi_i32(load<int32_t>(read(4))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_U32:VM_DEBUG_2("i:BRI_NG_U32");       cmpi_u32(load<uint32_t>(read(4))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_F32:VM_DEBUG_2("i:BRI_NG_F32");       cmpi_f32(load<float>(read(4))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_I64:VM_DEBUG_2("i:BRI_NG_I64");       cmpi_i64(load<int64_t>(read(8))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_U64:VM_DEBUG_2("i:BRI_NG_U64");       cmpi_u64(load<uint64_t>(read(8))); jng(load<size_t>(read(8))); break;
+    case BRI_NG_F64:VM_DEBUG_2("i:BRI_NG_F64");       cmpi_f64(load<double>(read(8))); jng(load<size_t>(read(8))); break;
+
+    case MOVL2_I8:  VM_DEBUG_2("i:MOVL2_I8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_i8(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_U8:  VM_DEBUG_2("i:MOVL2_U8");         { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_u8(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_BOOL:VM_DEBUG_2("i:MOVL2_BOOL");       { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_bool(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_I16: VM_DEBUG_2("i:MOVL2_I16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_i16(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_U16: VM_DEBUG_2("i:MOVL2_U16");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_u16(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_I32: VM_DEBUG_2("i:MOVL2_I32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_i32(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_U32: VM_DEBUG_2("i:MOVL2_U32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_u32(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_F32: VM_DEBUG_2("i:MOVL2_F32");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_f32(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_I64: VM_DEBUG_2("i:MOVL2_I64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_i64(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_U64: VM_DEBUG_2("i:MOVL2_U64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_u64(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+    case MOVL2_F64: VM_DEBUG_2("i:MOVL2_F64");        { uint8_t dst = load<uint8_t>(read(1)); uint8_t src = load<uint8_t>(read(1)); uint8_t dst2 = load<uint8_t>(read(1)); movl2_f64(&scope, dst, src, dst2, load<uint8_t>(read(1))); break; }
+
+    case LOOPT_I8:  VM_DEBUG_2("i:LOOPT_I8");         { int8_t limit = load<int8_t>(read(1)); loopt_i8(limit, load<size_t>(read(8))); break; }
+    case LOOPT_U8:  VM_DEBUG_2("i:LOOPT_U8");         { uint8_t limit = load<uint8_t>(read(1)); loopt_u8(limit, load<size_t>(read(8))); break; }
+    case LOOPT_I16: VM_DEBUG_2("i:LOOPT_I16");        { int16_t limit = load<int16_t>(read(2)); loopt_i16(limit, load<size_t>(read(8))); break; }
+    case LOOPT_U16: VM_DEBUG_2("i:LOOPT_U16");        { uint16_t limit = load<uint16_t>(read(2)); loopt_u16(limit, load<size_t>(read(8))); break; }
+    case LOOPT_I32: VM_DEBUG_2("i:LOOPT_I32");        { int32_t limit = load<int32_t>(read(4)); loopt_i32(limit, load<size_t>(read(8))); break; }
+    case LOOPT_U32: VM_DEBUG_2("i:LOOPT_U32");        { uint32_t limit = load<uint32_t>(read(4)); loopt_u32(limit, load<size_t>(read(8))); break; }
+    case LOOPT_F32: VM_DEBUG_2("i:LOOPT_F32");        { float limit = load<float>(read(4)); loopt_f32(limit, load<size_t>(read(8))); break; }
+    case LOOPT_I64: VM_DEBUG_2("i:LOOPT_I64");        { int64_t limit = load<int64_t>(read(8)); loopt_i64(limit, load<size_t>(read(8))); break; }
+    case LOOPT_U64: VM_DEBUG_2("i:LOOPT_U64");        { uint64_t limit = load<uint64_t>(read(8)); loopt_u64(limit, load<size_t>(read(8))); break; }
+    case LOOPT_F64: VM_DEBUG_2("i:LOOPT_F64");        { double limit = load<double>(read(8)); loopt_f64(limit, load<size_t>(read(8))); break; }
+
+    case JZ:        VM_DEBUG_2("i:JZ");              jz(load<size_t>(read(8))); break;
+    case JNZ:       VM_DEBUG_2("i:JNZ");             jnz(load<size_t>(read(8))); break;
+    case JL:        VM_DEBUG_2("i:JL");              jl(load<size_t>(read(8))); break;
+    case JG:        VM_DEBUG_2("i:JG");              jg(load<size_t>(read(8))); break;
+    case JNL:       VM_DEBUG_2("i:JNL");             jnl(load<size_t>(read(8))); break;
+    case JNG:       VM_DEBUG_2("i:JNG");             jng(load<size_t>(read(8))); break;
+    case JMP:       VM_DEBUG_2("i:JMP");             jmp(load<size_t>(read(8))); break;
+    case JERR:      VM_DEBUG_2("i:JERR");            jerr(load<size_t>(read(8))); break;
+    case CLRERR:    VM_DEBUG_2("i:CLRERR");          clrerr(); break;
+    case CALLNATIVE:VM_DEBUG_2("i:CALLNATIVE");      callnative(load<uint16_t>(read(2))); break;
+    case AWAITNATIVE:VM_DEBUG_2("i:AWAITNATIVE");     awaitnative(load<uint16_t>(read(2))); break;
 
     case RET:       VM_DEBUG_2("i:RET");             ret(); break;
 
-    case DBG:       VM_DEBUG_2("i:DBG");             dbg(*(int8_t *)read(1)); break;
-    case SIG:       VM_DEBUG_2("i:SIG");             sig(*(int8_t *)read(1)); break;
+    case DBG:       VM_DEBUG_2("i:DBG");             dbg(load<int8_t>(read(1))); break;
+    case SIG:       VM_DEBUG_2("i:SIG");             sig(load<int8_t>(read(1))); break;
+    case YIELD:     VM_DEBUG_2("i:YIELD");           yield(); break;
+
+    case ONTRAP:    VM_DEBUG_2("i:ONTRAP");          ontrap(load<size_t>(read(8))); break;
+    case OFFTRAP:   VM_DEBUG_2("i:OFFTRAP");         offtrap(); break;
+    case RAISE:     VM_DEBUG_2("i:RAISE");           raise(); break;
 
     default:
-      throw std::runtime_error(fmt::format("Unknown opcode: {}", opcode));
+      VM_DEBUG_1("unknown opcode: {}", (unsigned)opcode);
+      trap(TRAP_BAD_OPCODE);
+      break;
   }
 
   return true;
 }
 
 
-void VM::push(void *value, size_t size) {
+void VM::push(const void *value, size_t size) {
   VM_DEBUG_2("->push {}", size);
-  if (stack_top == nullptr) {
-    stack_top = stack + size - 1;
-    memcpy(stack, value, size);
-  } else if (stack_top + size > stack + VM_STACK_SIZE) {
-    dbg(-1);
-    throw std::runtime_error("push(): stack overflow");
-  } else {
-    memcpy(stack_top + 1, value, size);
-    stack_top += size;
+  size_t width = stack_width(size);
+  if (width > (size_t)(stack + VM_STACK_SIZE - sp)) {
+    trap(TRAP_STACK_OVERFLOW);
+    return;
+  }
+#if VM_SLOT_STACK
+  // zero the padding so that a wider read of the slot is deterministic
+  store<uint64_t>(sp + width - VM_SLOT_SIZE, 0);
+#endif
+  memcpy(sp, value, size);
+  sp += width;
+  if (sp > stack_peak) {
+    stack_peak = sp;
   }
 }
 
 void *VM::pop(size_t size) {
-  VM_DEBUG_2("->pop {} ({})", size, stack_top - stack);
-  if (stack_top == nullptr) {
-    dbg(-1);
-    throw std::runtime_error("pop(): stack underflow on nullptr");
-  } else if (stack_top + 1 - size < stack) {
-    dbg(-1);
-    throw std::runtime_error("pop(): stack underflow");
-  } else if ( stack_top + 1 - size == stack ) {
-    stack_top = nullptr;
-  } else {
-    stack_top -= size;
+  VM_DEBUG_2("->pop {} ({})", size, sp - stack);
+  size_t width = stack_width(size);
+  if (width > (size_t)(sp - stack)) {
+    trap(TRAP_STACK_UNDERFLOW);
+    return trap_scratch;
+  }
+  sp -= width;
+  return sp;
+}
+
+// The `size` bytes at `address`, which must lie inside one live heap block,
+// a span from the host or the used part of the stack; module strings can be
+// read but not written. Traps on anything else.
+uint8_t *VM::memory(uint64_t address, uint64_t size, bool write) {
+  auto inside = [&](const uint8_t *begin, uint64_t length) {
+    return address >= (uint64_t)begin && address - (uint64_t)begin <= length && size <= length - (address - (uint64_t)begin);
+  };
+  if (heap.contains((const void *)address, size) || inside(stack, sp - stack) || (!write && inside(strings, strings_size))) {
+    return (uint8_t *)address;
+  }
+  for (auto &[data, length] : spans) {
+    if (inside(data, length)) {
+      return (uint8_t *)address;
+    }
+  }
+  VM_DEBUG_1("memory: {} bytes at {:#x} out of bounds", size, address);
+  trap(TRAP_BOUNDS);
+  return trap_scratch;
+}
+
+// Pops an address and returns the `size` bytes `offset` bytes past it.
+uint8_t *VM::heap_address(uint32_t offset, uint64_t size, bool write) {
+  uint64_t address = load<uint64_t>(pop(sizeof(uint64_t)));
+  if (address == 0) {
+    trap(TRAP_NULL);
+    return trap_scratch;
+  }
+  if (address > UINT64_MAX - offset) {
+    trap(TRAP_BOUNDS);
+    return trap_scratch;
+  }
+  return memory(address + offset, size, write);
+}
+
+// Allocates `size` bytes after a `header`-byte header, or traps if that is
+// more than the heap will hand out. A failed request never reaches the heap,
+// so `header + size` cannot wrap.
+void *VM::heap_alloc(uint64_t header, uint64_t size, bool temp) {
+  void *ptr = nullptr;
+  if (size <= HEAP_MAX_ALLOCATION - header) {
+    ptr = temp ? heap.alloc_temp(header + size) : heap.alloc(header + size);
   }
-  return stack_top + 1; // TODO: check if this is correct
+  if (ptr == nullptr) {
+    VM_DEBUG_1("heap: allocation of {} bytes failed", size);
+    trap(TRAP_TOO_LARGE);
+  }
+  return ptr;
+}
+
+// Whether `header` starts a live heap block with room for the payload size
+// recorded in it, so that a ref to a freed or made-up object is never trusted.
+bool VM::live_object(const RefHeader *header) {
+  size_t size;
+  return heap.find(header, size) == (const uint8_t *)header && size >= sizeof(RefHeader)
+    && header->size <= size - sizeof(RefHeader);
+}
+
+// The header of the object `r` points to, or nullptr after a trap.
+RefHeader *VM::ref_header(Ref r) {
+  if (r.address == 0) {
+    trap(TRAP_NULL);
+    return nullptr;
+  }
+  RefHeader *header = (RefHeader *)r.address - 1;
+  if (r.address < sizeof(RefHeader) || !live_object(header)) {
+    VM_DEBUG_1("ref: {:#x} is not a live object", r.address);
+    trap(TRAP_BOUNDS);
+    return nullptr;
+  }
+  return header;
+}
+
+// Pops a ref and returns the `size` bytes `offset` bytes into its payload.
+uint8_t *VM::ref_address(uint32_t offset, size_t size) {
+  RefHeader *header = ref_header(load<Ref>(pop(sizeof(Ref))));
+  if (header == nullptr) {
+    return trap_scratch;
+  }
+  if (offset > header->size || size > header->size - offset) {
+    VM_DEBUG_1("ref: {} bytes at +{} out of bounds ({})", size, offset, header->size);
+    trap(TRAP_BOUNDS);
+    return trap_scratch;
+  }
+  return (uint8_t *)(header + 1) + offset;
+}
+
+Ref VM::new_array(uint64_t length, size_t element_size) {
+  if (length > HEAP_MAX_ALLOCATION / element_size) {
+    VM_DEBUG_1("array: length {} too large", length);
+    trap(TRAP_TOO_LARGE);
+    return { 0, 0 };
+  }
+  uint64_t size = sizeof(ArrayHeader) + length * element_size;
+  RefHeader *header = (RefHeader *)heap_alloc(sizeof(RefHeader), size, false);
+  if (header == nullptr) {
+    return { 0, 0 };
+  }
+  header->count = 1;
+  header->size = size;
+  ArrayHeader *array = (ArrayHeader *)(header + 1);
+  array->length = length;
+  array->element_size = element_size;
+  memset(array + 1, 0, length * element_size);
+  return { (uint64_t)array, 0 };
+}
+
+// Whether `r` points to a live object whose payload holds an array header
+// and every element the header counts.
+bool VM::is_array(Ref r) {
+  if (r.address < sizeof(RefHeader)) {
+    return false;
+  }
+  RefHeader *object = (RefHeader *)r.address - 1;
+  if (!live_object(object) || object->size < sizeof(ArrayHeader)) {
+    return false;
+  }
+  ArrayHeader *header = (ArrayHeader *)r.address;
+  return header->element_size != 0 && header->length <= (object->size - sizeof(ArrayHeader)) / header->element_size;
+}
+
+// The array `r` points to, or nullptr after a trap.
+ArrayHeader *VM::array_header(Ref r) {
+  if (ref_header(r) == nullptr) {
+    return nullptr;
+  }
+  if (!is_array(r)) {
+    VM_DEBUG_1("array: {:#x} is not an array", r.address);
+    trap(TRAP_TYPE);
+    return nullptr;
+  }
+  return (ArrayHeader *)r.address;
+}
+
+// Element `index` of an array accessed as `size`-byte values. Accesses with
+// another element size see the array as raw bytes, like rload_<t>.
+uint8_t *VM::array_element(Ref array, uint64_t index, size_t size) {
+  ArrayHeader *header = array_header(array);
+  if (header == nullptr) {
+    return trap_scratch;
+  }
+  uint64_t length = header->element_size == size ? header->length : header->length * header->element_size / size;
+  if (index >= length) {
+    VM_DEBUG_1("array: index {} out of bounds ({})", index, length);
+    trap(TRAP_BOUNDS);
+    return trap_scratch;
+  }
+  return (uint8_t *)(header + 1) + index * size;
+}
+
+// An object released more than once in a batch is already freed when its
+// later entries come up; those are skipped.
+void VM::flush_releases() {
+  for (size_t i = 0; i < release_count; i++) {
+    RefHeader *header = release_buffer[i];
+    if (live_object(header) && --header->count == 0) {
+      heap.free(header);
+    }
+  }
+  release_count = 0;
+}
+
+const uint8_t *VM::constant(size_t index) {
+  if (index >= constant_count) {
+    trap(TRAP_BOUNDS);
+    return trap_scratch;
+  }
+  return constants + index * sizeof(uint64_t);
 }
 
 void *VM::ref(size_t offset) {
   VM_DEBUG_2("->ref {}", offset);
-  if (stack_top == nullptr) {
-    dbg(-1);
-    throw std::runtime_error("ref(): stack underflow on nullptr");
-  } else if (stack_top + 1 - offset < stack) {
-    dbg(-1);
-    throw std::runtime_error("ref(): stack underflow");
-  } else {
-    return stack_top - offset + 1;
+  if (offset > (size_t)(sp - stack)) {
+    trap(TRAP_STACK_UNDERFLOW);
+    return trap_scratch;
+  }
+  return sp - offset;
+}
+
+bool VM::host_push(const void *value, size_t size) {
+  if (stack_width(size) > (size_t)(stack + VM_STACK_SIZE - sp)) {
+    return false;
+  }
+  push(value, size);
+  return true;
+}
+
+bool VM::push_span(void *data, size_t size) {
+  if (!push_arg<uint64_t>((uint64_t)data)) {
+    return false;
+  }
+  spans.emplace_back((uint8_t *)data, size);
+  return true;
+}
+
+void *VM::host_ref(size_t offset) {
+  if (offset > (size_t)(sp - stack)) {
+    return nullptr;
   }
+  return sp - offset;
 }
 
 void VM::push_i8(int8_t value) { push(&value, sizeof(value)); }
@@ -291,34 +1619,43 @@ void VM::push_f32(float value) { push(&value, sizeof(value)); }
 void VM::push_i64(int64_t value) { push(&value, sizeof(value)); }
 void VM::push_u64(uint64_t value) { push(&value, sizeof(value)); }
 void VM::push_f64(double value) { push(&value, sizeof(value)); }
-
-
-
-void VM::popl_i8(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i8 {}", index); scope->local(index, *(int8_t *)pop(sizeof(int8_t))); }
-void VM::popl_u8(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u8 {}", index); scope->local(index, *(uint8_t *)pop(sizeof(uint8_t))); }
-void VM::popl_bool(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_bool {}", index); scope->local(index, *(bool *)pop(sizeof(bool))); }
-void VM::popl_i16(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i16 {}", index); scope->local(index, *(int16_t *)pop(sizeof(int16_t))); }
-void VM::popl_u16(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u16 {}", index); scope->local(index, *(uint16_t *)pop(sizeof(uint16_t))); }
-void VM::popl_i32(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i32 {}", index); scope->local(index, *(int32_t *)pop(sizeof(int32_t))); }
-void VM::popl_u32(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u32 {}", index); scope->local(index, *(uint32_t *)pop(sizeof(uint32_t))); }
-void VM::popl_f32(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_f32 {}", index); scope->local(index, *(float *)pop(sizeof(float))); }
-void VM::popl_i64(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i64 {}", index); scope->local(index, *(int64_t *)pop(sizeof(int64_t))); }
-void VM::popl_u64(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u64 {}", index); scope->local(index, *(uint64_t *)pop(sizeof(uint64_t))); }
-void VM::popl_f64(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_f64 {}", index); scope->local(index, *(double *)pop(sizeof(double))); }
-
-
-
-void VM::pushl_i8(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i8 {}", index); int8_t value = scope->local(index)->as_i8_safe(); push(&value, sizeof(value)); }
-void VM::pushl_u8(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u8 {}", index); uint8_t value = scope->local(index)->as_u8_safe(); push(&value, sizeof(value)); }
-void VM::pushl_bool(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_bool {}", index); bool value = scope->local(index)->as_bool_safe(); push(&value, sizeof(value)); }
-void VM::pushl_i16(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i16 {}", index); int16_t value = scope->local(index)->as_i16_safe(); push(&value, sizeof(value)); }
-void VM::pushl_u16(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u16 {}", index); uint16_t value = scope->local(index)->as_u16_safe(); push(&value, sizeof(value)); }
-void VM::pushl_i32(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i32 {}", index); int32_t value = scope->local(index)->as_i32_safe(); push(&value, sizeof(value)); }
-void VM::pushl_u32(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u32 {}", index); uint32_t value = scope->local(index)->as_u32_safe(); push(&value, sizeof(value)); }
-void VM::pushl_f32(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_f32 {}", index); float value = scope->local(index)->as_f32_safe(); push(&value, sizeof(value)); }
-void VM::pushl_i64(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i64 {}", index); int64_t value = scope->local(index)->as_i64_safe(); push(&value, sizeof(value)); }
-void VM::pushl_u64(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u64 {}", index); uint64_t value = scope->local(index)->as_u64_safe(); push(&value, sizeof(value)); }
-void VM::pushl_f64(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_f64 {}", index); double value = scope->local(index)->as_f64_safe(); push(&value, sizeof(value)); }
+void VM::push_i128(int128_t value) { push(&value, sizeof(value)); }
+void VM::push_u128(uint128_t value) { push(&value, sizeof(value)); }
+void VM::push_f128(float128_t value) { push(&value, sizeof(value)); }
+
+
+
+void VM::popl_i8(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i8 {}", index); scope->local(index, load<int8_t>(pop(sizeof(int8_t)))); }
+void VM::popl_u8(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u8 {}", index); scope->local(index, load<uint8_t>(pop(sizeof(uint8_t)))); }
+void VM::popl_bool(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_bool {}", index); scope->local(index, load<bool>(pop(sizeof(bool)))); }
+void VM::popl_i16(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i16 {}", index); scope->local(index, load<int16_t>(pop(sizeof(int16_t)))); }
+void VM::popl_u16(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u16 {}", index); scope->local(index, load<uint16_t>(pop(sizeof(uint16_t)))); }
+void VM::popl_i32(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i32 {}", index); scope->local(index, load<int32_t>(pop(sizeof(int32_t)))); }
+void VM::popl_u32(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u32 {}", index); scope->local(index, load<uint32_t>(pop(sizeof(uint32_t)))); }
+void VM::popl_f32(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_f32 {}", index); scope->local(index, load<float>(pop(sizeof(float)))); }
+void VM::popl_i64(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i64 {}", index); scope->local(index, load<int64_t>(pop(sizeof(int64_t)))); }
+void VM::popl_u64(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u64 {}", index); scope->local(index, load<uint64_t>(pop(sizeof(uint64_t)))); }
+void VM::popl_f64(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_f64 {}", index); scope->local(index, load<double>(pop(sizeof(double)))); }
+void VM::popl_i128(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_i128 {}", index); scope->local(index, load<int128_t>(pop(sizeof(int128_t)))); }
+void VM::popl_u128(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_u128 {}", index); scope->local(index, load<uint128_t>(pop(sizeof(uint128_t)))); }
+void VM::popl_f128(VMScope *scope, uint8_t index) { VM_DEBUG_2("popl_f128 {}", index); scope->local(index, load<float128_t>(pop(sizeof(float128_t)))); }
+
+
+
+void VM::pushl_i8(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i8 {}", index); int8_t value = local_as<int8_t>(scope, index, _i8); push(&value, sizeof(value)); }
+void VM::pushl_u8(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u8 {}", index); uint8_t value = local_as<uint8_t>(scope, index, _u8); push(&value, sizeof(value)); }
+void VM::pushl_bool(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_bool {}", index); bool value = local_as<bool>(scope, index, _bool); push(&value, sizeof(value)); }
+void VM::pushl_i16(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i16 {}", index); int16_t value = local_as<int16_t>(scope, index, _i16); push(&value, sizeof(value)); }
+void VM::pushl_u16(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u16 {}", index); uint16_t value = local_as<uint16_t>(scope, index, _u16); push(&value, sizeof(value)); }
+void VM::pushl_i32(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i32 {}", index); int32_t value = local_as<int32_t>(scope, index, _i32); push(&value, sizeof(value)); }
+void VM::pushl_u32(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u32 {}", index); uint32_t value = local_as<uint32_t>(scope, index, _u32); push(&value, sizeof(value)); }
+void VM::pushl_f32(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_f32 {}", index); float value = local_as<float>(scope, index, _f32); push(&value, sizeof(value)); }
+void VM::pushl_i64(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i64 {}", index); int64_t value = local_as<int64_t>(scope, index, _i64); push(&value, sizeof(value)); }
+void VM::pushl_u64(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u64 {}", index); uint64_t value = local_as<uint64_t>(scope, index, _u64); push(&value, sizeof(value)); }
+void VM::pushl_f64(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_f64 {}", index); double value = local_as<double>(scope, index, _f64); push(&value, sizeof(value)); }
+void VM::pushl_i128(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_i128 {}", index); int128_t value = local_as<int128_t>(scope, index, _i128); push(&value, sizeof(value)); }
+void VM::pushl_u128(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_u128 {}", index); uint128_t value = local_as<uint128_t>(scope, index, _u128); push(&value, sizeof(value)); }
+void VM::pushl_f128(VMScope *scope, uint8_t index) { VM_DEBUG_2("pushl_f128 {}", index); float128_t value = local_as<float128_t>(scope, index, _f128); push(&value, sizeof(value)); }
 
 
 
@@ -333,15 +1670,19 @@ void VM::setl_f32(float value, VMScope *scope, uint8_t index)        { VM_DEBUG_
 void VM::setl_i64(int64_t value, VMScope *scope, uint8_t index)      { VM_DEBUG_2("setl_i64 #{} = {}", index, value);  *scope->local(index) = value; }
 void VM::setl_u64(uint64_t value, VMScope *scope, uint8_t index)     { VM_DEBUG_2("setl_u64 #{} = {}", index, value);  *scope->local(index) = value; }
 void VM::setl_f64(double value, VMScope *scope, uint8_t index)       { VM_DEBUG_2("setl_f64 #{} = {}", index, value);  *scope->local(index) = value; }
+void VM::setl_i128(int128_t value, VMScope *scope, uint8_t index)    { VM_DEBUG_2("setl_i128 #{} = {}", index, value); *scope->local(index) = value; }
+void VM::setl_u128(uint128_t value, VMScope *scope, uint8_t index)   { VM_DEBUG_2("setl_u128 #{} = {}", index, value); *scope->local(index) = value; }
+void VM::setl_f128(float128_t value, VMScope *scope, uint8_t index)  { VM_DEBUG_2("setl_f128 #{} = {}", index, value); *scope->local(index) = value; }
 
 
 
 #define VM_IMPL_ADD(type, native_type) \
   void VM::add_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("add_##type {} + {} = {}", *a, *b, *a + *b); \
-    *b = *a + *b; \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    VM_DEBUG_2("add_##type {} + {} = {}", a, b, a + b); \
+    store<native_type>(dst, a + b); \
   }
 
 VM_IMPL_ADD(i8, int8_t)
@@ -354,6 +1695,9 @@ VM_IMPL_ADD(f32, float)
 VM_IMPL_ADD(i64, int64_t)
 VM_IMPL_ADD(u64, uint64_t)
 VM_IMPL_ADD(f64, double)
+VM_IMPL_ADD(i128, int128_t)
+VM_IMPL_ADD(u128, uint128_t)
+VM_IMPL_ADD(f128, float128_t)
 
 #undef VM_IMPL_ADD
 
@@ -361,10 +1705,11 @@ VM_IMPL_ADD(f64, double)
 
 #define VM_IMPL_SUB(type, native_type) \
   void VM::sub_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("sub_##type {} - {} = {}", *a, *b, *a - *b); \
-    *b = *a - *b; \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    VM_DEBUG_2("sub_##type {} - {} = {}", a, b, a - b); \
+    store<native_type>(dst, a - b); \
   }
 
 VM_IMPL_SUB(i8, int8_t)
@@ -377,6 +1722,9 @@ VM_IMPL_SUB(f32, float)
 VM_IMPL_SUB(i64, int64_t)
 VM_IMPL_SUB(u64, uint64_t)
 VM_IMPL_SUB(f64, double)
+VM_IMPL_SUB(i128, int128_t)
+VM_IMPL_SUB(u128, uint128_t)
+VM_IMPL_SUB(f128, float128_t)
 
 #undef VM_IMPL_SUB
 
@@ -384,10 +1732,11 @@ VM_IMPL_SUB(f64, double)
 
 #define VM_IMPL_MUL(type, native_type) \
   void VM::mul_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("mul_##type {} * {} = {}", *a, *b, *a * *b); \
-    *b = *a * *b; \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    VM_DEBUG_2("mul_##type {} * {} = {}", a, b, a * b); \
+    store<native_type>(dst, a * b); \
   }
 
 VM_IMPL_MUL(i8, int8_t)
@@ -400,21 +1749,40 @@ VM_IMPL_MUL(f32, float)
 VM_IMPL_MUL(i64, int64_t)
 VM_IMPL_MUL(u64, uint64_t)
 VM_IMPL_MUL(f64, double)
+VM_IMPL_MUL(i128, int128_t)
+VM_IMPL_MUL(u128, uint128_t)
+VM_IMPL_MUL(f128, float128_t)
 
 #undef VM_IMPL_MUL
 
 
 
+// The one signed quotient that does not fit its type, the smallest value
+// divided by -1, which faults in hardware. The quotient wraps around to the
+// dividend like negation does and sets the error register; the remainder is
+// 0. Never true for unsigned or floating-point types.
+template <typename T>
+static inline bool div_overflows(T a, T b) {
+  return (T)-1 < (T)0 && b == (T)-1 && a != 0 && (T)(0 - a) == a;
+}
+
 #define VM_IMPL_DIV(type, native_type) \
   void VM::div_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    if (*b == 0) { \
-      VM_DEBUG_2("div_##type {} / 0 = undefined", *a); \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    if (b == 0) { \
+      VM_DEBUG_2("div_##type {} / 0 = undefined", a); \
+      reg_err = 1; \
+      counters.errors++; \
+    } else if (div_overflows(a, b)) { \
+      VM_DEBUG_2("div_##type {} / -1 overflows", a); \
       reg_err = 1; \
+      counters.errors++; \
+      store<native_type>(dst, a); \
     } else { \
-      VM_DEBUG_2("div_##type {} / {} = {}", *a, *b, *a / *b); \
-      *b = *a / *b; \
+      VM_DEBUG_2("div_##type {} / {} = {}", a, b, a / b); \
+      store<native_type>(dst, a / b); \
     } \
   }
 
@@ -428,6 +1796,9 @@ VM_IMPL_DIV(f32, float)
 VM_IMPL_DIV(i64, int64_t)
 VM_IMPL_DIV(u64, uint64_t)
 VM_IMPL_DIV(f64, double)
+VM_IMPL_DIV(i128, int128_t)
+VM_IMPL_DIV(u128, uint128_t)
+VM_IMPL_DIV(f128, float128_t)
 
 #undef VM_IMPL_DIV
 
@@ -435,27 +1806,33 @@ VM_IMPL_DIV(f64, double)
 
 #define VM_IMPL_REM(type, native_type) \
   void VM::rem_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    if (*b == 0) { \
-      VM_DEBUG_2("rem_##type {} % 0 = undefined", *a); \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    if (b == 0) { \
+      VM_DEBUG_2("rem_##type {} % 0 = undefined", a); \
       reg_err = 1; \
-    }  else { \
-      VM_DEBUG_2("rem_##type {} % {} = {}", *a, *b, *a % *b); \
-      *b = *a % *b; \
+      counters.errors++; \
+    } else if (div_overflows(a, b)) { \
+      store<native_type>(dst, 0); \
+    } else { \
+      VM_DEBUG_2("rem_##type {} % {} = {}", a, b, a % b); \
+      store<native_type>(dst, a % b); \
     } \
   }
 
 #define VM_IMPL_REM_FLOAT(type, native_type, fmodfn) \
   void VM::rem_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    if (*b == 0.0) { \
-      VM_DEBUG_2("rem_##type {} % 0.0 = undefined", *a); \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    if (b == 0.0) { \
+      VM_DEBUG_2("rem_##type {} % 0.0 = undefined", a); \
       reg_err = 1; \
+      counters.errors++; \
     } else { \
-      VM_DEBUG_2("rem_##type {} % {} = {}", *a, *b, fmodfn(*a, *b)); \
-      *b = fmodfn(*a, *b); \
+      VM_DEBUG_2("rem_##type {} % {} = {}", a, b, fmodfn(a, b)); \
+      store<native_type>(dst, fmodfn(a, b)); \
     } \
   }
 
@@ -469,6 +1846,9 @@ VM_IMPL_REM_FLOAT(f32, float, fmodf32)
 VM_IMPL_REM(i64, int64_t)
 VM_IMPL_REM(u64, uint64_t)
 VM_IMPL_REM_FLOAT(f64, double, fmodf64)
+VM_IMPL_REM(i128, int128_t)
+VM_IMPL_REM(u128, uint128_t)
+VM_IMPL_REM_FLOAT(f128, float128_t, fmodf128)
 
 #undef VM_IMPL_REM
 #undef VM_IMPL_REM_FLOAT
@@ -477,9 +1857,10 @@ VM_IMPL_REM_FLOAT(f64, double, fmodf64)
 
 #define VM_IMPL_ABS(type, native_type) \
   void VM::abs_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("abs_##type {} = {}", *a, (*a > 0) ? *a : -*a); \
-    *a = (*a > 0) ? *a : -*a; \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(dst); \
+    VM_DEBUG_2("abs_##type {} = {}", a, (a > 0) ? a : -a); \
+    store<native_type>(dst, (a > 0) ? a : -a); \
   }
 
 VM_IMPL_ABS(i8, int8_t)
@@ -493,11 +1874,379 @@ VM_IMPL_ABS(f64, double)
 
 
 
+// Overflow is detected with the compiler builtins, which compute the wrapped
+// result and report whether it differs from the mathematical one.
+#define VM_IMPL_CHECKED(name, builtin, type, native_type) \
+  void VM::name##c_##type() { \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    native_type result; \
+    if (builtin(a, b, &result)) { \
+      VM_DEBUG_2(#name "c_" #type " {} {} overflowed", a, b); \
+      reg_err = 1; \
+      counters.errors++; \
+    } \
+    store<native_type>(dst, result); \
+  }
+
+// On overflow the result is clamped towards the sign the true result has.
+#define VM_IMPL_SATURATING(name, builtin, negative, type, native_type) \
+  void VM::name##s_##type() { \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    native_type result; \
+    if (builtin(a, b, &result)) { \
+      VM_DEBUG_2(#name "s_" #type " {} {} saturated", a, b); \
+      result = (negative) ? std::numeric_limits<native_type>::min() : std::numeric_limits<native_type>::max(); \
+    } \
+    store<native_type>(dst, result); \
+  }
+
+template <typename T>
+static inline bool is_negative(T value) {
+  if constexpr (std::is_signed_v<T>) {
+    return value < 0;
+  } else {
+    (void)value;
+    return false;
+  }
+}
+
+VM_IMPL_CHECKED(add, __builtin_add_overflow, i8, int8_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, u8, uint8_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, i16, int16_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, u16, uint16_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, i32, int32_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, u32, uint32_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, i64, int64_t)
+VM_IMPL_CHECKED(add, __builtin_add_overflow, u64, uint64_t)
+
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, i8, int8_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, u8, uint8_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, i16, int16_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, u16, uint16_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, i32, int32_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, u32, uint32_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, i64, int64_t)
+VM_IMPL_CHECKED(sub, __builtin_sub_overflow, u64, uint64_t)
+
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, i8, int8_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, u8, uint8_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, i16, int16_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, u16, uint16_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, i32, int32_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, u32, uint32_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, i64, int64_t)
+VM_IMPL_CHECKED(mul, __builtin_mul_overflow, u64, uint64_t)
+
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), i8, int8_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), u8, uint8_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), i16, int16_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), u16, uint16_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), i32, int32_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), u32, uint32_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), i64, int64_t)
+VM_IMPL_SATURATING(add, __builtin_add_overflow, is_negative(b), u64, uint64_t)
+
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), i8, int8_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), u8, uint8_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), i16, int16_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), u16, uint16_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), i32, int32_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), u32, uint32_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), i64, int64_t)
+VM_IMPL_SATURATING(sub, __builtin_sub_overflow, !is_negative(b), u64, uint64_t)
+
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), i8, int8_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), u8, uint8_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), i16, int16_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), u16, uint16_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), i32, int32_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), u32, uint32_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), i64, int64_t)
+VM_IMPL_SATURATING(mul, __builtin_mul_overflow, is_negative(a) != is_negative(b), u64, uint64_t)
+
+#undef VM_IMPL_CHECKED
+#undef VM_IMPL_SATURATING
+
+
+
+// Operands are converted to the unsigned type U so that every op works on the
+// raw bits; BITS is the width of the type.
+#define VM_IMPL_BITWISE(name, expr, type, native_type) \
+  void VM::name##_##type() { \
+    using U = std::make_unsigned_t<native_type>; \
+    [[maybe_unused]] const U BITS = sizeof(native_type) * 8; \
+    void *dst = operand<native_type>(0); \
+    U a = (U)load<native_type>(operand<native_type>(1)); \
+    U b = (U)load<native_type>(dst); \
+    VM_DEBUG_2(#name "_" #type " {} {}", a, b); \
+    store<native_type>(dst, (native_type)(expr)); \
+  }
+
+#define VM_IMPL_BITCOUNT(name, expr, type, native_type) \
+  void VM::name##_##type() { \
+    using U = std::make_unsigned_t<native_type>; \
+    void *dst = operand<native_type>(0); \
+    U a = (U)load<native_type>(dst); \
+    VM_DEBUG_2(#name "_" #type " {}", a); \
+    store<native_type>(dst, (native_type)(expr)); \
+  }
+
+VM_IMPL_BITWISE(and, a & b, i8, int8_t)
+VM_IMPL_BITWISE(and, a & b, u8, uint8_t)
+VM_IMPL_BITWISE(and, a & b, i16, int16_t)
+VM_IMPL_BITWISE(and, a & b, u16, uint16_t)
+VM_IMPL_BITWISE(and, a & b, i32, int32_t)
+VM_IMPL_BITWISE(and, a & b, u32, uint32_t)
+VM_IMPL_BITWISE(and, a & b, i64, int64_t)
+VM_IMPL_BITWISE(and, a & b, u64, uint64_t)
+
+VM_IMPL_BITWISE(or, a | b, i8, int8_t)
+VM_IMPL_BITWISE(or, a | b, u8, uint8_t)
+VM_IMPL_BITWISE(or, a | b, i16, int16_t)
+VM_IMPL_BITWISE(or, a | b, u16, uint16_t)
+VM_IMPL_BITWISE(or, a | b, i32, int32_t)
+VM_IMPL_BITWISE(or, a | b, u32, uint32_t)
+VM_IMPL_BITWISE(or, a | b, i64, int64_t)
+VM_IMPL_BITWISE(or, a | b, u64, uint64_t)
+
+VM_IMPL_BITWISE(xor, a ^ b, i8, int8_t)
+VM_IMPL_BITWISE(xor, a ^ b, u8, uint8_t)
+VM_IMPL_BITWISE(xor, a ^ b, i16, int16_t)
+VM_IMPL_BITWISE(xor, a ^ b, u16, uint16_t)
+VM_IMPL_BITWISE(xor, a ^ b, i32, int32_t)
+VM_IMPL_BITWISE(xor, a ^ b, u32, uint32_t)
+VM_IMPL_BITWISE(xor, a ^ b, i64, int64_t)
+VM_IMPL_BITWISE(xor, a ^ b, u64, uint64_t)
+
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), i8, int8_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), u8, uint8_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), i16, int16_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), u16, uint16_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), i32, int32_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), u32, uint32_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), i64, int64_t)
+VM_IMPL_BITWISE(shl, a << (b & (BITS - 1)), u64, uint64_t)
+
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), i8, int8_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), u8, uint8_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), i16, int16_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), u16, uint16_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), i32, int32_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), u32, uint32_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), i64, int64_t)
+VM_IMPL_BITWISE(shr, a >> (b & (BITS - 1)), u64, uint64_t)
+
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), i8, int8_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), u8, uint8_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), i16, int16_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), u16, uint16_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), i32, int32_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), u32, uint32_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), i64, int64_t)
+VM_IMPL_BITWISE(sar, (std::make_signed_t<U>)a >> (b & (BITS - 1)), u64, uint64_t)
+
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), i8, int8_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), u8, uint8_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), i16, int16_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), u16, uint16_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), i32, int32_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), u32, uint32_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), i64, int64_t)
+VM_IMPL_BITWISE(rotl, std::rotl(a, (int)(b & (BITS - 1))), u64, uint64_t)
+
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), i8, int8_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), u8, uint8_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), i16, int16_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), u16, uint16_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), i32, int32_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), u32, uint32_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), i64, int64_t)
+VM_IMPL_BITWISE(rotr, std::rotr(a, (int)(b & (BITS - 1))), u64, uint64_t)
+
+VM_IMPL_BITCOUNT(not, ~a, i8, int8_t)
+VM_IMPL_BITCOUNT(not, ~a, u8, uint8_t)
+VM_IMPL_BITCOUNT(not, ~a, i16, int16_t)
+VM_IMPL_BITCOUNT(not, ~a, u16, uint16_t)
+VM_IMPL_BITCOUNT(not, ~a, i32, int32_t)
+VM_IMPL_BITCOUNT(not, ~a, u32, uint32_t)
+VM_IMPL_BITCOUNT(not, ~a, i64, int64_t)
+VM_IMPL_BITCOUNT(not, ~a, u64, uint64_t)
+
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), i8, int8_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), u8, uint8_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), i16, int16_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), u16, uint16_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), i32, int32_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), u32, uint32_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), i64, int64_t)
+VM_IMPL_BITCOUNT(popcnt, std::popcount(a), u64, uint64_t)
+
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), i8, int8_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), u8, uint8_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), i16, int16_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), u16, uint16_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), i32, int32_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), u32, uint32_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), i64, int64_t)
+VM_IMPL_BITCOUNT(clz, std::countl_zero(a), u64, uint64_t)
+
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), i8, int8_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), u8, uint8_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), i16, int16_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), u16, uint16_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), i32, int32_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), u32, uint32_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), i64, int64_t)
+VM_IMPL_BITCOUNT(ctz, std::countr_zero(a), u64, uint64_t)
+
+#undef VM_IMPL_BITWISE
+#undef VM_IMPL_BITCOUNT
+
+
+
+#define VM_IMPL_FLOAT_UNARY(name, fn, type, native_type) \
+  void VM::name##_##type() { \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(dst); \
+    VM_DEBUG_2(#name "_" #type " {} = {}", a, fn(a)); \
+    store<native_type>(dst, fn(a)); \
+  }
+
+#define VM_IMPL_FMA(type, native_type) \
+  void VM::fma_##type() { \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(2)); \
+    native_type b = load<native_type>(operand<native_type>(1)); \
+    native_type c = load<native_type>(dst); \
+    VM_DEBUG_2("fma_" #type " {} * {} + {}", a, b, c); \
+    store<native_type>(dst, std::fma(a, b, c)); \
+  }
+
+// `a cmp b ? a : b` rather than std::min/max: it is what minss/maxss compute,
+// so floats need no extra NaN handling (an unordered compare yields the top).
+#define VM_IMPL_MINMAX(name, cmp, type, native_type) \
+  void VM::name##_##type() { \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    VM_DEBUG_2(#name "_" #type " {} {}", a, b); \
+    store<native_type>(dst, a cmp b ? a : b); \
+  }
+
+VM_IMPL_FLOAT_UNARY(sqrt, std::sqrt, f32, float)
+VM_IMPL_FLOAT_UNARY(sqrt, std::sqrt, f64, double)
+
+VM_IMPL_FLOAT_UNARY(floor, std::floor, f32, float)
+VM_IMPL_FLOAT_UNARY(floor, std::floor, f64, double)
+
+VM_IMPL_FLOAT_UNARY(ceil, std::ceil, f32, float)
+VM_IMPL_FLOAT_UNARY(ceil, std::ceil, f64, double)
+
+VM_IMPL_FLOAT_UNARY(round, std::nearbyint, f32, float)
+VM_IMPL_FLOAT_UNARY(round, std::nearbyint, f64, double)
+
+VM_IMPL_FLOAT_UNARY(trunc, std::trunc, f32, float)
+VM_IMPL_FLOAT_UNARY(trunc, std::trunc, f64, double)
+
+VM_IMPL_FMA(f32, float)
+VM_IMPL_FMA(f64, double)
+
+VM_IMPL_MINMAX(min, <, i8, int8_t)
+VM_IMPL_MINMAX(min, <, u8, uint8_t)
+VM_IMPL_MINMAX(min, <, i16, int16_t)
+VM_IMPL_MINMAX(min, <, u16, uint16_t)
+VM_IMPL_MINMAX(min, <, i32, int32_t)
+VM_IMPL_MINMAX(min, <, u32, uint32_t)
+VM_IMPL_MINMAX(min, <, f32, float)
+VM_IMPL_MINMAX(min, <, i64, int64_t)
+VM_IMPL_MINMAX(min, <, u64, uint64_t)
+VM_IMPL_MINMAX(min, <, f64, double)
+
+VM_IMPL_MINMAX(max, >, i8, int8_t)
+VM_IMPL_MINMAX(max, >, u8, uint8_t)
+VM_IMPL_MINMAX(max, >, i16, int16_t)
+VM_IMPL_MINMAX(max, >, u16, uint16_t)
+VM_IMPL_MINMAX(max, >, i32, int32_t)
+VM_IMPL_MINMAX(max, >, u32, uint32_t)
+VM_IMPL_MINMAX(max, >, f32, float)
+VM_IMPL_MINMAX(max, >, i64, int64_t)
+VM_IMPL_MINMAX(max, >, u64, uint64_t)
+VM_IMPL_MINMAX(max, >, f64, double)
+
+#undef VM_IMPL_FLOAT_UNARY
+#undef VM_IMPL_FMA
+#undef VM_IMPL_MINMAX
+
+
+
+// Integer and float-to-float conversions are plain casts (wrapping, sign or
+// zero extending, rounding to nearest). Float to integer truncates toward
+// zero and saturates at the bounds of the target, with NaN giving 0, since a
+// plain cast is undefined for values out of range.
+template <typename To, typename From>
+static inline To convert(From value) {
+  if constexpr (std::is_floating_point_v<From> && std::is_integral_v<To>) {
+    if (value != value) {
+      return 0;
+    }
+    if (value <= (From)std::numeric_limits<To>::min()) {
+      return std::numeric_limits<To>::min();
+    }
+    // max() may round up when converted, so >= also catches the values
+    // between max() and its rounded form
+    if (value >= (From)std::numeric_limits<To>::max()) {
+      return std::numeric_limits<To>::max();
+    }
+  }
+  return (To)value;
+}
+
+#define VM_IMPL_CVT(from, from_type, to, to_type) \
+  void VM::cvt_##from##_##to() { \
+    from_type a = load<from_type>(pop(sizeof(from_type))); \
+    to_type b = convert<to_type>(a); \
+    VM_DEBUG_2("cvt_" #from "_" #to " {} = {}", a, b); \
+    push(&b, sizeof(to_type)); \
+  }
+
+#define VM_IMPL_CVT_FROM(from, from_type) \
+  VM_IMPL_CVT(from, from_type, i8, int8_t) \
+  VM_IMPL_CVT(from, from_type, u8, uint8_t) \
+  VM_IMPL_CVT(from, from_type, i16, int16_t) \
+  VM_IMPL_CVT(from, from_type, u16, uint16_t) \
+  VM_IMPL_CVT(from, from_type, i32, int32_t) \
+  VM_IMPL_CVT(from, from_type, u32, uint32_t) \
+  VM_IMPL_CVT(from, from_type, f32, float) \
+  VM_IMPL_CVT(from, from_type, i64, int64_t) \
+  VM_IMPL_CVT(from, from_type, u64, uint64_t) \
+  VM_IMPL_CVT(from, from_type, f64, double)
+
+VM_IMPL_CVT_FROM(i8, int8_t)
+VM_IMPL_CVT_FROM(u8, uint8_t)
+VM_IMPL_CVT_FROM(i16, int16_t)
+VM_IMPL_CVT_FROM(u16, uint16_t)
+VM_IMPL_CVT_FROM(i32, int32_t)
+VM_IMPL_CVT_FROM(u32, uint32_t)
+VM_IMPL_CVT_FROM(f32, float)
+VM_IMPL_CVT_FROM(i64, int64_t)
+VM_IMPL_CVT_FROM(u64, uint64_t)
+VM_IMPL_CVT_FROM(f64, double)
+
+#undef VM_IMPL_CVT
+#undef VM_IMPL_CVT_FROM
+
+
+
 #define VM_IMPL_DEC(type, native_type) \
   void VM::dec_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("dec_##type {} = {}", *a, *a - 1); \
-    *a = *a - 1; \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(dst); \
+    VM_DEBUG_2("dec_##type {} = {}", a, a - 1); \
+    store<native_type>(dst, a - 1); \
   }
 
 VM_IMPL_DEC(i8, int8_t)
@@ -517,9 +2266,10 @@ VM_IMPL_DEC(f64, double)
 
 #define VM_IMPL_INC(type, native_type) \
   void VM::inc_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("inc_##type {} = {}", *a, *a + 1); \
-    *a = *a + 1; \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(dst); \
+    VM_DEBUG_2("inc_##type {} = {}", a, a + 1); \
+    store<native_type>(dst, a + 1); \
   }
 
 VM_IMPL_INC(i8, int8_t)
@@ -538,32 +2288,35 @@ VM_IMPL_INC(f64, double)
 
 
 void VM::dupg(uint8_t n) {
-  void *start = ref(n);
-  push(start, n);
+  size_t width = stack_width(n);
+  void *start = ref(width);
+  push(start, width);
 }
 
 void VM::dup1() { dupg(1); }
 void VM::dup2() { dupg(2); }
 void VM::dup4() { dupg(4); }
 void VM::dup8() { dupg(8); }
+void VM::dup16() { dupg(16); }
 
 
 
 void VM::swapg(uint8_t n) {
-  void *a = ref(n);
-  void *b = ref(n + n);
-  void *tmp = malloc(n);
-  // swap using memcpy and memmove
-  memcpy(tmp, a, n);
-  memmove(a, b, n);
-  memmove(b, tmp, n);
-  free(tmp);
+  size_t width = stack_width(n);
+  void *a = ref(width);
+  void *b = ref(width + width);
+  uint8_t tmp[stack_width(UINT8_MAX)];
+  // the two regions are adjacent and never overlap
+  memcpy(tmp, a, width);
+  memcpy(a, b, width);
+  memcpy(b, tmp, width);
 }
 
 void VM::swap1() { swapg(1); }
 void VM::swap2() { swapg(2); }
 void VM::swap4() { swapg(4); }
 void VM::swap8() { swapg(8); }
+void VM::swap16() { swapg(16); }
 
 
 
@@ -575,15 +2328,17 @@ void VM::pop1() { popg(1); }
 void VM::pop2() { popg(2); }
 void VM::pop4() { popg(4); }
 void VM::pop8() { popg(8); }
+void VM::pop16() { popg(16); }
 
 
 
 #define VM_IMPL_CMP(type, native_type) \
   void VM::cmp_##type() { \
-    native_type *a = (native_type *)ref(sizeof(native_type) + sizeof(native_type)); \
-    native_type *b = (native_type *)ref(sizeof(native_type)); \
-    VM_DEBUG_2("cmp_##type {} {}", *a, *b); \
-    reg_cmp = (*a == *b) ? 0 : ((*a < *b) ? -1 : 1); \
+    void *dst = operand<native_type>(0); \
+    native_type a = load<native_type>(operand<native_type>(1)); \
+    native_type b = load<native_type>(dst); \
+    VM_DEBUG_2("cmp_##type {} {}", a, b); \
+    reg_cmp = (a == b) ? 0 : ((a < b) ? -1 : 1); \
   }
 
 VM_IMPL_CMP(i8, int8_t)
@@ -596,50 +2351,917 @@ VM_IMPL_CMP(f32, float)
 VM_IMPL_CMP(i64, int64_t)
 VM_IMPL_CMP(u64, uint64_t)
 VM_IMPL_CMP(f64, double)
+VM_IMPL_CMP(i128, int128_t)
+VM_IMPL_CMP(u128, uint128_t)
+VM_IMPL_CMP(f128, float128_t)
 
 #undef VM_IMPL_CMP
 
 
 
+static_assert(VCMPLT_F64X4 - VADD_I8X16 + 1 == (unsigned) simd::BINARY_OP_COUNT * simd::SHAPE_COUNT);
+static_assert(VHMAX_F64X4 - VSUM_I8X16 + 1 == (unsigned) simd::REDUCE_OP_COUNT * simd::SHAPE_COUNT);
+
+void VM::vbinary(simd::BinaryOp op, simd::Shape shape) {
+  size_t size = simd::vector_size(shape);
+  void *b = ref(size);
+  void *a = ref(size + size);
+  vec->binary[op][shape](b, a, b);
+}
+
+void VM::vreduce(simd::ReduceOp op, simd::Shape shape) {
+  uint8_t result[8];
+  vec->reduce[op][shape](result, pop(simd::vector_size(shape)));
+  push(result, simd::lane_size(shape));
+}
+
+
+
+void VM::halloc() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint64_t address = (uint64_t)heap_alloc(0, size, false);
+  if (address == 0) {
+    return;
+  }
+  VM_DEBUG_2("halloc {} = {:#x}", size, address);
+  push(&address, sizeof(address));
+}
+
+void VM::halloct() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint64_t address = (uint64_t)heap_alloc(0, size, true);
+  if (address == 0) {
+    return;
+  }
+  VM_DEBUG_2("halloct {} = {:#x}", size, address);
+  push(&address, sizeof(address));
+}
+
+void VM::hfree() {
+  uint64_t address = load<uint64_t>(pop(sizeof(uint64_t)));
+  VM_DEBUG_2("hfree {:#x}", address);
+  if (!heap.free((void *)address)) {
+    trap(TRAP_BAD_FREE);
+  }
+}
+
+void VM::hloadg(uint8_t n, uint32_t offset) {
+  push(heap_address(offset, n, false), n);
+}
+
+void VM::hstoreg(uint8_t n, uint32_t offset) {
+  void *value = pop(n);
+  memcpy(heap_address(offset, n, true), value, n);
+}
+
+
+
+#define VM_IMPL_HLOAD(type, native_type) \
+  void VM::hload_##type(uint32_t offset) { \
+    native_type value = load<native_type>(heap_address(offset, sizeof(native_type), false)); \
+    VM_DEBUG_2("hload_##type +{} = {}", offset, value); \
+    push(&value, sizeof(value)); \
+  }
+
+VM_IMPL_HLOAD(i8, int8_t)
+VM_IMPL_HLOAD(u8, uint8_t)
+VM_IMPL_HLOAD(bool, bool)
+VM_IMPL_HLOAD(i16, int16_t)
+VM_IMPL_HLOAD(u16, uint16_t)
+VM_IMPL_HLOAD(i32, int32_t)
+VM_IMPL_HLOAD(u32, uint32_t)
+VM_IMPL_HLOAD(f32, float)
+VM_IMPL_HLOAD(i64, int64_t)
+VM_IMPL_HLOAD(u64, uint64_t)
+VM_IMPL_HLOAD(f64, double)
+
+#undef VM_IMPL_HLOAD
+
+
+
+#define VM_IMPL_HSTORE(type, native_type) \
+  void VM::hstore_##type(uint32_t offset) { \
+    native_type value = load<native_type>(pop(sizeof(native_type))); \
+    VM_DEBUG_2("hstore_##type +{} = {}", offset, value); \
+    store<native_type>(heap_address(offset, sizeof(native_type), true), value); \
+  }
+
+VM_IMPL_HSTORE(i8, int8_t)
+VM_IMPL_HSTORE(u8, uint8_t)
+VM_IMPL_HSTORE(bool, bool)
+VM_IMPL_HSTORE(i16, int16_t)
+VM_IMPL_HSTORE(u16, uint16_t)
+VM_IMPL_HSTORE(i32, int32_t)
+VM_IMPL_HSTORE(u32, uint32_t)
+VM_IMPL_HSTORE(f32, float)
+VM_IMPL_HSTORE(i64, int64_t)
+VM_IMPL_HSTORE(u64, uint64_t)
+VM_IMPL_HSTORE(f64, double)
+
+#undef VM_IMPL_HSTORE
+
+
+
+// `offset` must reach a byte in use: 0 would be the free slot above the top.
+void VM::saddr(uint32_t offset) {
+  if (offset == 0 || offset > (size_t)(sp - stack)) {
+    VM_DEBUG_1("saddr: offset {} outside the stack in use ({})", offset, sp - stack);
+    trap(TRAP_BOUNDS);
+    uint64_t none = 0;
+    push(&none, sizeof(none));
+    return;
+  }
+  uint64_t address = (uint64_t)(sp - offset);
+  VM_DEBUG_2("saddr {} = {:#x}", offset, address);
+  push(&address, sizeof(address));
+}
+
+void VM::memcopy() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint8_t *src = heap_address(0, size, false);
+  uint8_t *dst = heap_address(0, size, true);
+  if (reg_trap != TRAP_NONE) {
+    return; // a faulting operand must not drive a bulk copy
+  }
+  VM_DEBUG_2("memcopy {:#x} <- {:#x} ({})", (uint64_t)dst, (uint64_t)src, size);
+  memmove(dst, src, size);
+}
+
+void VM::memfill() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint8_t value = load<uint8_t>(pop(sizeof(uint8_t)));
+  uint8_t *dst = heap_address(0, size, true);
+  if (reg_trap != TRAP_NONE) {
+    return;
+  }
+  VM_DEBUG_2("memfill {:#x} = {} ({})", (uint64_t)dst, value, size);
+  memset(dst, value, size);
+}
+
+void VM::memcmp() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint8_t *b = heap_address(0, size, false);
+  uint8_t *a = heap_address(0, size, false);
+  if (reg_trap != TRAP_NONE) {
+    return;
+  }
+  int result = std::memcmp(a, b, size);
+  VM_DEBUG_2("memcmp {:#x} {:#x} ({}) = {}", (uint64_t)a, (uint64_t)b, size, result);
+  reg_cmp = (result == 0) ? 0 : ((result < 0) ? -1 : 1);
+}
+
+void VM::memfind() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint8_t value = load<uint8_t>(pop(sizeof(uint8_t)));
+  uint8_t *data = heap_address(0, size, false);
+  if (reg_trap != TRAP_NONE) {
+    return;
+  }
+  uint64_t index = vec->find(data, value, size);
+  VM_DEBUG_2("memfind {:#x} {} ({}) = {}", (uint64_t)data, value, size, index);
+  push(&index, sizeof(index));
+}
+
+
+// Pops a string handle and returns the header in front of its bytes.
+// Only handles into the module's strings section or to the bytes of a live
+// heap block with room for its header, bytes and NUL are strings. Other
+// handles into those regions fail as the wrong type, the rest as out of
+// bounds.
+StringHeader *VM::string_handle() {
+  uint64_t address = load<uint64_t>(pop(sizeof(uint64_t)));
+  if (address == 0) {
+    trap(TRAP_NULL);
+    return (StringHeader *)trap_scratch; // an empty string
+  }
+  StringHeader *header = (StringHeader *)(address - sizeof(StringHeader));
+  uint64_t base = (uint64_t)strings;
+  if (address >= base + sizeof(StringHeader) && module_string((uint64_t)header - base)) {
+    return header;
+  }
+  size_t size;
+  if (address >= sizeof(StringHeader) && heap.find(header, size) == (const uint8_t *)header
+      && size > sizeof(StringHeader) && header->length < size - sizeof(StringHeader)) {
+    return header;
+  }
+  VM_DEBUG_1("string: {:#x} is not a string", address);
+  bool owned = heap.contains((const void *)address, 0) || (address >= base && address - base <= strings_size);
+  trap(owned ? TRAP_TYPE : TRAP_BOUNDS);
+  return (StringHeader *)trap_scratch;
+}
+
+// Whether a string starts `offset` bytes into the module's strings section,
+// with its bytes and NUL inside the section.
+bool VM::module_string(uint64_t offset) {
+  if (offset % 8 != 0 || strings_size < sizeof(StringHeader) || offset > strings_size - sizeof(StringHeader)) {
+    return false;
+  }
+  StringHeader header = load<StringHeader>(strings + offset);
+  return header.length < strings_size - offset - sizeof(StringHeader);
+}
+
+// Allocates a string of `length` bytes on the heap and returns its bytes;
+// the caller fills them in, then sets the hash. Returns nullptr if the
+// string would be too long.
+uint8_t *VM::new_string(uint64_t length) {
+  if (length > UINT32_MAX) {
+    VM_DEBUG_1("string: length {} too large", length);
+    trap(TRAP_TOO_LARGE);
+    return nullptr;
+  }
+  StringHeader *header = (StringHeader *)heap_alloc(sizeof(StringHeader), length + 1, false);
+  if (header == nullptr) {
+    return nullptr;
+  }
+  header->length = length;
+  header->flags = 0;
+  uint8_t *data = (uint8_t *)(header + 1);
+  data[length] = 0;
+  return data;
+}
+
+void VM::strk(uint32_t offset) {
+  if (!module_string(offset)) {
+    VM_DEBUG_1("strk(): string {} out of bounds", offset);
+    trap(TRAP_BOUNDS);
+    return;
+  }
+  uint64_t address = (uint64_t)(strings + offset + sizeof(StringHeader));
+  VM_DEBUG_2("strk {} = {:#x}", offset, address);
+  push(&address, sizeof(address));
+}
+
+void VM::strlen() {
+  uint64_t length = string_handle()->length;
+  push(&length, sizeof(length));
+}
+
+void VM::strcat() {
+  StringHeader *b = string_handle();
+  StringHeader *a = string_handle();
+  uint8_t *data = new_string((uint64_t)a->length + b->length);
+  if (data == nullptr) {
+    return;
+  }
+  memcpy(data, a + 1, a->length);
+  memcpy(data + a->length, b + 1, b->length);
+  StringHeader *header = (StringHeader *)data - 1;
+  header->hash = string_hash(data, header->length);
+  VM_DEBUG_2("strcat {} {} = {:#x}", a->length, b->length, (uint64_t)data);
+  push(&data, sizeof(data));
+}
+
+void VM::strcmp() {
+  StringHeader *b = string_handle();
+  StringHeader *a = string_handle();
+  int result = a == b ? 0 : std::memcmp(a + 1, b + 1, std::min(a->length, b->length));
+  if (result == 0) {
+    result = (a->length > b->length) - (a->length < b->length);
+  }
+  VM_DEBUG_2("strcmp {:#x} {:#x} = {}", (uint64_t)(a + 1), (uint64_t)(b + 1), result);
+  reg_cmp = (result == 0) ? 0 : ((result < 0) ? -1 : 1);
+}
+
+// Interned strings are deduplicated, so two of them are equal only if they
+// are the same string. Otherwise the cached hashes settle most mismatches
+// before any bytes are compared.
+void VM::streq() {
+  StringHeader *b = string_handle();
+  StringHeader *a = string_handle();
+  bool equal = a == b;
+  if (!equal && !(a->flags & b->flags & STRING_INTERNED)) {
+    equal = a->hash == b->hash && a->length == b->length && std::memcmp(a + 1, b + 1, a->length) == 0;
+  }
+  VM_DEBUG_2("streq {:#x} {:#x} = {}", (uint64_t)(a + 1), (uint64_t)(b + 1), equal);
+  push(&equal, sizeof(equal));
+}
+
+void VM::strhash() {
+  uint64_t hash = string_handle()->hash;
+  push(&hash, sizeof(hash));
+}
+
+void VM::strsub() {
+  uint64_t length = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint64_t begin = load<uint64_t>(pop(sizeof(uint64_t)));
+  StringHeader *source = string_handle();
+  if (begin > source->length || length > source->length - begin) {
+    VM_DEBUG_1("string: substring {}+{} out of bounds ({})", begin, length, source->length);
+    trap(TRAP_BOUNDS);
+    return;
+  }
+  uint8_t *data = new_string(length);
+  if (data == nullptr) {
+    return;
+  }
+  memcpy(data, (uint8_t *)(source + 1) + begin, length);
+  ((StringHeader *)data - 1)->hash = string_hash(data, length);
+  VM_DEBUG_2("strsub {:#x} {}+{} = {:#x}", (uint64_t)(source + 1), begin, length, (uint64_t)data);
+  push(&data, sizeof(data));
+}
+
+void VM::strfree() {
+  StringHeader *header = string_handle();
+  if (reg_trap != TRAP_NONE) {
+    return; // never free trap_scratch
+  }
+  if (header->flags & STRING_INTERNED) {
+    trap(TRAP_BAD_FREE);
+    return;
+  }
+  VM_DEBUG_2("strfree {:#x}", (uint64_t)(header + 1));
+  if (!heap.free(header)) {
+    trap(TRAP_BAD_FREE);
+  }
+}
+
+
+
+void VM::rnew() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  RefHeader *header = (RefHeader *)heap_alloc(sizeof(RefHeader), size, false);
+  if (header == nullptr) {
+    return;
+  }
+  header->count = 1;
+  header->size = size;
+  Ref r = { (uint64_t)(header + 1), 0 };
+  VM_DEBUG_2("rnew {} = {:#x}", size, r.address);
+  push(&r, sizeof(r));
+}
+
+void VM::rnewl() {
+  uint64_t size = load<uint64_t>(pop(sizeof(uint64_t)));
+  RefHeader *header = (RefHeader *)heap_alloc(sizeof(RefHeader), size, true);
+  if (header == nullptr) {
+    return;
+  }
+  header->count = 1;
+  header->size = size;
+  Ref r = { (uint64_t)(header + 1), REF_LOCAL };
+  VM_DEBUG_2("rnewl {} = {:#x}", size, r.address);
+  push(&r, sizeof(r));
+}
+
+void VM::rretain() {
+  Ref r = load<Ref>(operand<Ref>(0));
+  if (r.address == 0 || (r.flags & REF_LOCAL)) {
+    return;
+  }
+  RefHeader *header = ref_header(r);
+  if (header != nullptr) {
+    header->count++;
+  }
+}
+
+void VM::rrelease() {
+  Ref r = load<Ref>(pop(sizeof(Ref)));
+  if (r.address == 0 || (r.flags & REF_LOCAL)) {
+    return;
+  }
+  RefHeader *header = ref_header(r);
+  if (header == nullptr) {
+    return;
+  }
+  if (release_count == VM_RELEASE_BUFFER_SIZE) {
+    flush_releases();
+  }
+  release_buffer[release_count++] = header;
+}
+
+void VM::rflush() {
+  flush_releases();
+}
+
+void VM::rcount() {
+  flush_releases();
+  RefHeader *header = ref_header(load<Ref>(operand<Ref>(0)));
+  if (header == nullptr) {
+    return;
+  }
+  uint64_t count = header->count;
+  push(&count, sizeof(count));
+}
+
+void VM::pushl_ref(VMScope *scope, uint8_t index) {
+  VM_DEBUG_2("pushl_ref {}", index);
+  Ref value = local_as<Ref>(scope, index, _ref);
+  push(&value, sizeof(value));
+}
+
+void VM::popl_ref(VMScope *scope, uint8_t index) {
+  VM_DEBUG_2("popl_ref {}", index);
+  scope->local(index, load<Ref>(pop(sizeof(Ref))));
+}
+
+
+
+#define VM_IMPL_RLOAD(type, native_type) \
+  void VM::rload_##type(uint32_t offset) { \
+    native_type value = load<native_type>(ref_address(offset, sizeof(native_type))); \
+    VM_DEBUG_2("rload_##type +{} = {}", offset, value); \
+    push(&value, sizeof(value)); \
+  }
+
+VM_IMPL_RLOAD(i8, int8_t)
+VM_IMPL_RLOAD(u8, uint8_t)
+VM_IMPL_RLOAD(bool, bool)
+VM_IMPL_RLOAD(i16, int16_t)
+VM_IMPL_RLOAD(u16, uint16_t)
+VM_IMPL_RLOAD(i32, int32_t)
+VM_IMPL_RLOAD(u32, uint32_t)
+VM_IMPL_RLOAD(f32, float)
+VM_IMPL_RLOAD(i64, int64_t)
+VM_IMPL_RLOAD(u64, uint64_t)
+VM_IMPL_RLOAD(f64, double)
+
+#undef VM_IMPL_RLOAD
+
+void VM::rload_ref(uint32_t offset) {
+  Ref value = load<Ref>(ref_address(offset, sizeof(Ref)));
+  push(&value, sizeof(value));
+  rretain();
+}
+
+
+
+#define VM_IMPL_RSTORE(type, native_type) \
+  void VM::rstore_##type(uint32_t offset) { \
+    native_type value = load<native_type>(pop(sizeof(native_type))); \
+    VM_DEBUG_2("rstore_##type +{} = {}", offset, value); \
+    store<native_type>(ref_address(offset, sizeof(native_type)), value); \
+  }
+
+VM_IMPL_RSTORE(i8, int8_t)
+VM_IMPL_RSTORE(u8, uint8_t)
+VM_IMPL_RSTORE(bool, bool)
+VM_IMPL_RSTORE(i16, int16_t)
+VM_IMPL_RSTORE(u16, uint16_t)
+VM_IMPL_RSTORE(i32, int32_t)
+VM_IMPL_RSTORE(u32, uint32_t)
+VM_IMPL_RSTORE(f32, float)
+VM_IMPL_RSTORE(i64, int64_t)
+VM_IMPL_RSTORE(u64, uint64_t)
+VM_IMPL_RSTORE(f64, double)
+
+#undef VM_IMPL_RSTORE
+
+void VM::rstore_ref(uint32_t offset) {
+  Ref value = load<Ref>(pop(sizeof(Ref)));
+  store<Ref>(ref_address(offset, sizeof(Ref)), value);
+}
+
+
+
+#define VM_IMPL_ARRAY(type, native_type) \
+  void VM::anew_##type() { \
+    uint64_t length = load<uint64_t>(pop(sizeof(uint64_t))); \
+    Ref r = new_array(length, sizeof(native_type)); \
+    VM_DEBUG_2("anew_##type {} = {:#x}", length, r.address); \
+    push(&r, sizeof(r)); \
+  } \
+  void VM::aload_##type() { \
+    uint64_t index = load<uint64_t>(pop(sizeof(uint64_t))); \
+    Ref r = load<Ref>(pop(sizeof(Ref))); \
+    native_type value = load<native_type>(array_element(r, index, sizeof(native_type))); \
+    VM_DEBUG_2("aload_##type [{}] = {}", index, value); \
+    push(&value, sizeof(value)); \
+  } \
+  void VM::astore_##type() { \
+    native_type value = load<native_type>(pop(sizeof(native_type))); \
+    uint64_t index = load<uint64_t>(pop(sizeof(uint64_t))); \
+    Ref r = load<Ref>(pop(sizeof(Ref))); \
+    VM_DEBUG_2("astore_##type [{}] = {}", index, value); \
+    store<native_type>(array_element(r, index, sizeof(native_type)), value); \
+  } \
+  void VM::aloadl_##type(VMScope *scope, uint8_t array, uint8_t index) { \
+    uint64_t i = local_as<uint64_t>(scope, index, _u64); \
+    native_type value = load<native_type>(array_element(local_as<Ref>(scope, array, _ref), i, sizeof(native_type))); \
+    VM_DEBUG_2("aloadl_##type #{}[{}] = {}", array, i, value); \
+    push(&value, sizeof(value)); \
+  } \
+  void VM::astorel_##type(VMScope *scope, uint8_t array, uint8_t index) { \
+    native_type value = load<native_type>(pop(sizeof(native_type))); \
+    uint64_t i = local_as<uint64_t>(scope, index, _u64); \
+    VM_DEBUG_2("astorel_##type #{}[{}] = {}", array, i, value); \
+    store<native_type>(array_element(local_as<Ref>(scope, array, _ref), i, sizeof(native_type)), value); \
+  } \
+  void VM::aloadlu_##type(VMScope *scope, uint8_t array, uint8_t index) { \
+    native_type value = load<native_type>(unchecked_element(scope, array, index, sizeof(native_type))); \
+    push(&value, sizeof(value)); \
+  } \
+  void VM::astorelu_##type(VMScope *scope, uint8_t array, uint8_t index) { \
+    native_type value = load<native_type>(pop(sizeof(native_type))); \
+    store<native_type>(unchecked_element(scope, array, index, sizeof(native_type)), value); \
+  }
+
+VM_IMPL_ARRAY(i8, int8_t)
+VM_IMPL_ARRAY(u8, uint8_t)
+VM_IMPL_ARRAY(bool, bool)
+VM_IMPL_ARRAY(i16, int16_t)
+VM_IMPL_ARRAY(u16, uint16_t)
+VM_IMPL_ARRAY(i32, int32_t)
+VM_IMPL_ARRAY(u32, uint32_t)
+VM_IMPL_ARRAY(f32, float)
+VM_IMPL_ARRAY(i64, int64_t)
+VM_IMPL_ARRAY(u64, uint64_t)
+VM_IMPL_ARRAY(f64, double)
+
+#undef VM_IMPL_ARRAY
+
+void VM::alen() {
+  ArrayHeader *header = array_header(load<Ref>(pop(sizeof(Ref))));
+  uint64_t length = header != nullptr ? header->length : 0;
+  push(&length, sizeof(length));
+}
+
+void VM::aslice() {
+  uint64_t end = load<uint64_t>(pop(sizeof(uint64_t)));
+  uint64_t begin = load<uint64_t>(pop(sizeof(uint64_t)));
+  ArrayHeader *source = array_header(load<Ref>(pop(sizeof(Ref))));
+  if (source == nullptr) {
+    return;
+  }
+  if (begin > end || end > source->length) {
+    VM_DEBUG_1("array: slice {}..{} out of bounds ({})", begin, end, source->length);
+    trap(TRAP_BOUNDS);
+    return;
+  }
+  Ref slice = new_array(end - begin, source->element_size);
+  if (slice.address == 0) {
+    return;
+  }
+  memcpy((ArrayHeader *)slice.address + 1, (uint8_t *)(source + 1) + begin * source->element_size, (end - begin) * source->element_size);
+  VM_DEBUG_2("aslice {}..{} = {:#x}", begin, end, slice.address);
+  push(&slice, sizeof(slice));
+}
+
+// Element #`index` of array #`array` for aloadlu/astorelu, which leave the
+// bounds check to an earlier brsize. Only the types of the locals and a
+// null array are checked.
+uint8_t *VM::unchecked_element(VMScope *scope, uint8_t array, uint8_t index, size_t size) {
+  Ref r = local_as<Ref>(scope, array, _ref);
+  uint64_t i = local_as<uint64_t>(scope, index, _u64);
+  if (r.address == 0) {
+    trap(TRAP_NULL);
+    return trap_scratch;
+  }
+  return (uint8_t *)(r.address + sizeof(ArrayHeader)) + i * size;
+}
+
+// Whether local #`array` is not an array (null included) or holds fewer than
+// `bytes` bytes of elements. Either way the checked loop runs, and traps.
+bool VM::array_short(VMScope *scope, uint8_t array, uint64_t bytes) {
+  Ref r = local_as<Ref>(scope, array, _ref);
+  if (!is_array(r)) {
+    return true;
+  }
+  ArrayHeader *header = (ArrayHeader *)r.address;
+  return header->length * header->element_size < bytes;
+}
+
+void VM::brsize(VMScope *scope, uint8_t array, uint64_t bytes, size_t offset) {
+  if (array_short(scope, array, bytes)) {
+    branch(offset);
+  }
+}
+
+
+
+#define VM_IMPL_MOVL(type, native_type) \
+  void VM::movl_##type(VMScope *scope, uint8_t dst, uint8_t src) { \
+    native_type value = local_as<native_type>(scope, src, _##type); \
+    VM_DEBUG_2("movl_##type #{} = #{} ({})", dst, src, value); \
+    *scope->local(dst) = value; \
+  } \
+  void VM::movl2_##type(VMScope *scope, uint8_t dst, uint8_t src, uint8_t dst2, uint8_t src2) { \
+    movl_##type(scope, dst, src); \
+    if (reg_trap == TRAP_NONE) [[likely]] { \
+      movl_##type(scope, dst2, src2); \
+    } \
+  }
+
+VM_IMPL_MOVL(i8, int8_t)
+VM_IMPL_MOVL(u8, uint8_t)
+VM_IMPL_MOVL(bool, bool)
+VM_IMPL_MOVL(i16, int16_t)
+VM_IMPL_MOVL(u16, uint16_t)
+VM_IMPL_MOVL(i32, int32_t)
+VM_IMPL_MOVL(u32, uint32_t)
+VM_IMPL_MOVL(f32, float)
+VM_IMPL_MOVL(i64, int64_t)
+VM_IMPL_MOVL(u64, uint64_t)
+VM_IMPL_MOVL(f64, double)
+
+#undef VM_IMPL_MOVL
+
+
+
+// Same results as `pushl a; pushl b; <op>; popl dst; pop`, which is what the
+// assembler lowers to these.
+#define VM_IMPL_ARITHL(name, type, native_type, op) \
+  void VM::name##l_##type(VMScope *scope, uint8_t dst, uint8_t a, uint8_t b) { \
+    native_type x = local_as<native_type>(scope, a, _##type); \
+    native_type y = local_as<native_type>(scope, b, _##type); \
+    VM_DEBUG_2(#name "l_" #type " #{} = {} " #op " {}", dst, x, y); \
+    *scope->local(dst) = (native_type)(x op y); \
+  }
+
+VM_IMPL_ARITHL(add, i8, int8_t, +)
+VM_IMPL_ARITHL(add, u8, uint8_t, +)
+VM_IMPL_ARITHL(add, i16, int16_t, +)
+VM_IMPL_ARITHL(add, u16, uint16_t, +)
+VM_IMPL_ARITHL(add, i32, int32_t, +)
+VM_IMPL_ARITHL(add, u32, uint32_t, +)
+VM_IMPL_ARITHL(add, f32, float, +)
+VM_IMPL_ARITHL(add, i64, int64_t, +)
+VM_IMPL_ARITHL(add, u64, uint64_t, +)
+VM_IMPL_ARITHL(add, f64, double, +)
+
+VM_IMPL_ARITHL(sub, i8, int8_t, -)
+VM_IMPL_ARITHL(sub, u8, uint8_t, -)
+VM_IMPL_ARITHL(sub, i16, int16_t, -)
+VM_IMPL_ARITHL(sub, u16, uint16_t, -)
+VM_IMPL_ARITHL(sub, i32, int32_t, -)
+VM_IMPL_ARITHL(sub, u32, uint32_t, -)
+VM_IMPL_ARITHL(sub, f32, float, -)
+VM_IMPL_ARITHL(sub, i64, int64_t, -)
+VM_IMPL_ARITHL(sub, u64, uint64_t, -)
+VM_IMPL_ARITHL(sub, f64, double, -)
+
+VM_IMPL_ARITHL(mul, i8, int8_t, *)
+VM_IMPL_ARITHL(mul, u8, uint8_t, *)
+VM_IMPL_ARITHL(mul, i16, int16_t, *)
+VM_IMPL_ARITHL(mul, u16, uint16_t, *)
+VM_IMPL_ARITHL(mul, i32, int32_t, *)
+VM_IMPL_ARITHL(mul, u32, uint32_t, *)
+VM_IMPL_ARITHL(mul, f32, float, *)
+VM_IMPL_ARITHL(mul, i64, int64_t, *)
+VM_IMPL_ARITHL(mul, u64, uint64_t, *)
+VM_IMPL_ARITHL(mul, f64, double, *)
+
+#undef VM_IMPL_ARITHL
+
+
+
+// On division by zero the divisor is left in `dst`, as `div_<n>` leaves it on
+// the stack; the smallest signed value divided by -1 is handled as there too.
+#define VM_IMPL_DIVL(type, native_type) \
+  void VM::divl_##type(VMScope *scope, uint8_t dst, uint8_t a, uint8_t b) { \
+    native_type x = local_as<native_type>(scope, a, _##type); \
+    native_type y = local_as<native_type>(scope, b, _##type); \
+    if (y == 0) { \
+      VM_DEBUG_2("divl_##type {} / 0 = undefined", x); \
+      reg_err = 1; \
+      counters.errors++; \
+      *scope->local(dst) = y; \
+    } else if (div_overflows(x, y)) { \
+      VM_DEBUG_2("divl_##type {} / -1 overflows", x); \
+      reg_err = 1; \
+      counters.errors++; \
+      *scope->local(dst) = x; \
+    } else { \
+      VM_DEBUG_2("divl_##type #{} = {} / {}", dst, x, y); \
+      *scope->local(dst) = (native_type)(x / y); \
+    } \
+  }
+
+VM_IMPL_DIVL(i8, int8_t)
+VM_IMPL_DIVL(u8, uint8_t)
+VM_IMPL_DIVL(i16, int16_t)
+VM_IMPL_DIVL(u16, uint16_t)
+VM_IMPL_DIVL(i32, int32_t)
+VM_IMPL_DIVL(u32, uint32_t)
+VM_IMPL_DIVL(f32, float)
+VM_IMPL_DIVL(i64, int64_t)
+VM_IMPL_DIVL(u64, uint64_t)
+VM_IMPL_DIVL(f64, double)
+
+#undef VM_IMPL_DIVL
+
+
+
+#define VM_IMPL_REML(type, native_type, remfn) \
+  void VM::reml_##type(VMScope *scope, uint8_t dst, uint8_t a, uint8_t b) { \
+    native_type x = local_as<native_type>(scope, a, _##type); \
+    native_type y = local_as<native_type>(scope, b, _##type); \
+    if (y == 0) { \
+      VM_DEBUG_2("reml_##type {} % 0 = undefined", x); \
+      reg_err = 1; \
+      counters.errors++; \
+      *scope->local(dst) = y; \
+    } else if (div_overflows(x, y)) { \
+      *scope->local(dst) = (native_type)0; \
+    } else { \
+      VM_DEBUG_2("reml_##type #{} = {} % {}", dst, x, y); \
+      *scope->local(dst) = (native_type)remfn(x, y); \
+    } \
+  }
+
+#define VM_REM_INT(x, y) ((x) % (y))
+
+VM_IMPL_REML(i8, int8_t, VM_REM_INT)
+VM_IMPL_REML(u8, uint8_t, VM_REM_INT)
+VM_IMPL_REML(i16, int16_t, VM_REM_INT)
+VM_IMPL_REML(u16, uint16_t, VM_REM_INT)
+VM_IMPL_REML(i32, int32_t, VM_REM_INT)
+VM_IMPL_REML(u32, uint32_t, VM_REM_INT)
+VM_IMPL_REML(f32, float, fmodf32)
+VM_IMPL_REML(i64, int64_t, VM_REM_INT)
+VM_IMPL_REML(u64, uint64_t, VM_REM_INT)
+VM_IMPL_REML(f64, double, fmodf64)
+
+#undef VM_IMPL_REML
+#undef VM_REM_INT
+
+
+
+#define VM_IMPL_CMPL(type, native_type) \
+  void VM::cmpl_##type(VMScope *scope, uint8_t a, uint8_t b) { \
+    native_type x = local_as<native_type>(scope, a, _##type); \
+    native_type y = local_as<native_type>(scope, b, _##type); \
+    VM_DEBUG_2("cmpl_##type {} {}", x, y); \
+    reg_cmp = (x == y) ? 0 : ((x < y) ? -1 : 1); \
+  } \
+  void VM::cmpli_##type(native_type value, VMScope *scope, uint8_t index) { \
+    native_type x = local_as<native_type>(scope, index, _##type); \
+    VM_DEBUG_2("cmpli_##type {} {}", x, value); \
+    reg_cmp = (x == value) ? 0 : ((x < value) ? -1 : 1); \
+  } \
+  void VM::cmpi_##type(native_type value) { \
+    native_type x = load<native_type>(operand<native_type>(0)); \
+    VM_DEBUG_2("cmpi_##type {} {}", x, value); \
+    reg_cmp = (x == value) ? 0 : ((x < value) ? -1 : 1); \
+  }
+
+VM_IMPL_CMPL(i8, int8_t)
+VM_IMPL_CMPL(u8, uint8_t)
+VM_IMPL_CMPL(i16, int16_t)
+VM_IMPL_CMPL(u16, uint16_t)
+VM_IMPL_CMPL(i32, int32_t)
+VM_IMPL_CMPL(u32, uint32_t)
+VM_IMPL_CMPL(f32, float)
+VM_IMPL_CMPL(i64, int64_t)
+VM_IMPL_CMPL(u64, uint64_t)
+VM_IMPL_CMPL(f64, double)
+
+#undef VM_IMPL_CMPL
+
+
+
+// Same outcome as `cmp_<n>; pop; pop; j<c>`, but reg_cmp is left untouched.
+#define VM_IMPL_BR(type, native_type) \
+  int8_t VM::br_compare_##type() { \
+    native_type b = load<native_type>(pop(sizeof(native_type))); \
+    native_type a = load<native_type>(pop(sizeof(native_type))); \
+    VM_DEBUG_2("br_##type {} {}", a, b); \
+    return (a == b) ? 0 : ((a < b) ? -1 : 1); \
+  } \
+  void VM::br_z_##type(size_t offset)  { if (br_compare_##type() == 0)  { branch(offset); } } \
+  void VM::br_nz_##type(size_t offset) { if (br_compare_##type() != 0)  { branch(offset); } } \
+  void VM::br_l_##type(size_t offset)  { if (br_compare_##type() == -1) { branch(offset); } } \
+  void VM::br_g_##type(size_t offset)  { if (br_compare_##type() == 1)  { branch(offset); } } \
+  void VM::br_nl_##type(size_t offset) { if (br_compare_##type() != -1) { branch(offset); } } \
+  void VM::br_ng_##type(size_t offset) { if (br_compare_##type() != 1)  { branch(offset); } }
+
+VM_IMPL_BR(i8, int8_t)
+VM_IMPL_BR(u8, uint8_t)
+VM_IMPL_BR(i16, int16_t)
+VM_IMPL_BR(u16, uint16_t)
+VM_IMPL_BR(i32, int32_t)
+VM_IMPL_BR(u32, uint32_t)
+VM_IMPL_BR(f32, float)
+VM_IMPL_BR(i64, int64_t)
+VM_IMPL_BR(u64, uint64_t)
+VM_IMPL_BR(f64, double)
+
+#undef VM_IMPL_BR
+
+
+
+#define VM_IMPL_LOOP(type, native_type) \
+  int8_t VM::loop_step_##type(native_type limit, VMScope *scope, uint8_t index) { \
+    native_type x = local_as<native_type>(scope, index, _##type) + 1; \
+    VM_DEBUG_2("loop_##type #{} = {} < {}", index, x, limit); \
+    scope->local(index, x); \
+    return reg_cmp = (x == limit) ? 0 : ((x < limit) ? -1 : 1); \
+  } \
+  void VM::loop_##type(native_type limit, VMScope *scope, uint8_t index, size_t offset) { \
+    if (loop_step_##type(limit, scope, index) == -1) { branch(offset); } \
+  } \
+  int8_t VM::djnz_step_##type(VMScope *scope, uint8_t index) { \
+    native_type x = local_as<native_type>(scope, index, _##type) - 1, zero = 0; \
+    VM_DEBUG_2("djnz_##type #{} = {}", index, x); \
+    scope->local(index, x); \
+    return reg_cmp = (x == zero) ? 0 : ((x < zero) ? -1 : 1); \
+  } \
+  void VM::djnz_##type(VMScope *scope, uint8_t index, size_t offset) { \
+    if (djnz_step_##type(scope, index) != 0) { branch(offset); } \
+  } \
+  int8_t VM::loopt_step_##type(native_type limit) { \
+    void *top = operand<native_type>(0); \
+    native_type x = load<native_type>(top); \
+    VM_DEBUG_2("loopt_##type {} < {}", x, limit); \
+    reg_cmp = (x == limit) ? 0 : ((x < limit) ? -1 : 1); \
+    if (reg_cmp == -1) { \
+      store<native_type>(top, x + 1); \
+    } \
+    return reg_cmp; \
+  } \
+  void VM::loopt_##type(native_type limit, size_t offset) { \
+    if (loopt_step_##type(limit) == -1) { branch(offset); } \
+  }
+
+VM_IMPL_LOOP(i8, int8_t)
+VM_IMPL_LOOP(u8, uint8_t)
+VM_IMPL_LOOP(i16, int16_t)
+VM_IMPL_LOOP(u16, uint16_t)
+VM_IMPL_LOOP(i32, int32_t)
+VM_IMPL_LOOP(u32, uint32_t)
+VM_IMPL_LOOP(f32, float)
+VM_IMPL_LOOP(i64, int64_t)
+VM_IMPL_LOOP(u64, uint64_t)
+VM_IMPL_LOOP(f64, double)
+
+#undef VM_IMPL_LOOP
+
+
+
 void VM::jz(size_t offset) {
   VM_DEBUG_1("jz {:#08x} ({})", offset, reg_cmp == 0);
   if (reg_cmp == 0) {
-    instruction = program + offset;
+    branch(offset);
   }
 }
 void VM::jnz(size_t offset) {
   VM_DEBUG_1("jnz {:#08x} ({})", offset, reg_cmp != 0);
   if (reg_cmp != 0) {
-    instruction = program + offset;
+    branch(offset);
   }
 }
 void VM::jl(size_t offset) {
   VM_DEBUG_1("jl {:#08x} ({})", offset, reg_cmp == -1);
   if (reg_cmp == -1) {
-    instruction = program + offset;
+    branch(offset);
   }
 }
 void VM::jg(size_t offset) {
   VM_DEBUG_1("jg {:#08x} ({})", offset, reg_cmp == 1);
   if (reg_cmp == 1) {
-    instruction = program + offset;
+    branch(offset);
   }
 }
 void VM::jnl(size_t offset) {
   VM_DEBUG_1("jnl {:#08x} ({})", offset, reg_cmp != -1);
   if (reg_cmp != -1) {
-    instruction = program + offset;
+    branch(offset);
   }
 }
 void VM::jng(size_t offset) {
   VM_DEBUG_1("jng {:#08x} ({})", offset, reg_cmp != 1);
   if (reg_cmp != 1) {
-    instruction = program + offset;
+    branch(offset);
   }
 }
 void VM::jmp(size_t offset) {
   VM_DEBUG_1("jmp {:#08x}", offset);
-  instruction = program + offset;
+  branch(offset);
+}
+void VM::jerr(size_t offset) {
+  VM_DEBUG_1("jerr {:#08x} ({})", offset, reg_err != 0);
+  if (reg_err != 0) {
+    branch(offset);
+  }
+}
+void VM::clrerr() {
+  reg_err = 0;
+}
+
+void VM::register_native(uint16_t index, NativeFunction function) {
+  if (index >= native_table.size()) {
+    native_table.resize(index + 1);
+  }
+  native_table[index] = function;
+}
+
+void VM::callnative(uint16_t index) {
+  if (index >= native_table.size() || native_table[index].call == nullptr) {
+    VM_DEBUG_1("callnative: no function at index {}", index);
+    trap(TRAP_NO_NATIVE);
+    return;
+  }
+  VM_DEBUG_1("callnative {} ({})", index, native_table[index].name);
+  native_table[index].call(*this);
+}
+
+void VM::awaitnative(uint16_t index) {
+  callnative(index);
+  stop_request = RUN_YIELDED;
+}
+
+void VM::yield() {
+  VM_DEBUG_1("yield @ {}", (size_t)instruction - (size_t)program);
+  stop_request = RUN_YIELDED;
 }
 
 
@@ -650,20 +3272,36 @@ void VM::dbg(int8_t i) {
   (void)i; // unused when debugging is disabled
   VM_DEBUG_1("dbg: {} @ {}", i, (size_t)instruction - (size_t)program);
   // Dump stack
-  VM_DEBUG_1("\t...\tstack (stack = {:#08x}, stack_top = {:#08x}, delta(stack -> top) = {}):",
-    (size_t) &stack, (size_t) stack_top,
-     (int64_t) stack_top - (int64_t) &stack
+  VM_DEBUG_1("\t...\tstack (stack = {:#08x}, sp = {:#08x}, depth = {}):",
+    (size_t) &stack, (size_t) sp,
+     (int64_t) sp - (int64_t) &stack
   );
-  for (int64_t i = 0; i <= stack_top - stack; i++) {
+  for (int64_t i = 0; i < sp - stack; i++) {
     VM_DEBUG_1("\t{:#08x}\t{:#02x}\t{}", (size_t) &stack[i], (size_t) stack[i], stack[i]);
   }
-  VM_DEBUG_1("\t...\t*stack_top = {}", *stack_top);
   VM_DEBUG_1("\t...\tlocals:");
-  for (size_t i = 0; scope.local(i)->get_type() != _none; i++) {
+  for (size_t i = 0; i < VM_SCOPE_LOCALS_SIZE && scope.local(i)->get_type() != _none; i++) {
     VM_DEBUG_1("\t#{}: ({}) = {}", i, scope.local(i)->get_type_name(), scope.local(i)->get_value_string());
   }
 }
 
+void VM::ontrap(size_t offset) {
+  VM_DEBUG_1("ontrap {:#08x}", offset);
+  trap_handler = offset;
+  trap_depth = sp - stack;
+}
+
+void VM::offtrap() {
+  trap_handler = VM_NO_TRAP_HANDLER;
+}
+
+void VM::raise() {
+  uint8_t code = load<uint8_t>(pop(sizeof(uint8_t)));
+  if (code != TRAP_NONE) {
+    trap((TrapCode)code);
+  }
+}
+
 void VM::sig(int8_t i) {
   VM_DEBUG_1("********************************** Received signal: {} ********************************** ", i);
   dbg(i);
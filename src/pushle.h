@@ -3,12 +3,31 @@
 #include <cassert>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <array>
+#include <chrono>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "heap.h"
+#include "metrics.h"
+#include "module.h"
 #include "ops.h"
+#include "simd.h"
+#include "trace.h"
 
 #include <fmt/core.h>
 
+// When enabled, every stack value occupies its own 8-byte aligned slot instead
+// of being packed at its natural width. See "Stack" in spec.md.
+#ifndef VM_SLOT_STACK
+#define VM_SLOT_STACK 0
+#endif
+
+// Compile-time debug output, printed as it happens. To record a run without
+// rebuilding, use a Tracer (trace.h) instead.
 #ifndef VM_DEBUG_LEVEL
 #define VM_DEBUG_LEVEL 0
 #endif
@@ -65,6 +84,18 @@
   return_type prefix##u64(__VA_ARGS__); \
   return_type prefix##f64(__VA_ARGS__); \
 
+#define _FN_N_T(return_type, prefix, ...) \
+  return_type prefix##i8(int8_t __VA_ARGS__); \
+  return_type prefix##u8(uint8_t __VA_ARGS__); \
+  return_type prefix##i16(int16_t __VA_ARGS__); \
+  return_type prefix##u16(uint16_t __VA_ARGS__); \
+  return_type prefix##i32(int32_t __VA_ARGS__); \
+  return_type prefix##u32(uint32_t __VA_ARGS__); \
+  return_type prefix##f32(float __VA_ARGS__); \
+  return_type prefix##i64(int64_t __VA_ARGS__); \
+  return_type prefix##u64(uint64_t __VA_ARGS__); \
+  return_type prefix##f64(double __VA_ARGS__);
+
 #define _FN_I(return_type, prefix, ...) \
   return_type prefix##i8(__VA_ARGS__); \
   return_type prefix##i16(__VA_ARGS__); \
@@ -73,16 +104,127 @@
   return_type prefix##i64(__VA_ARGS__); \
   return_type prefix##f64(__VA_ARGS__);
 
+#define _FN_F(return_type, prefix, ...) \
+  return_type prefix##f32(__VA_ARGS__); \
+  return_type prefix##f64(__VA_ARGS__);
+
+#define _FN_Z(return_type, prefix, ...) \
+  return_type prefix##i8(__VA_ARGS__); \
+  return_type prefix##u8(__VA_ARGS__); \
+  return_type prefix##i16(__VA_ARGS__); \
+  return_type prefix##u16(__VA_ARGS__); \
+  return_type prefix##i32(__VA_ARGS__); \
+  return_type prefix##u32(__VA_ARGS__); \
+  return_type prefix##i64(__VA_ARGS__); \
+  return_type prefix##u64(__VA_ARGS__);
+
 #define _FN_S(return_type, prefix, ...) \
   return_type prefix##1(__VA_ARGS__); \
   return_type prefix##2(__VA_ARGS__); \
   return_type prefix##4(__VA_ARGS__); \
-  return_type prefix##8(__VA_ARGS__);
+  return_type prefix##8(__VA_ARGS__); \
+  return_type prefix##16(__VA_ARGS__);
+
+#define _FN_W(return_type, prefix, ...) \
+  return_type prefix##i128(__VA_ARGS__); \
+  return_type prefix##u128(__VA_ARGS__); \
+  return_type prefix##f128(__VA_ARGS__);
+
+#define _FN_W_T(return_type, prefix, ...) \
+  return_type prefix##i128(int128_t __VA_ARGS__); \
+  return_type prefix##u128(uint128_t __VA_ARGS__); \
+  return_type prefix##f128(float128_t __VA_ARGS__);
 
 namespace pushle {
   const size_t VM_STACK_SIZE = 1024 * 1024;
   const size_t VM_CALL_STACK_SIZE = 1024;
-  const size_t VM_SCOPE_LOCALS_SIZE = 0xff;
+  const size_t VM_SCOPE_LOCALS_SIZE = 0x100;
+  const size_t VM_SLOT_SIZE = 8;
+  const size_t VM_RELEASE_BUFFER_SIZE = 256;
+  const uint64_t VM_NO_BUDGET = UINT64_MAX;
+  const size_t VM_NO_TRAP_HANDLER = SIZE_MAX;
+  const size_t VM_TRAP_SCRATCH_SIZE = 256; // covers the widest single operand
+
+  // Native types of i128, u128 and f128. These are compiler extensions, as
+  // the standard has no 128-bit integers and std::float128_t is optional.
+  using int128_t = __int128;
+  using uint128_t = unsigned __int128;
+  using float128_t = __float128;
+
+  // Why run() or resume() returned. A VM that yielded or ran out of budget
+  // keeps all of its state and continues where it stopped on resume().
+  enum RunStatus {
+    RUN_DONE,    // reached the end of the code or a `sig`
+    RUN_YIELDED, // executed `yield` or `awaitnative`
+    RUN_BUDGET,  // took the number of backward branches it was given
+    RUN_TRAPPED, // raised a trap that no handler caught, see VM::trap_code()
+  };
+
+  // Faults detected while executing. The instruction that raised one finishes
+  // on harmless placeholder values, then the VM either enters the handler set
+  // with `ontrap` or stops with RUN_TRAPPED. Codes from TRAP_USER up are free
+  // for programs to raise with `raise`.
+  enum TrapCode : uint8_t {
+    TRAP_NONE,
+    TRAP_CODE_BOUNDS,     // an instruction runs past the end of the code
+    TRAP_BAD_OPCODE,
+    TRAP_STACK_OVERFLOW,
+    TRAP_STACK_UNDERFLOW,
+    TRAP_NULL,            // null heap address, ref, array or string
+    TRAP_BOUNDS,          // index or range outside an array, string, heap block, constant pool or strings section
+    TRAP_TOO_LARGE,       // array or string length
+    TRAP_BAD_FREE,        // hfree or strfree on a block the heap did not allocate
+    TRAP_NO_NATIVE,       // callnative on an empty index
+    TRAP_TYPE,            // a local read as another type than it holds
+    TRAP_USER = 128,
+  };
+
+  const char *trap_name(TrapCode code);
+
+  // Number of stack bytes taken up by a value of `size` bytes.
+  constexpr size_t stack_width(size_t size) {
+#if VM_SLOT_STACK
+    return (size + VM_SLOT_SIZE - 1) & ~(VM_SLOT_SIZE - 1);
+#else
+    return size;
+#endif
+  }
+
+  // Stack and bytecode memory is untyped; go through memcpy rather than
+  // casting so that unaligned and differently-typed accesses are well defined.
+  template <typename T>
+  inline T load(const void *src) {
+    T value;
+    memcpy(&value, src, sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  inline void store(void *dst, T value) {
+    memcpy(dst, &value, sizeof(T));
+  }
+
+  // A `ref` as it appears on the stack and in locals. `address` points at the
+  // object payload, which is preceded by its RefHeader.
+  struct Ref {
+    uint64_t address;
+    uint64_t flags;
+  };
+
+  // Set on refs the assembler proved never escape; their count is not kept
+  // and their storage is released with the rest of the temporary heap.
+  const uint64_t REF_LOCAL = 1;
+
+  struct RefHeader {
+    uint64_t count;
+    uint64_t size;
+  };
+
+  // Payload of an array object; the elements follow it.
+  struct ArrayHeader {
+    uint64_t length;
+    uint64_t element_size;
+  };
 
   class Value {
   public:
@@ -99,6 +241,10 @@ namespace pushle {
     Value(int64_t v)     : _type(_i64),  value({ ._i64 = v }) {}
     Value(uint64_t v)    : _type(_u64),  value({ ._u64 = v }) {}
     Value(double v)      : _type(_f64),  value({ ._f64 = v }) {}
+    Value(Ref v)         : _type(_ref),  value({ ._ref = v }) {}
+    Value(int128_t v)    : _type(_i128), value({ ._i128 = v }) {}
+    Value(uint128_t v)   : _type(_u128), value({ ._u128 = v }) {}
+    Value(float128_t v)  : _type(_f128), value({ ._f128 = v }) {}
 
     operator int8_t() const { return value._i8; }
     operator uint8_t() const { return value._u8; }
@@ -111,6 +257,10 @@ namespace pushle {
     operator int64_t() const { return value._i64; }
     operator uint64_t() const { return value._u64; }
     operator double() const { return value._f64; }
+    operator Ref() const { return value._ref; }
+    operator int128_t() const { return value._i128; }
+    operator uint128_t() const { return value._u128; }
+    operator float128_t() const { return value._f128; }
 
     Value& operator=(int8_t v) { _type = _i8; value._i8 = v; return *this; }
     Value& operator=(uint8_t v) { _type = _u8; value._u8 = v; return *this; }
@@ -123,6 +273,10 @@ namespace pushle {
     Value& operator=(int64_t v) { _type = _i64; value._i64 = v; return *this; }
     Value& operator=(uint64_t v) { _type = _u64; value._u64 = v; return *this; }
     Value& operator=(double v) { _type = _f64; value._f64 = v; return *this; }
+    Value& operator=(Ref v) { _type = _ref; value._ref = v; return *this; }
+    Value& operator=(int128_t v) { _type = _i128; value._i128 = v; return *this; }
+    Value& operator=(uint128_t v) { _type = _u128; value._u128 = v; return *this; }
+    Value& operator=(float128_t v) { _type = _f128; value._f128 = v; return *this; }
 
     // ~Value();
 
@@ -144,6 +298,10 @@ namespace pushle {
         case _i64: return "i64";
         case _u64: return "u64";
         case _f64: return "f64";
+        case _ref: return "ref";
+        case _i128: return "i128";
+        case _u128: return "u128";
+        case _f128: return "f128";
         default: return "UNKNOWN";
       }
     }
@@ -162,6 +320,10 @@ namespace pushle {
         case _i64: return std::to_string(value._i64);
         case _u64: return std::to_string(value._u64);
         case _f64: return std::to_string(value._f64);
+        case _ref: return std::to_string(value._ref.address);
+        case _i128: return fmt::format("{}", value._i128);
+        case _u128: return fmt::format("{}", value._u128);
+        case _f128: return std::to_string((long double)value._f128);
         default: return "UNKNOWN";
       }
     }
@@ -183,6 +345,10 @@ namespace pushle {
         case _u64:
         case _f64:
           return 8;
+        case _ref:
+        case _i128:
+        case _u128:
+        case _f128:
           return 16;
         default:
           return 0;
@@ -244,6 +410,26 @@ namespace pushle {
       return value._f64;
     }
 
+    inline Ref as_ref_safe() const {
+      assert(_type == _ref);
+      return value._ref;
+    }
+
+    inline int128_t as_i128_safe() const {
+      assert(_type == _i128);
+      return value._i128;
+    }
+
+    inline uint128_t as_u128_safe() const {
+      assert(_type == _u128);
+      return value._u128;
+    }
+
+    inline float128_t as_f128_safe() const {
+      assert(_type == _f128);
+      return value._f128;
+    }
+
 
   private:
     DataType _type;
@@ -259,6 +445,10 @@ namespace pushle {
       int64_t _i64;
       uint64_t _u64;
       double _f64;
+      Ref _ref;
+      int128_t _i128;
+      uint128_t _u128;
+      float128_t _f128;
     } value;
   };
 
@@ -267,69 +457,266 @@ namespace pushle {
     VMScope() = default;
     ~VMScope() = default;
 
-    inline Value *local(size_t index) {
-      assert(index < VM_SCOPE_LOCALS_SIZE);
+    // Local operands are a u8, so every index they encode names a local.
+    inline Value *local(uint8_t index) {
       return &locals[index];
     }
 
-    inline void local(size_t index, Value value) {
-      assert(index < VM_SCOPE_LOCALS_SIZE);
+    inline void local(uint8_t index, Value value) {
       locals[index] = value;
     }
   private:
+    static_assert(VM_SCOPE_LOCALS_SIZE > UINT8_MAX);
     Value locals[VM_SCOPE_LOCALS_SIZE];
   };
 
+  class VM;
+
+  // Entry in the VM's native function table, called by `callnative index`.
+  // `call` is a trampoline generated by VM::native<F>() that reads the
+  // arguments straight off the stack, calls F and pushes its result.
+  struct NativeFunction {
+    std::string name;
+    std::vector<DataType> parameters; // in push order, the last one is on top
+    DataType result;                  // _none for functions returning void
+    void (*call)(VM &vm);
+  };
+
+  template <auto F, typename Signature = decltype(F)>
+  struct NativeBinding;
+
+  // Specialized by code generated with the aot tool, which calls the VM's op
+  // handlers directly instead of going through step().
+  template <typename Program>
+  struct AotProgram;
+
   class VM {
+    template <typename Program>
+    friend struct AotProgram;
+    template <auto F, typename Signature>
+    friend struct NativeBinding;
+
   public:
     VM();
-    void run(const uint8_t *program, size_t size);
-    inline int8_t get_i8() { return *(int8_t *)ref(sizeof(int8_t)); }
-    inline uint8_t get_u8() { return *(uint8_t *)ref(sizeof(uint8_t)); }
-    inline bool get_bool() { return *(bool *)ref(sizeof(bool)); }
-    inline int16_t get_i16() { return *(int16_t *)ref(sizeof(int16_t)); }
-    inline uint16_t get_u16() { return *(uint16_t *)ref(sizeof(uint16_t)); }
-    inline int32_t get_i32() { return *(int32_t *)ref(sizeof(int32_t)); }
-    inline uint32_t get_u32() { return *(uint32_t *)ref(sizeof(uint32_t)); }
-    inline float get_f32() { return *(float *)ref(sizeof(float)); }
-    inline int64_t get_i64() { return *(int64_t *)ref(sizeof(int64_t)); }
-    inline uint64_t get_u64() { return *(uint64_t *)ref(sizeof(uint64_t)); }
-    inline double get_f64() { return *(double *)ref(sizeof(double)); }
+    ~VM();
+    RunStatus run(const Module &module);
+    // Starts at byte `entry` of the code section instead of its beginning.
+    RunStatus run(const Module &module, size_t entry);
+    RunStatus run(const uint8_t *program, size_t size);
+    // start() prepares a run without executing anything; resume() then runs
+    // until the end of the program, a yield, or until it has taken `budget`
+    // backward branches. Nothing is copied on suspension: the stack, locals
+    // and registers simply stay in the VM until the next resume(). An `entry`
+    // past the end of the code raises TRAP_BOUNDS at that offset instead.
+    void start(const Module &module, size_t entry = 0);
+    RunStatus resume(uint64_t budget = VM_NO_BUDGET);
+    // Clears the stack, locals and registers and releases the whole heap.
+    void reset();
+    // Records every instruction into `tracer` from the next resume() on, or
+    // stops recording if it is nullptr. The tracer must outlive its use.
+    inline void trace(Tracer *tracer) { this->tracer = tracer; }
+    inline const HeapStats &heap_stats() const { return heap.stats(); }
+    // Counters since the VM was created. They are not synchronized: read them
+    // while the VM is not running, or use global_metrics().
+    Metrics metrics() const;
+    inline int8_t get_i8() { return result<int8_t>(); }
+    inline uint8_t get_u8() { return result<uint8_t>(); }
+    inline bool get_bool() { return result<bool>(); }
+    inline int16_t get_i16() { return result<int16_t>(); }
+    inline uint16_t get_u16() { return result<uint16_t>(); }
+    inline int32_t get_i32() { return result<int32_t>(); }
+    inline uint32_t get_u32() { return result<uint32_t>(); }
+    inline float get_f32() { return result<float>(); }
+    inline int64_t get_i64() { return result<int64_t>(); }
+    inline uint64_t get_u64() { return result<uint64_t>(); }
+    inline double get_f64() { return result<double>(); }
+    inline int128_t get_i128() { return result<int128_t>(); }
+    inline uint128_t get_u128() { return result<uint128_t>(); }
+    inline float128_t get_f128() { return result<float128_t>(); }
+
+    // Embedding. Values pushed before run() are the program's inputs and the
+    // values it leaves on the stack are its results, read in place. Spans are
+    // passed by address, so the program works on host memory with hload_<t>
+    // and hstore_<t> without copying it; it must not hfree them. The VM keeps
+    // the `size` bytes at `data` accessible until reset(). These do not trap:
+    // a push the stack has no room for returns false and pushes nothing.
+    template <typename T>
+    inline bool push_arg(T value) { return host_push(&value, sizeof(T)); }
+    bool push_span(void *data, size_t size);
+    // The `depth`-th value of type T below the top of the stack, or 0 if the
+    // stack holds fewer values, which has_result() tells apart.
+    template <typename T>
+    inline T result(size_t depth = 0) {
+      void *value = host_ref(stack_width(sizeof(T)) * (depth + 1));
+      return value != nullptr ? load<T>(value) : T();
+    }
+    template <typename T>
+    inline bool has_result(size_t depth = 0) { return host_ref(stack_width(sizeof(T)) * (depth + 1)) != nullptr; }
+    // Memory addressed by the `depth`-th u64 below the top of the stack.
+    template <typename T>
+    inline T *result_span(size_t depth = 0) { return (T *)result<uint64_t>(depth); }
+    inline size_t stack_depth() const { return sp - stack; }
+    // The trap that stopped the VM (TRAP_NONE if none) and the code offset of
+    // the instruction that raised it. start() and reset() clear it.
+    inline TrapCode trap_code() const { return reg_trap; }
+    inline size_t trap_offset() const { return trap_at; }
+
+    // Makes a host function callable with `callnative index`. Build the entry
+    // with native<F>(name), where F is a plain function taking and returning
+    // native types (or void); its signature is recorded in the table.
+    void register_native(uint16_t index, NativeFunction function);
+    template <auto F>
+    static NativeFunction native(std::string name);
+    inline const std::vector<NativeFunction> &natives() const { return native_table; }
 
   private:
-    uint8_t stack[VM_STACK_SIZE];
-    uint8_t *stack_top;
+    alignas(VM_SLOT_SIZE) uint8_t stack[VM_STACK_SIZE];
+    uint8_t *sp; // one past the last byte pushed; the stack is empty when sp == stack
+    uint8_t *stack_peak; // highest sp so far
 
     const uint8_t *program;
     size_t program_size;
     const uint8_t *instruction;
+    const uint8_t *constants;
+    size_t constant_count;
+    const uint8_t *strings;
+    size_t strings_size;
     // uint8_t *call_stack[VM_CALL_STACK_SIZE];
     // uint8_t **call_stack_top;
     // uint8_t **call_stack_next;
 
     VMScope scope; // TODO: make this a stack
 
+    const simd::KernelTable *vec;
+
     int8_t reg_cmp;
     int8_t reg_err;
+    TrapCode reg_trap;
+    size_t trap_at;      // code offset of the faulting instruction
+    size_t trap_handler; // set by ontrap, VM_NO_TRAP_HANDLER if none
+    size_t trap_depth;   // stack depth restored on entering the handler
+    alignas(16) uint8_t trap_scratch[VM_TRAP_SCRATCH_SIZE]; // stands in for faulting operands
+    RunStatus stop_request; // returned by resume() after the current step; RUN_DONE if none
+    uint64_t budget;        // backward branches left before resume() returns RUN_BUDGET
     void *reg_ret; // TODO
-    // TODO: heap
+
+    Heap heap;
+    Tracer *tracer;
+    Metrics counters;
+    Metrics published; // metrics() as of the last publish_metrics()
+    std::vector<NativeFunction> native_table;
+    std::vector<std::pair<uint8_t *, size_t>> spans; // host memory from push_span()
+    RefHeader *release_buffer[VM_RELEASE_BUFFER_SIZE]; // pending decrements
+    size_t release_count;
 
     void *read(size_t size);
+    void branch(size_t offset);
     bool step(); // returns false if VM is finished
-    void push(void *value, size_t size);
+    template <bool Traced>
+    RunStatus dispatch();
+    void trace_step();
+    bool stopped(const uint8_t *start, RunStatus &status);
+    void trap(TrapCode code);
+    size_t enter_trap_handler();
+    void end_slice(std::chrono::steady_clock::time_point begin);
+    void push(const void *value, size_t size);
+    bool host_push(const void *value, size_t size);
+    void *host_ref(size_t offset);
     void *pop(size_t size);
     void *ref(size_t offset);
+    const uint8_t *constant(size_t index);
+    void *heap_alloc(uint64_t header, uint64_t size, bool temp);
+    uint8_t *unchecked_element(VMScope *scope, uint8_t array, uint8_t index, size_t size);
+    uint8_t *memory(uint64_t address, uint64_t size, bool write);
+    uint8_t *heap_address(uint32_t offset, uint64_t size, bool write);
+    bool live_object(const RefHeader *header);
+    RefHeader *ref_header(Ref r);
+    uint8_t *ref_address(uint32_t offset, size_t size);
+    Ref new_array(uint64_t length, size_t element_size);
+    bool is_array(Ref r);
+    ArrayHeader *array_header(Ref r);
+    uint8_t *array_element(Ref array, uint64_t index, size_t size);
+    bool module_string(uint64_t offset);
+    StringHeader *string_handle();
+    uint8_t *new_string(uint64_t length);
+    void flush_releases();
+
+    // Local #`index` read as a T, which it must hold as `type`; otherwise
+    // traps and reads as zero.
+    template <typename T>
+    inline T local_as(VMScope *scope, uint8_t index, DataType type) {
+      Value *local = scope->local(index);
+      if (local->get_type() != type) [[unlikely]] {
+        trap(TRAP_TYPE);
+        return T();
+      }
+      return static_cast<T>(*local);
+    }
+
+    // Address of the `depth`-th value of type T below the top of the stack.
+    template <typename T>
+    inline void *operand(size_t depth) {
+      return ref(stack_width(sizeof(T)) * (depth + 1));
+    }
 
     _FN_T_T(void, push_, value)
     _FN_T(void, popl_, VMScope *scope, uint8_t index)
     _FN_T(void, pushl_, VMScope *scope, uint8_t index)
     _FN_T_T(void, setl_, value, VMScope *scope, uint8_t index)
+    _FN_W_T(void, push_, value)
+    _FN_W(void, popl_, VMScope *scope, uint8_t index)
+    _FN_W(void, pushl_, VMScope *scope, uint8_t index)
+    _FN_W_T(void, setl_, value, VMScope *scope, uint8_t index)
     _FN_N(void, add_)
     _FN_N(void, sub_)
     _FN_N(void, mul_)
     _FN_N(void, div_)
     _FN_N(void, rem_)
     _FN_I(void, abs_)
+    _FN_W(void, add_)
+    _FN_W(void, sub_)
+    _FN_W(void, mul_)
+    _FN_W(void, div_)
+    _FN_W(void, rem_)
+    _FN_Z(void, addc_)
+    _FN_Z(void, subc_)
+    _FN_Z(void, mulc_)
+    _FN_Z(void, adds_)
+    _FN_Z(void, subs_)
+    _FN_Z(void, muls_)
+
+    _FN_Z(void, and_)
+    _FN_Z(void, or_)
+    _FN_Z(void, xor_)
+    _FN_Z(void, not_)
+    _FN_Z(void, shl_)
+    _FN_Z(void, shr_)
+    _FN_Z(void, sar_)
+    _FN_Z(void, rotl_)
+    _FN_Z(void, rotr_)
+    _FN_Z(void, popcnt_)
+    _FN_Z(void, clz_)
+    _FN_Z(void, ctz_)
+
+    _FN_F(void, sqrt_)
+    _FN_F(void, floor_)
+    _FN_F(void, ceil_)
+    _FN_F(void, round_)
+    _FN_F(void, trunc_)
+    _FN_F(void, fma_)
+    _FN_N(void, min_)
+    _FN_N(void, max_)
+
+    _FN_N(void, cvt_i8_)
+    _FN_N(void, cvt_u8_)
+    _FN_N(void, cvt_i16_)
+    _FN_N(void, cvt_u16_)
+    _FN_N(void, cvt_i32_)
+    _FN_N(void, cvt_u32_)
+    _FN_N(void, cvt_f32_)
+    _FN_N(void, cvt_i64_)
+    _FN_N(void, cvt_u64_)
+    _FN_N(void, cvt_f64_)
 
     _FN_N(void, dec_)
     _FN_N(void, inc_)
@@ -341,6 +728,79 @@ namespace pushle {
     void popg(uint8_t n);
     _FN_S(void, pop)
     _FN_N(void, cmp_)
+    _FN_W(void, cmp_)
+    void vbinary(simd::BinaryOp op, simd::Shape shape);
+    void vreduce(simd::ReduceOp op, simd::Shape shape);
+    void saddr(uint32_t offset);
+    void memcopy();
+    void memfill();
+    void memcmp();
+    void memfind();
+    void strk(uint32_t offset);
+    void strlen();
+    void strcat();
+    void strcmp();
+    void streq();
+    void strhash();
+    void strsub();
+    void strfree();
+    void halloc();
+    void halloct();
+    void hfree();
+    void hloadg(uint8_t n, uint32_t offset);
+    _FN_T(void, hload_, uint32_t offset)
+    void hstoreg(uint8_t n, uint32_t offset);
+    _FN_T(void, hstore_, uint32_t offset)
+
+    void rnew();
+    void rnewl();
+    void rretain();
+    void rrelease();
+    void rflush();
+    void rcount();
+    void pushl_ref(VMScope *scope, uint8_t index);
+    void popl_ref(VMScope *scope, uint8_t index);
+    _FN_T(void, rload_, uint32_t offset)
+    void rload_ref(uint32_t offset);
+    _FN_T(void, rstore_, uint32_t offset)
+    void rstore_ref(uint32_t offset);
+
+    _FN_T(void, anew_)
+    void alen();
+    void aslice();
+    _FN_T(void, aload_)
+    _FN_T(void, astore_)
+    _FN_T(void, aloadl_, VMScope *scope, uint8_t array, uint8_t index)
+    _FN_T(void, astorel_, VMScope *scope, uint8_t array, uint8_t index)
+    _FN_T(void, aloadlu_, VMScope *scope, uint8_t array, uint8_t index)
+    _FN_T(void, astorelu_, VMScope *scope, uint8_t array, uint8_t index)
+    bool array_short(VMScope *scope, uint8_t array, uint64_t bytes);
+    void brsize(VMScope *scope, uint8_t array, uint64_t bytes, size_t offset);
+
+    _FN_T(void, movl_, VMScope *scope, uint8_t dst, uint8_t src)
+    _FN_T(void, movl2_, VMScope *scope, uint8_t dst, uint8_t src, uint8_t dst2, uint8_t src2)
+    _FN_N(void, addl_, VMScope *scope, uint8_t dst, uint8_t a, uint8_t b)
+    _FN_N(void, subl_, VMScope *scope, uint8_t dst, uint8_t a, uint8_t b)
+    _FN_N(void, mull_, VMScope *scope, uint8_t dst, uint8_t a, uint8_t b)
+    _FN_N(void, divl_, VMScope *scope, uint8_t dst, uint8_t a, uint8_t b)
+    _FN_N(void, reml_, VMScope *scope, uint8_t dst, uint8_t a, uint8_t b)
+    _FN_N(void, cmpl_, VMScope *scope, uint8_t a, uint8_t b)
+    _FN_N_T(void, cmpli_, value, VMScope *scope, uint8_t index)
+    _FN_N_T(void, cmpi_, value)
+    _FN_N(int8_t, br_compare_)
+    _FN_N(void, br_z_, size_t offset)
+    _FN_N(void, br_nz_, size_t offset)
+    _FN_N(void, br_l_, size_t offset)
+    _FN_N(void, br_g_, size_t offset)
+    _FN_N(void, br_nl_, size_t offset)
+    _FN_N(void, br_ng_, size_t offset)
+    _FN_N_T(int8_t, loop_step_, limit, VMScope *scope, uint8_t index)
+    _FN_N_T(void, loop_, limit, VMScope *scope, uint8_t index, size_t offset)
+    _FN_N(int8_t, djnz_step_, VMScope *scope, uint8_t index)
+    _FN_N(void, djnz_, VMScope *scope, uint8_t index, size_t offset)
+    _FN_N_T(int8_t, loopt_step_, limit)
+    _FN_N_T(void, loopt_, limit, size_t offset)
+
     void jz(size_t offset);
     void jnz(size_t offset);
     void jl(size_t offset);
@@ -348,8 +808,80 @@ namespace pushle {
     void jnl(size_t offset);
     void jng(size_t offset);
     void jmp(size_t offset);
+    void jerr(size_t offset);
+    void clrerr();
+    void callnative(uint16_t index);
+    void awaitnative(uint16_t index);
+    void yield();
     void ret();
     void dbg(int8_t i);
     void sig(int8_t signal);
+    void ontrap(size_t offset);
+    void offtrap();
+    void raise();
+  };
+
+  template <typename T>
+  constexpr DataType data_type() {
+    if constexpr (std::is_same_v<T, void>) return _none;
+    else if constexpr (std::is_same_v<T, int8_t>) return _i8;
+    else if constexpr (std::is_same_v<T, uint8_t>) return _u8;
+    else if constexpr (std::is_same_v<T, bool>) return _bool;
+    else if constexpr (std::is_same_v<T, int16_t>) return _i16;
+    else if constexpr (std::is_same_v<T, uint16_t>) return _u16;
+    else if constexpr (std::is_same_v<T, int32_t>) return _i32;
+    else if constexpr (std::is_same_v<T, uint32_t>) return _u32;
+    else if constexpr (std::is_same_v<T, float>) return _f32;
+    else if constexpr (std::is_same_v<T, int64_t>) return _i64;
+    else if constexpr (std::is_same_v<T, uint64_t>) return _u64;
+    else if constexpr (std::is_same_v<T, double>) return _f64;
+    else if constexpr (std::is_same_v<T, Ref>) return _ref;
+    else if constexpr (std::is_same_v<T, int128_t>) return _i128;
+    else if constexpr (std::is_same_v<T, uint128_t>) return _u128;
+    else if constexpr (std::is_same_v<T, float128_t>) return _f128;
+    else static_assert(!sizeof(T), "not a native data type");
+  }
+
+  template <auto F, typename R, typename... Args>
+  struct NativeBinding<F, R (*)(Args...)> {
+    // Stack offset of each argument from the first one; the last entry is
+    // the total width of the arguments.
+    static constexpr std::array<size_t, sizeof...(Args) + 1> offsets() {
+      std::array<size_t, sizeof...(Args) + 1> result = {};
+      size_t widths[] = { stack_width(sizeof(Args))..., 0 };
+      for (size_t i = 0; i < sizeof...(Args); i++) {
+        result[i + 1] = result[i] + widths[i];
+      }
+      return result;
+    }
+
+    template <size_t... I>
+    static inline void invoke(VM &vm, std::index_sequence<I...>) {
+      constexpr auto offset = offsets();
+      uint8_t *args = (uint8_t *)vm.ref(offset[sizeof...(Args)]);
+      if (vm.reg_trap != TRAP_NONE) {
+        return;
+      }
+      vm.sp = args;
+      if constexpr (std::is_void_v<R>) {
+        F(load<Args>(args + offset[I])...);
+      } else {
+        R value = F(load<Args>(args + offset[I])...);
+        vm.push(&value, sizeof(R));
+      }
+    }
+
+    static void call(VM &vm) {
+      invoke(vm, std::index_sequence_for<Args...>());
+    }
+
+    static NativeFunction function(std::string name) {
+      return { name, { data_type<Args>()... }, data_type<R>(), &call };
+    }
   };
+
+  template <auto F>
+  NativeFunction VM::native(std::string name) {
+    return NativeBinding<F>::function(name);
+  }
 };
@@ -66,6 +66,27 @@ TokenRegistry &TokenRegistry::getInstance() {
   instance->registerToken(Op::SETL_F64,   "setl_f64",   {DataType::_u8,DataType::_f64});
   #pragma endregion setl
 
+  #pragma region const
+  instance->registerToken(Op::PUSHK,      "pushk",      {DataType::_u8});
+  instance->registerToken(Op::PUSHKW,     "pushkw",     {DataType::_u16});
+  instance->registerToken(Op::SETLK_I64,  "setlk_i64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SETLK_U64,  "setlk_u64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SETLK_F64,  "setlk_f64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SETLKW_I64, "setlkw_i64", {DataType::_u8,DataType::_u16});
+  instance->registerToken(Op::SETLKW_U64, "setlkw_u64", {DataType::_u8,DataType::_u16});
+  instance->registerToken(Op::SETLKW_F64, "setlkw_f64", {DataType::_u8,DataType::_u16});
+  instance->registerToken(Op::PUSHS_I32,  "pushs_i32",  {DataType::_i8});
+  instance->registerToken(Op::PUSHS_U32,  "pushs_u32",  {DataType::_u8});
+  instance->registerToken(Op::PUSHS_I64,  "pushs_i64",  {DataType::_i8});
+  instance->registerToken(Op::PUSHS_U64,  "pushs_u64",  {DataType::_u8});
+  instance->registerToken(Op::PUSHS_F64,  "pushs_f64",  {DataType::_i8});
+  instance->registerToken(Op::SETLS_I32,  "setls_i32",  {DataType::_u8,DataType::_i8});
+  instance->registerToken(Op::SETLS_U32,  "setls_u32",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SETLS_I64,  "setls_i64",  {DataType::_u8,DataType::_i8});
+  instance->registerToken(Op::SETLS_U64,  "setls_u64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SETLS_F64,  "setls_f64",  {DataType::_u8,DataType::_i8});
+  #pragma endregion const
+
   #pragma region add
   instance->registerToken(Op::ADD_I8,     "add_i8",     {});
   instance->registerToken(Op::ADD_U8,     "add_u8",     {});
@@ -214,14 +235,1070 @@ TokenRegistry &TokenRegistry::getInstance() {
   instance->registerToken(Op::JNL,        "jnl",        {DataType::_u64});
   instance->registerToken(Op::JNG,        "jng",        {DataType::_u64});
   instance->registerToken(Op::JMP,        "jmp",        {DataType::_u64});
+  instance->registerToken(Op::JERR,       "jerr",       {DataType::_u64});
+  instance->registerToken(Op::CLRERR,     "clrerr",     {});
   #pragma endregion jmp
 
+  #pragma region native
+  instance->registerToken(Op::CALLNATIVE, "callnative", {DataType::_u16});
+  instance->registerToken(Op::AWAITNATIVE,"awaitnative",{DataType::_u16});
+  #pragma endregion native
+
   #pragma region exec
   instance->registerToken(Op::RET,        "ret",        {});
   instance->registerToken(Op::DBG,        "dbg",        {DataType::_i8});
   instance->registerToken(Op::SIG,        "sig",        {DataType::_i8});
+  instance->registerToken(Op::YIELD,      "yield",      {});
   #pragma endregion exec
 
+  #pragma region vadd
+  instance->registerToken(Op::VADD_I8X16,       "vadd_i8x16",       {});
+  instance->registerToken(Op::VADD_U8X16,       "vadd_u8x16",       {});
+  instance->registerToken(Op::VADD_I16X8,       "vadd_i16x8",       {});
+  instance->registerToken(Op::VADD_U16X8,       "vadd_u16x8",       {});
+  instance->registerToken(Op::VADD_I32X4,       "vadd_i32x4",       {});
+  instance->registerToken(Op::VADD_U32X4,       "vadd_u32x4",       {});
+  instance->registerToken(Op::VADD_F32X4,       "vadd_f32x4",       {});
+  instance->registerToken(Op::VADD_I64X2,       "vadd_i64x2",       {});
+  instance->registerToken(Op::VADD_U64X2,       "vadd_u64x2",       {});
+  instance->registerToken(Op::VADD_F64X2,       "vadd_f64x2",       {});
+  instance->registerToken(Op::VADD_I8X32,       "vadd_i8x32",       {});
+  instance->registerToken(Op::VADD_U8X32,       "vadd_u8x32",       {});
+  instance->registerToken(Op::VADD_I16X16,      "vadd_i16x16",      {});
+  instance->registerToken(Op::VADD_U16X16,      "vadd_u16x16",      {});
+  instance->registerToken(Op::VADD_I32X8,       "vadd_i32x8",       {});
+  instance->registerToken(Op::VADD_U32X8,       "vadd_u32x8",       {});
+  instance->registerToken(Op::VADD_F32X8,       "vadd_f32x8",       {});
+  instance->registerToken(Op::VADD_I64X4,       "vadd_i64x4",       {});
+  instance->registerToken(Op::VADD_U64X4,       "vadd_u64x4",       {});
+  instance->registerToken(Op::VADD_F64X4,       "vadd_f64x4",       {});
+  #pragma endregion vadd
+
+  #pragma region vsub
+  instance->registerToken(Op::VSUB_I8X16,       "vsub_i8x16",       {});
+  instance->registerToken(Op::VSUB_U8X16,       "vsub_u8x16",       {});
+  instance->registerToken(Op::VSUB_I16X8,       "vsub_i16x8",       {});
+  instance->registerToken(Op::VSUB_U16X8,       "vsub_u16x8",       {});
+  instance->registerToken(Op::VSUB_I32X4,       "vsub_i32x4",       {});
+  instance->registerToken(Op::VSUB_U32X4,       "vsub_u32x4",       {});
+  instance->registerToken(Op::VSUB_F32X4,       "vsub_f32x4",       {});
+  instance->registerToken(Op::VSUB_I64X2,       "vsub_i64x2",       {});
+  instance->registerToken(Op::VSUB_U64X2,       "vsub_u64x2",       {});
+  instance->registerToken(Op::VSUB_F64X2,       "vsub_f64x2",       {});
+  instance->registerToken(Op::VSUB_I8X32,       "vsub_i8x32",       {});
+  instance->registerToken(Op::VSUB_U8X32,       "vsub_u8x32",       {});
+  instance->registerToken(Op::VSUB_I16X16,      "vsub_i16x16",      {});
+  instance->registerToken(Op::VSUB_U16X16,      "vsub_u16x16",      {});
+  instance->registerToken(Op::VSUB_I32X8,       "vsub_i32x8",       {});
+  instance->registerToken(Op::VSUB_U32X8,       "vsub_u32x8",       {});
+  instance->registerToken(Op::VSUB_F32X8,       "vsub_f32x8",       {});
+  instance->registerToken(Op::VSUB_I64X4,       "vsub_i64x4",       {});
+  instance->registerToken(Op::VSUB_U64X4,       "vsub_u64x4",       {});
+  instance->registerToken(Op::VSUB_F64X4,       "vsub_f64x4",       {});
+  #pragma endregion vsub
+
+  #pragma region vmul
+  instance->registerToken(Op::VMUL_I8X16,       "vmul_i8x16",       {});
+  instance->registerToken(Op::VMUL_U8X16,       "vmul_u8x16",       {});
+  instance->registerToken(Op::VMUL_I16X8,       "vmul_i16x8",       {});
+  instance->registerToken(Op::VMUL_U16X8,       "vmul_u16x8",       {});
+  instance->registerToken(Op::VMUL_I32X4,       "vmul_i32x4",       {});
+  instance->registerToken(Op::VMUL_U32X4,       "vmul_u32x4",       {});
+  instance->registerToken(Op::VMUL_F32X4,       "vmul_f32x4",       {});
+  instance->registerToken(Op::VMUL_I64X2,       "vmul_i64x2",       {});
+  instance->registerToken(Op::VMUL_U64X2,       "vmul_u64x2",       {});
+  instance->registerToken(Op::VMUL_F64X2,       "vmul_f64x2",       {});
+  instance->registerToken(Op::VMUL_I8X32,       "vmul_i8x32",       {});
+  instance->registerToken(Op::VMUL_U8X32,       "vmul_u8x32",       {});
+  instance->registerToken(Op::VMUL_I16X16,      "vmul_i16x16",      {});
+  instance->registerToken(Op::VMUL_U16X16,      "vmul_u16x16",      {});
+  instance->registerToken(Op::VMUL_I32X8,       "vmul_i32x8",       {});
+  instance->registerToken(Op::VMUL_U32X8,       "vmul_u32x8",       {});
+  instance->registerToken(Op::VMUL_F32X8,       "vmul_f32x8",       {});
+  instance->registerToken(Op::VMUL_I64X4,       "vmul_i64x4",       {});
+  instance->registerToken(Op::VMUL_U64X4,       "vmul_u64x4",       {});
+  instance->registerToken(Op::VMUL_F64X4,       "vmul_f64x4",       {});
+  #pragma endregion vmul
+
+  #pragma region vmin
+  instance->registerToken(Op::VMIN_I8X16,       "vmin_i8x16",       {});
+  instance->registerToken(Op::VMIN_U8X16,       "vmin_u8x16",       {});
+  instance->registerToken(Op::VMIN_I16X8,       "vmin_i16x8",       {});
+  instance->registerToken(Op::VMIN_U16X8,       "vmin_u16x8",       {});
+  instance->registerToken(Op::VMIN_I32X4,       "vmin_i32x4",       {});
+  instance->registerToken(Op::VMIN_U32X4,       "vmin_u32x4",       {});
+  instance->registerToken(Op::VMIN_F32X4,       "vmin_f32x4",       {});
+  instance->registerToken(Op::VMIN_I64X2,       "vmin_i64x2",       {});
+  instance->registerToken(Op::VMIN_U64X2,       "vmin_u64x2",       {});
+  instance->registerToken(Op::VMIN_F64X2,       "vmin_f64x2",       {});
+  instance->registerToken(Op::VMIN_I8X32,       "vmin_i8x32",       {});
+  instance->registerToken(Op::VMIN_U8X32,       "vmin_u8x32",       {});
+  instance->registerToken(Op::VMIN_I16X16,      "vmin_i16x16",      {});
+  instance->registerToken(Op::VMIN_U16X16,      "vmin_u16x16",      {});
+  instance->registerToken(Op::VMIN_I32X8,       "vmin_i32x8",       {});
+  instance->registerToken(Op::VMIN_U32X8,       "vmin_u32x8",       {});
+  instance->registerToken(Op::VMIN_F32X8,       "vmin_f32x8",       {});
+  instance->registerToken(Op::VMIN_I64X4,       "vmin_i64x4",       {});
+  instance->registerToken(Op::VMIN_U64X4,       "vmin_u64x4",       {});
+  instance->registerToken(Op::VMIN_F64X4,       "vmin_f64x4",       {});
+  #pragma endregion vmin
+
+  #pragma region vmax
+  instance->registerToken(Op::VMAX_I8X16,       "vmax_i8x16",       {});
+  instance->registerToken(Op::VMAX_U8X16,       "vmax_u8x16",       {});
+  instance->registerToken(Op::VMAX_I16X8,       "vmax_i16x8",       {});
+  instance->registerToken(Op::VMAX_U16X8,       "vmax_u16x8",       {});
+  instance->registerToken(Op::VMAX_I32X4,       "vmax_i32x4",       {});
+  instance->registerToken(Op::VMAX_U32X4,       "vmax_u32x4",       {});
+  instance->registerToken(Op::VMAX_F32X4,       "vmax_f32x4",       {});
+  instance->registerToken(Op::VMAX_I64X2,       "vmax_i64x2",       {});
+  instance->registerToken(Op::VMAX_U64X2,       "vmax_u64x2",       {});
+  instance->registerToken(Op::VMAX_F64X2,       "vmax_f64x2",       {});
+  instance->registerToken(Op::VMAX_I8X32,       "vmax_i8x32",       {});
+  instance->registerToken(Op::VMAX_U8X32,       "vmax_u8x32",       {});
+  instance->registerToken(Op::VMAX_I16X16,      "vmax_i16x16",      {});
+  instance->registerToken(Op::VMAX_U16X16,      "vmax_u16x16",      {});
+  instance->registerToken(Op::VMAX_I32X8,       "vmax_i32x8",       {});
+  instance->registerToken(Op::VMAX_U32X8,       "vmax_u32x8",       {});
+  instance->registerToken(Op::VMAX_F32X8,       "vmax_f32x8",       {});
+  instance->registerToken(Op::VMAX_I64X4,       "vmax_i64x4",       {});
+  instance->registerToken(Op::VMAX_U64X4,       "vmax_u64x4",       {});
+  instance->registerToken(Op::VMAX_F64X4,       "vmax_f64x4",       {});
+  #pragma endregion vmax
+
+  #pragma region vcmpeq
+  instance->registerToken(Op::VCMPEQ_I8X16,     "vcmpeq_i8x16",     {});
+  instance->registerToken(Op::VCMPEQ_U8X16,     "vcmpeq_u8x16",     {});
+  instance->registerToken(Op::VCMPEQ_I16X8,     "vcmpeq_i16x8",     {});
+  instance->registerToken(Op::VCMPEQ_U16X8,     "vcmpeq_u16x8",     {});
+  instance->registerToken(Op::VCMPEQ_I32X4,     "vcmpeq_i32x4",     {});
+  instance->registerToken(Op::VCMPEQ_U32X4,     "vcmpeq_u32x4",     {});
+  instance->registerToken(Op::VCMPEQ_F32X4,     "vcmpeq_f32x4",     {});
+  instance->registerToken(Op::VCMPEQ_I64X2,     "vcmpeq_i64x2",     {});
+  instance->registerToken(Op::VCMPEQ_U64X2,     "vcmpeq_u64x2",     {});
+  instance->registerToken(Op::VCMPEQ_F64X2,     "vcmpeq_f64x2",     {});
+  instance->registerToken(Op::VCMPEQ_I8X32,     "vcmpeq_i8x32",     {});
+  instance->registerToken(Op::VCMPEQ_U8X32,     "vcmpeq_u8x32",     {});
+  instance->registerToken(Op::VCMPEQ_I16X16,    "vcmpeq_i16x16",    {});
+  instance->registerToken(Op::VCMPEQ_U16X16,    "vcmpeq_u16x16",    {});
+  instance->registerToken(Op::VCMPEQ_I32X8,     "vcmpeq_i32x8",     {});
+  instance->registerToken(Op::VCMPEQ_U32X8,     "vcmpeq_u32x8",     {});
+  instance->registerToken(Op::VCMPEQ_F32X8,     "vcmpeq_f32x8",     {});
+  instance->registerToken(Op::VCMPEQ_I64X4,     "vcmpeq_i64x4",     {});
+  instance->registerToken(Op::VCMPEQ_U64X4,     "vcmpeq_u64x4",     {});
+  instance->registerToken(Op::VCMPEQ_F64X4,     "vcmpeq_f64x4",     {});
+  #pragma endregion vcmpeq
+
+  #pragma region vcmplt
+  instance->registerToken(Op::VCMPLT_I8X16,     "vcmplt_i8x16",     {});
+  instance->registerToken(Op::VCMPLT_U8X16,     "vcmplt_u8x16",     {});
+  instance->registerToken(Op::VCMPLT_I16X8,     "vcmplt_i16x8",     {});
+  instance->registerToken(Op::VCMPLT_U16X8,     "vcmplt_u16x8",     {});
+  instance->registerToken(Op::VCMPLT_I32X4,     "vcmplt_i32x4",     {});
+  instance->registerToken(Op::VCMPLT_U32X4,     "vcmplt_u32x4",     {});
+  instance->registerToken(Op::VCMPLT_F32X4,     "vcmplt_f32x4",     {});
+  instance->registerToken(Op::VCMPLT_I64X2,     "vcmplt_i64x2",     {});
+  instance->registerToken(Op::VCMPLT_U64X2,     "vcmplt_u64x2",     {});
+  instance->registerToken(Op::VCMPLT_F64X2,     "vcmplt_f64x2",     {});
+  instance->registerToken(Op::VCMPLT_I8X32,     "vcmplt_i8x32",     {});
+  instance->registerToken(Op::VCMPLT_U8X32,     "vcmplt_u8x32",     {});
+  instance->registerToken(Op::VCMPLT_I16X16,    "vcmplt_i16x16",    {});
+  instance->registerToken(Op::VCMPLT_U16X16,    "vcmplt_u16x16",    {});
+  instance->registerToken(Op::VCMPLT_I32X8,     "vcmplt_i32x8",     {});
+  instance->registerToken(Op::VCMPLT_U32X8,     "vcmplt_u32x8",     {});
+  instance->registerToken(Op::VCMPLT_F32X8,     "vcmplt_f32x8",     {});
+  instance->registerToken(Op::VCMPLT_I64X4,     "vcmplt_i64x4",     {});
+  instance->registerToken(Op::VCMPLT_U64X4,     "vcmplt_u64x4",     {});
+  instance->registerToken(Op::VCMPLT_F64X4,     "vcmplt_f64x4",     {});
+  #pragma endregion vcmplt
+
+  #pragma region vsum
+  instance->registerToken(Op::VSUM_I8X16,       "vsum_i8x16",       {});
+  instance->registerToken(Op::VSUM_U8X16,       "vsum_u8x16",       {});
+  instance->registerToken(Op::VSUM_I16X8,       "vsum_i16x8",       {});
+  instance->registerToken(Op::VSUM_U16X8,       "vsum_u16x8",       {});
+  instance->registerToken(Op::VSUM_I32X4,       "vsum_i32x4",       {});
+  instance->registerToken(Op::VSUM_U32X4,       "vsum_u32x4",       {});
+  instance->registerToken(Op::VSUM_F32X4,       "vsum_f32x4",       {});
+  instance->registerToken(Op::VSUM_I64X2,       "vsum_i64x2",       {});
+  instance->registerToken(Op::VSUM_U64X2,       "vsum_u64x2",       {});
+  instance->registerToken(Op::VSUM_F64X2,       "vsum_f64x2",       {});
+  instance->registerToken(Op::VSUM_I8X32,       "vsum_i8x32",       {});
+  instance->registerToken(Op::VSUM_U8X32,       "vsum_u8x32",       {});
+  instance->registerToken(Op::VSUM_I16X16,      "vsum_i16x16",      {});
+  instance->registerToken(Op::VSUM_U16X16,      "vsum_u16x16",      {});
+  instance->registerToken(Op::VSUM_I32X8,       "vsum_i32x8",       {});
+  instance->registerToken(Op::VSUM_U32X8,       "vsum_u32x8",       {});
+  instance->registerToken(Op::VSUM_F32X8,       "vsum_f32x8",       {});
+  instance->registerToken(Op::VSUM_I64X4,       "vsum_i64x4",       {});
+  instance->registerToken(Op::VSUM_U64X4,       "vsum_u64x4",       {});
+  instance->registerToken(Op::VSUM_F64X4,       "vsum_f64x4",       {});
+  #pragma endregion vsum
+
+  #pragma region vhmin
+  instance->registerToken(Op::VHMIN_I8X16,      "vhmin_i8x16",      {});
+  instance->registerToken(Op::VHMIN_U8X16,      "vhmin_u8x16",      {});
+  instance->registerToken(Op::VHMIN_I16X8,      "vhmin_i16x8",      {});
+  instance->registerToken(Op::VHMIN_U16X8,      "vhmin_u16x8",      {});
+  instance->registerToken(Op::VHMIN_I32X4,      "vhmin_i32x4",      {});
+  instance->registerToken(Op::VHMIN_U32X4,      "vhmin_u32x4",      {});
+  instance->registerToken(Op::VHMIN_F32X4,      "vhmin_f32x4",      {});
+  instance->registerToken(Op::VHMIN_I64X2,      "vhmin_i64x2",      {});
+  instance->registerToken(Op::VHMIN_U64X2,      "vhmin_u64x2",      {});
+  instance->registerToken(Op::VHMIN_F64X2,      "vhmin_f64x2",      {});
+  instance->registerToken(Op::VHMIN_I8X32,      "vhmin_i8x32",      {});
+  instance->registerToken(Op::VHMIN_U8X32,      "vhmin_u8x32",      {});
+  instance->registerToken(Op::VHMIN_I16X16,     "vhmin_i16x16",     {});
+  instance->registerToken(Op::VHMIN_U16X16,     "vhmin_u16x16",     {});
+  instance->registerToken(Op::VHMIN_I32X8,      "vhmin_i32x8",      {});
+  instance->registerToken(Op::VHMIN_U32X8,      "vhmin_u32x8",      {});
+  instance->registerToken(Op::VHMIN_F32X8,      "vhmin_f32x8",      {});
+  instance->registerToken(Op::VHMIN_I64X4,      "vhmin_i64x4",      {});
+  instance->registerToken(Op::VHMIN_U64X4,      "vhmin_u64x4",      {});
+  instance->registerToken(Op::VHMIN_F64X4,      "vhmin_f64x4",      {});
+  #pragma endregion vhmin
+
+  #pragma region vhmax
+  instance->registerToken(Op::VHMAX_I8X16,      "vhmax_i8x16",      {});
+  instance->registerToken(Op::VHMAX_U8X16,      "vhmax_u8x16",      {});
+  instance->registerToken(Op::VHMAX_I16X8,      "vhmax_i16x8",      {});
+  instance->registerToken(Op::VHMAX_U16X8,      "vhmax_u16x8",      {});
+  instance->registerToken(Op::VHMAX_I32X4,      "vhmax_i32x4",      {});
+  instance->registerToken(Op::VHMAX_U32X4,      "vhmax_u32x4",      {});
+  instance->registerToken(Op::VHMAX_F32X4,      "vhmax_f32x4",      {});
+  instance->registerToken(Op::VHMAX_I64X2,      "vhmax_i64x2",      {});
+  instance->registerToken(Op::VHMAX_U64X2,      "vhmax_u64x2",      {});
+  instance->registerToken(Op::VHMAX_F64X2,      "vhmax_f64x2",      {});
+  instance->registerToken(Op::VHMAX_I8X32,      "vhmax_i8x32",      {});
+  instance->registerToken(Op::VHMAX_U8X32,      "vhmax_u8x32",      {});
+  instance->registerToken(Op::VHMAX_I16X16,     "vhmax_i16x16",     {});
+  instance->registerToken(Op::VHMAX_U16X16,     "vhmax_u16x16",     {});
+  instance->registerToken(Op::VHMAX_I32X8,      "vhmax_i32x8",      {});
+  instance->registerToken(Op::VHMAX_U32X8,      "vhmax_u32x8",      {});
+  instance->registerToken(Op::VHMAX_F32X8,      "vhmax_f32x8",      {});
+  instance->registerToken(Op::VHMAX_I64X4,      "vhmax_i64x4",      {});
+  instance->registerToken(Op::VHMAX_U64X4,      "vhmax_u64x4",      {});
+  instance->registerToken(Op::VHMAX_F64X4,      "vhmax_f64x4",      {});
+  #pragma endregion vhmax
+
+  #pragma region heap
+  instance->registerToken(Op::HALLOC,     "halloc",     {});
+  instance->registerToken(Op::HALLOCT,    "halloct",    {});
+  instance->registerToken(Op::HFREE,      "hfree",      {});
+  instance->registerToken(Op::HLOADG,     "hloadg",     {DataType::_u8,DataType::_u32});
+  instance->registerToken(Op::HLOAD_I8,     "hload_i8",     {DataType::_u32});
+  instance->registerToken(Op::HLOAD_U8,     "hload_u8",     {DataType::_u32});
+  instance->registerToken(Op::HLOAD_BOOL,   "hload_bool",   {DataType::_u32});
+  instance->registerToken(Op::HLOAD_I16,    "hload_i16",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_U16,    "hload_u16",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_I32,    "hload_i32",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_U32,    "hload_u32",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_F32,    "hload_f32",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_I64,    "hload_i64",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_U64,    "hload_u64",    {DataType::_u32});
+  instance->registerToken(Op::HLOAD_F64,    "hload_f64",    {DataType::_u32});
+  instance->registerToken(Op::HSTOREG,    "hstoreg",    {DataType::_u8,DataType::_u32});
+  instance->registerToken(Op::HSTORE_I8,    "hstore_i8",    {DataType::_u32});
+  instance->registerToken(Op::HSTORE_U8,    "hstore_u8",    {DataType::_u32});
+  instance->registerToken(Op::HSTORE_BOOL,  "hstore_bool",  {DataType::_u32});
+  instance->registerToken(Op::HSTORE_I16,   "hstore_i16",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_U16,   "hstore_u16",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_I32,   "hstore_i32",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_U32,   "hstore_u32",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_F32,   "hstore_f32",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_I64,   "hstore_i64",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_U64,   "hstore_u64",   {DataType::_u32});
+  instance->registerToken(Op::HSTORE_F64,   "hstore_f64",   {DataType::_u32});
+  #pragma endregion heap
+
+  #pragma region ref
+  instance->registerToken(Op::RNEW,       "rnew",       {});
+  instance->registerToken(Op::RNEWL,      "rnewl",      {});
+  instance->registerToken(Op::RRETAIN,    "rretain",    {});
+  instance->registerToken(Op::RRELEASE,   "rrelease",   {});
+  instance->registerToken(Op::RFLUSH,     "rflush",     {});
+  instance->registerToken(Op::RCOUNT,     "rcount",     {});
+  instance->registerToken(Op::PUSHL_REF,  "pushl_ref",  {DataType::_u8});
+  instance->registerToken(Op::POPL_REF,   "popl_ref",   {DataType::_u8});
+  instance->registerToken(Op::RLOAD_I8,     "rload_i8",     {DataType::_u32});
+  instance->registerToken(Op::RLOAD_U8,     "rload_u8",     {DataType::_u32});
+  instance->registerToken(Op::RLOAD_BOOL,   "rload_bool",   {DataType::_u32});
+  instance->registerToken(Op::RLOAD_I16,    "rload_i16",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_U16,    "rload_u16",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_I32,    "rload_i32",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_U32,    "rload_u32",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_F32,    "rload_f32",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_I64,    "rload_i64",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_U64,    "rload_u64",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_F64,    "rload_f64",    {DataType::_u32});
+  instance->registerToken(Op::RLOAD_REF,    "rload_ref",    {DataType::_u32});
+  instance->registerToken(Op::RSTORE_I8,    "rstore_i8",    {DataType::_u32});
+  instance->registerToken(Op::RSTORE_U8,    "rstore_u8",    {DataType::_u32});
+  instance->registerToken(Op::RSTORE_BOOL,  "rstore_bool",  {DataType::_u32});
+  instance->registerToken(Op::RSTORE_I16,   "rstore_i16",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_U16,   "rstore_u16",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_I32,   "rstore_i32",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_U32,   "rstore_u32",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_F32,   "rstore_f32",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_I64,   "rstore_i64",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_U64,   "rstore_u64",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_F64,   "rstore_f64",   {DataType::_u32});
+  instance->registerToken(Op::RSTORE_REF,   "rstore_ref",   {DataType::_u32});
+  #pragma endregion ref
+
+  #pragma region locals
+  instance->registerToken(Op::MOVL_I8,      "movl_i8",     {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_U8,      "movl_u8",     {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_BOOL,    "movl_bool",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_I16,     "movl_i16",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_U16,     "movl_u16",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_I32,     "movl_i32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_U32,     "movl_u32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_F32,     "movl_f32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_I64,     "movl_i64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_U64,     "movl_u64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL_F64,     "movl_f64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_I8,      "addl_i8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_U8,      "addl_u8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_I16,     "addl_i16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_U16,     "addl_u16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_I32,     "addl_i32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_U32,     "addl_u32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_F32,     "addl_f32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_I64,     "addl_i64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_U64,     "addl_u64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ADDL_F64,     "addl_f64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_I8,      "subl_i8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_U8,      "subl_u8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_I16,     "subl_i16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_U16,     "subl_u16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_I32,     "subl_i32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_U32,     "subl_u32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_F32,     "subl_f32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_I64,     "subl_i64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_U64,     "subl_u64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::SUBL_F64,     "subl_f64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_I8,      "mull_i8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_U8,      "mull_u8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_I16,     "mull_i16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_U16,     "mull_u16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_I32,     "mull_i32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_U32,     "mull_u32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_F32,     "mull_f32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_I64,     "mull_i64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_U64,     "mull_u64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MULL_F64,     "mull_f64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_I8,      "divl_i8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_U8,      "divl_u8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_I16,     "divl_i16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_U16,     "divl_u16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_I32,     "divl_i32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_U32,     "divl_u32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_F32,     "divl_f32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_I64,     "divl_i64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_U64,     "divl_u64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::DIVL_F64,     "divl_f64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_I8,      "reml_i8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_U8,      "reml_u8",     {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_I16,     "reml_i16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_U16,     "reml_u16",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_I32,     "reml_i32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_U32,     "reml_u32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_F32,     "reml_f32",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_I64,     "reml_i64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_U64,     "reml_u64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::REML_F64,     "reml_f64",    {DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_I8,      "cmpl_i8",     {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_U8,      "cmpl_u8",     {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_I16,     "cmpl_i16",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_U16,     "cmpl_u16",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_I32,     "cmpl_i32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_U32,     "cmpl_u32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_F32,     "cmpl_f32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_I64,     "cmpl_i64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_U64,     "cmpl_u64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPL_F64,     "cmpl_f64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPLI_I8,     "cmpli_i8",    {DataType::_u8,DataType::_i8});
+  instance->registerToken(Op::CMPLI_U8,     "cmpli_u8",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::CMPLI_I16,    "cmpli_i16",   {DataType::_u8,DataType::_i16});
+  instance->registerToken(Op::CMPLI_U16,    "cmpli_u16",   {DataType::_u8,DataType::_u16});
+  instance->registerToken(Op::CMPLI_I32,    "cmpli_i32",   {DataType::_u8,DataType::_i32});
+  instance->registerToken(Op::CMPLI_U32,    "cmpli_u32",   {DataType::_u8,DataType::_u32});
+  instance->registerToken(Op::CMPLI_F32,    "cmpli_f32",   {DataType::_u8,DataType::_f32});
+  instance->registerToken(Op::CMPLI_I64,    "cmpli_i64",   {DataType::_u8,DataType::_i64});
+  instance->registerToken(Op::CMPLI_U64,    "cmpli_u64",   {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::CMPLI_F64,    "cmpli_f64",   {DataType::_u8,DataType::_f64});
+  instance->registerToken(Op::CMPI_I8,      "cmpi_i8",     {DataType::_i8});
+  instance->registerToken(Op::CMPI_U8,      "cmpi_u8",     {DataType::_u8});
+  instance->registerToken(Op::CMPI_I16,     "cmpi_i16",    {DataType::_i16});
+  instance->registerToken(Op::CMPI_U16,     "cmpi_u16",    {DataType::_u16});
+  instance->registerToken(Op::CMPI_I32,     "cmpi_i32",    {DataType::_i32});
+  instance->registerToken(Op::CMPI_U32,     "cmpi_u32",    {DataType::_u32});
+  instance->registerToken(Op::CMPI_F32,     "cmpi_f32",    {DataType::_f32});
+  instance->registerToken(Op::CMPI_I64,     "cmpi_i64",    {DataType::_i64});
+  instance->registerToken(Op::CMPI_U64,     "cmpi_u64",    {DataType::_u64});
+  instance->registerToken(Op::CMPI_F64,     "cmpi_f64",    {DataType::_f64});
+  instance->registerToken(Op::BRLI_Z_I8,    "brli_z_i8",   {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_U8,    "brli_z_u8",   {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_I16,   "brli_z_i16",  {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_U16,   "brli_z_u16",  {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_I32,   "brli_z_i32",  {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_U32,   "brli_z_u32",  {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_F32,   "brli_z_f32",  {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_I64,   "brli_z_i64",  {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_U64,   "brli_z_u64",  {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRLI_Z_F64,   "brli_z_f64",  {DataType::_u8,DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_I8,   "brli_nz_i8",  {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_U8,   "brli_nz_u8",  {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_I16,  "brli_nz_i16", {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_U16,  "brli_nz_u16", {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_I32,  "brli_nz_i32", {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_U32,  "brli_nz_u32", {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_F32,  "brli_nz_f32", {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_I64,  "brli_nz_i64", {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_U64,  "brli_nz_u64", {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NZ_F64,  "brli_nz_f64", {DataType::_u8,DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_I8,    "brli_l_i8",   {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_U8,    "brli_l_u8",   {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_I16,   "brli_l_i16",  {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_U16,   "brli_l_u16",  {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_I32,   "brli_l_i32",  {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_U32,   "brli_l_u32",  {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_F32,   "brli_l_f32",  {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_I64,   "brli_l_i64",  {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_U64,   "brli_l_u64",  {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRLI_L_F64,   "brli_l_f64",  {DataType::_u8,DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_I8,    "brli_g_i8",   {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_U8,    "brli_g_u8",   {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_I16,   "brli_g_i16",  {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_U16,   "brli_g_u16",  {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_I32,   "brli_g_i32",  {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_U32,   "brli_g_u32",  {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_F32,   "brli_g_f32",  {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_I64,   "brli_g_i64",  {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_U64,   "brli_g_u64",  {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRLI_G_F64,   "brli_g_f64",  {DataType::_u8,DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_I8,   "brli_nl_i8",  {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_U8,   "brli_nl_u8",  {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_I16,  "brli_nl_i16", {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_U16,  "brli_nl_u16", {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_I32,  "brli_nl_i32", {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_U32,  "brli_nl_u32", {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_F32,  "brli_nl_f32", {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_I64,  "brli_nl_i64", {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_U64,  "brli_nl_u64", {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NL_F64,  "brli_nl_f64", {DataType::_u8,DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_I8,   "brli_ng_i8",  {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_U8,   "brli_ng_u8",  {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_I16,  "brli_ng_i16", {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_U16,  "brli_ng_u16", {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_I32,  "brli_ng_i32", {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_U32,  "brli_ng_u32", {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_F32,  "brli_ng_f32", {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_I64,  "brli_ng_i64", {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_U64,  "brli_ng_u64", {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRLI_NG_F64,  "brli_ng_f64", {DataType::_u8,DataType::_f64,DataType::_u64});
+  #pragma endregion locals
+
+  #pragma region br
+  instance->registerToken(Op::BR_Z_I8,     "br_z_i8",     {DataType::_u64});
+  instance->registerToken(Op::BR_Z_U8,     "br_z_u8",     {DataType::_u64});
+  instance->registerToken(Op::BR_Z_I16,    "br_z_i16",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_U16,    "br_z_u16",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_I32,    "br_z_i32",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_U32,    "br_z_u32",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_F32,    "br_z_f32",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_I64,    "br_z_i64",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_U64,    "br_z_u64",    {DataType::_u64});
+  instance->registerToken(Op::BR_Z_F64,    "br_z_f64",    {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_I8,    "br_nz_i8",    {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_U8,    "br_nz_u8",    {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_I16,   "br_nz_i16",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_U16,   "br_nz_u16",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_I32,   "br_nz_i32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_U32,   "br_nz_u32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_F32,   "br_nz_f32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_I64,   "br_nz_i64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_U64,   "br_nz_u64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NZ_F64,   "br_nz_f64",   {DataType::_u64});
+  instance->registerToken(Op::BR_L_I8,     "br_l_i8",     {DataType::_u64});
+  instance->registerToken(Op::BR_L_U8,     "br_l_u8",     {DataType::_u64});
+  instance->registerToken(Op::BR_L_I16,    "br_l_i16",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_U16,    "br_l_u16",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_I32,    "br_l_i32",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_U32,    "br_l_u32",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_F32,    "br_l_f32",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_I64,    "br_l_i64",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_U64,    "br_l_u64",    {DataType::_u64});
+  instance->registerToken(Op::BR_L_F64,    "br_l_f64",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_I8,     "br_g_i8",     {DataType::_u64});
+  instance->registerToken(Op::BR_G_U8,     "br_g_u8",     {DataType::_u64});
+  instance->registerToken(Op::BR_G_I16,    "br_g_i16",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_U16,    "br_g_u16",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_I32,    "br_g_i32",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_U32,    "br_g_u32",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_F32,    "br_g_f32",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_I64,    "br_g_i64",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_U64,    "br_g_u64",    {DataType::_u64});
+  instance->registerToken(Op::BR_G_F64,    "br_g_f64",    {DataType::_u64});
+  instance->registerToken(Op::BR_NL_I8,    "br_nl_i8",    {DataType::_u64});
+  instance->registerToken(Op::BR_NL_U8,    "br_nl_u8",    {DataType::_u64});
+  instance->registerToken(Op::BR_NL_I16,   "br_nl_i16",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_U16,   "br_nl_u16",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_I32,   "br_nl_i32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_U32,   "br_nl_u32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_F32,   "br_nl_f32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_I64,   "br_nl_i64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_U64,   "br_nl_u64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NL_F64,   "br_nl_f64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_I8,    "br_ng_i8",    {DataType::_u64});
+  instance->registerToken(Op::BR_NG_U8,    "br_ng_u8",    {DataType::_u64});
+  instance->registerToken(Op::BR_NG_I16,   "br_ng_i16",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_U16,   "br_ng_u16",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_I32,   "br_ng_i32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_U32,   "br_ng_u32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_F32,   "br_ng_f32",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_I64,   "br_ng_i64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_U64,   "br_ng_u64",   {DataType::_u64});
+  instance->registerToken(Op::BR_NG_F64,   "br_ng_f64",   {DataType::_u64});
+  #pragma endregion br
+
+  #pragma region overflow
+  instance->registerToken(Op::ADDC_I8,     "addc_i8",     {});
+  instance->registerToken(Op::ADDC_U8,     "addc_u8",     {});
+  instance->registerToken(Op::ADDC_I16,    "addc_i16",    {});
+  instance->registerToken(Op::ADDC_U16,    "addc_u16",    {});
+  instance->registerToken(Op::ADDC_I32,    "addc_i32",    {});
+  instance->registerToken(Op::ADDC_U32,    "addc_u32",    {});
+  instance->registerToken(Op::ADDC_I64,    "addc_i64",    {});
+  instance->registerToken(Op::ADDC_U64,    "addc_u64",    {});
+  instance->registerToken(Op::SUBC_I8,     "subc_i8",     {});
+  instance->registerToken(Op::SUBC_U8,     "subc_u8",     {});
+  instance->registerToken(Op::SUBC_I16,    "subc_i16",    {});
+  instance->registerToken(Op::SUBC_U16,    "subc_u16",    {});
+  instance->registerToken(Op::SUBC_I32,    "subc_i32",    {});
+  instance->registerToken(Op::SUBC_U32,    "subc_u32",    {});
+  instance->registerToken(Op::SUBC_I64,    "subc_i64",    {});
+  instance->registerToken(Op::SUBC_U64,    "subc_u64",    {});
+  instance->registerToken(Op::MULC_I8,     "mulc_i8",     {});
+  instance->registerToken(Op::MULC_U8,     "mulc_u8",     {});
+  instance->registerToken(Op::MULC_I16,    "mulc_i16",    {});
+  instance->registerToken(Op::MULC_U16,    "mulc_u16",    {});
+  instance->registerToken(Op::MULC_I32,    "mulc_i32",    {});
+  instance->registerToken(Op::MULC_U32,    "mulc_u32",    {});
+  instance->registerToken(Op::MULC_I64,    "mulc_i64",    {});
+  instance->registerToken(Op::MULC_U64,    "mulc_u64",    {});
+  instance->registerToken(Op::ADDS_I8,     "adds_i8",     {});
+  instance->registerToken(Op::ADDS_U8,     "adds_u8",     {});
+  instance->registerToken(Op::ADDS_I16,    "adds_i16",    {});
+  instance->registerToken(Op::ADDS_U16,    "adds_u16",    {});
+  instance->registerToken(Op::ADDS_I32,    "adds_i32",    {});
+  instance->registerToken(Op::ADDS_U32,    "adds_u32",    {});
+  instance->registerToken(Op::ADDS_I64,    "adds_i64",    {});
+  instance->registerToken(Op::ADDS_U64,    "adds_u64",    {});
+  instance->registerToken(Op::SUBS_I8,     "subs_i8",     {});
+  instance->registerToken(Op::SUBS_U8,     "subs_u8",     {});
+  instance->registerToken(Op::SUBS_I16,    "subs_i16",    {});
+  instance->registerToken(Op::SUBS_U16,    "subs_u16",    {});
+  instance->registerToken(Op::SUBS_I32,    "subs_i32",    {});
+  instance->registerToken(Op::SUBS_U32,    "subs_u32",    {});
+  instance->registerToken(Op::SUBS_I64,    "subs_i64",    {});
+  instance->registerToken(Op::SUBS_U64,    "subs_u64",    {});
+  instance->registerToken(Op::MULS_I8,     "muls_i8",     {});
+  instance->registerToken(Op::MULS_U8,     "muls_u8",     {});
+  instance->registerToken(Op::MULS_I16,    "muls_i16",    {});
+  instance->registerToken(Op::MULS_U16,    "muls_u16",    {});
+  instance->registerToken(Op::MULS_I32,    "muls_i32",    {});
+  instance->registerToken(Op::MULS_U32,    "muls_u32",    {});
+  instance->registerToken(Op::MULS_I64,    "muls_i64",    {});
+  instance->registerToken(Op::MULS_U64,    "muls_u64",    {});
+  #pragma endregion overflow
+
+  #pragma region bitwise
+  instance->registerToken(Op::AND_I8,      "and_i8",      {});
+  instance->registerToken(Op::AND_U8,      "and_u8",      {});
+  instance->registerToken(Op::AND_I16,     "and_i16",     {});
+  instance->registerToken(Op::AND_U16,     "and_u16",     {});
+  instance->registerToken(Op::AND_I32,     "and_i32",     {});
+  instance->registerToken(Op::AND_U32,     "and_u32",     {});
+  instance->registerToken(Op::AND_I64,     "and_i64",     {});
+  instance->registerToken(Op::AND_U64,     "and_u64",     {});
+  instance->registerToken(Op::OR_I8,       "or_i8",       {});
+  instance->registerToken(Op::OR_U8,       "or_u8",       {});
+  instance->registerToken(Op::OR_I16,      "or_i16",      {});
+  instance->registerToken(Op::OR_U16,      "or_u16",      {});
+  instance->registerToken(Op::OR_I32,      "or_i32",      {});
+  instance->registerToken(Op::OR_U32,      "or_u32",      {});
+  instance->registerToken(Op::OR_I64,      "or_i64",      {});
+  instance->registerToken(Op::OR_U64,      "or_u64",      {});
+  instance->registerToken(Op::XOR_I8,      "xor_i8",      {});
+  instance->registerToken(Op::XOR_U8,      "xor_u8",      {});
+  instance->registerToken(Op::XOR_I16,     "xor_i16",     {});
+  instance->registerToken(Op::XOR_U16,     "xor_u16",     {});
+  instance->registerToken(Op::XOR_I32,     "xor_i32",     {});
+  instance->registerToken(Op::XOR_U32,     "xor_u32",     {});
+  instance->registerToken(Op::XOR_I64,     "xor_i64",     {});
+  instance->registerToken(Op::XOR_U64,     "xor_u64",     {});
+  instance->registerToken(Op::NOT_I8,      "not_i8",      {});
+  instance->registerToken(Op::NOT_U8,      "not_u8",      {});
+  instance->registerToken(Op::NOT_I16,     "not_i16",     {});
+  instance->registerToken(Op::NOT_U16,     "not_u16",     {});
+  instance->registerToken(Op::NOT_I32,     "not_i32",     {});
+  instance->registerToken(Op::NOT_U32,     "not_u32",     {});
+  instance->registerToken(Op::NOT_I64,     "not_i64",     {});
+  instance->registerToken(Op::NOT_U64,     "not_u64",     {});
+  instance->registerToken(Op::SHL_I8,      "shl_i8",      {});
+  instance->registerToken(Op::SHL_U8,      "shl_u8",      {});
+  instance->registerToken(Op::SHL_I16,     "shl_i16",     {});
+  instance->registerToken(Op::SHL_U16,     "shl_u16",     {});
+  instance->registerToken(Op::SHL_I32,     "shl_i32",     {});
+  instance->registerToken(Op::SHL_U32,     "shl_u32",     {});
+  instance->registerToken(Op::SHL_I64,     "shl_i64",     {});
+  instance->registerToken(Op::SHL_U64,     "shl_u64",     {});
+  instance->registerToken(Op::SHR_I8,      "shr_i8",      {});
+  instance->registerToken(Op::SHR_U8,      "shr_u8",      {});
+  instance->registerToken(Op::SHR_I16,     "shr_i16",     {});
+  instance->registerToken(Op::SHR_U16,     "shr_u16",     {});
+  instance->registerToken(Op::SHR_I32,     "shr_i32",     {});
+  instance->registerToken(Op::SHR_U32,     "shr_u32",     {});
+  instance->registerToken(Op::SHR_I64,     "shr_i64",     {});
+  instance->registerToken(Op::SHR_U64,     "shr_u64",     {});
+  instance->registerToken(Op::SAR_I8,      "sar_i8",      {});
+  instance->registerToken(Op::SAR_U8,      "sar_u8",      {});
+  instance->registerToken(Op::SAR_I16,     "sar_i16",     {});
+  instance->registerToken(Op::SAR_U16,     "sar_u16",     {});
+  instance->registerToken(Op::SAR_I32,     "sar_i32",     {});
+  instance->registerToken(Op::SAR_U32,     "sar_u32",     {});
+  instance->registerToken(Op::SAR_I64,     "sar_i64",     {});
+  instance->registerToken(Op::SAR_U64,     "sar_u64",     {});
+  instance->registerToken(Op::ROTL_I8,     "rotl_i8",     {});
+  instance->registerToken(Op::ROTL_U8,     "rotl_u8",     {});
+  instance->registerToken(Op::ROTL_I16,    "rotl_i16",    {});
+  instance->registerToken(Op::ROTL_U16,    "rotl_u16",    {});
+  instance->registerToken(Op::ROTL_I32,    "rotl_i32",    {});
+  instance->registerToken(Op::ROTL_U32,    "rotl_u32",    {});
+  instance->registerToken(Op::ROTL_I64,    "rotl_i64",    {});
+  instance->registerToken(Op::ROTL_U64,    "rotl_u64",    {});
+  instance->registerToken(Op::ROTR_I8,     "rotr_i8",     {});
+  instance->registerToken(Op::ROTR_U8,     "rotr_u8",     {});
+  instance->registerToken(Op::ROTR_I16,    "rotr_i16",    {});
+  instance->registerToken(Op::ROTR_U16,    "rotr_u16",    {});
+  instance->registerToken(Op::ROTR_I32,    "rotr_i32",    {});
+  instance->registerToken(Op::ROTR_U32,    "rotr_u32",    {});
+  instance->registerToken(Op::ROTR_I64,    "rotr_i64",    {});
+  instance->registerToken(Op::ROTR_U64,    "rotr_u64",    {});
+  instance->registerToken(Op::POPCNT_I8,   "popcnt_i8",   {});
+  instance->registerToken(Op::POPCNT_U8,   "popcnt_u8",   {});
+  instance->registerToken(Op::POPCNT_I16,  "popcnt_i16",  {});
+  instance->registerToken(Op::POPCNT_U16,  "popcnt_u16",  {});
+  instance->registerToken(Op::POPCNT_I32,  "popcnt_i32",  {});
+  instance->registerToken(Op::POPCNT_U32,  "popcnt_u32",  {});
+  instance->registerToken(Op::POPCNT_I64,  "popcnt_i64",  {});
+  instance->registerToken(Op::POPCNT_U64,  "popcnt_u64",  {});
+  instance->registerToken(Op::CLZ_I8,      "clz_i8",      {});
+  instance->registerToken(Op::CLZ_U8,      "clz_u8",      {});
+  instance->registerToken(Op::CLZ_I16,     "clz_i16",     {});
+  instance->registerToken(Op::CLZ_U16,     "clz_u16",     {});
+  instance->registerToken(Op::CLZ_I32,     "clz_i32",     {});
+  instance->registerToken(Op::CLZ_U32,     "clz_u32",     {});
+  instance->registerToken(Op::CLZ_I64,     "clz_i64",     {});
+  instance->registerToken(Op::CLZ_U64,     "clz_u64",     {});
+  instance->registerToken(Op::CTZ_I8,      "ctz_i8",      {});
+  instance->registerToken(Op::CTZ_U8,      "ctz_u8",      {});
+  instance->registerToken(Op::CTZ_I16,     "ctz_i16",     {});
+  instance->registerToken(Op::CTZ_U16,     "ctz_u16",     {});
+  instance->registerToken(Op::CTZ_I32,     "ctz_i32",     {});
+  instance->registerToken(Op::CTZ_U32,     "ctz_u32",     {});
+  instance->registerToken(Op::CTZ_I64,     "ctz_i64",     {});
+  instance->registerToken(Op::CTZ_U64,     "ctz_u64",     {});
+  #pragma endregion bitwise
+
+  #pragma region wide
+  instance->registerToken(Op::PUSH_I128,  "push_i128",  {DataType::_i128});
+  instance->registerToken(Op::PUSH_U128,  "push_u128",  {DataType::_u128});
+  instance->registerToken(Op::PUSH_F128,  "push_f128",  {DataType::_f128});
+  instance->registerToken(Op::PUSHL_I128, "pushl_i128", {DataType::_u8});
+  instance->registerToken(Op::PUSHL_U128, "pushl_u128", {DataType::_u8});
+  instance->registerToken(Op::PUSHL_F128, "pushl_f128", {DataType::_u8});
+  instance->registerToken(Op::POPL_I128,  "popl_i128",  {DataType::_u8});
+  instance->registerToken(Op::POPL_U128,  "popl_u128",  {DataType::_u8});
+  instance->registerToken(Op::POPL_F128,  "popl_f128",  {DataType::_u8});
+  instance->registerToken(Op::SETL_I128,  "setl_i128",  {DataType::_u8,DataType::_i128});
+  instance->registerToken(Op::SETL_U128,  "setl_u128",  {DataType::_u8,DataType::_u128});
+  instance->registerToken(Op::SETL_F128,  "setl_f128",  {DataType::_u8,DataType::_f128});
+  instance->registerToken(Op::ADD_I128,   "add_i128",   {});
+  instance->registerToken(Op::ADD_U128,   "add_u128",   {});
+  instance->registerToken(Op::ADD_F128,   "add_f128",   {});
+  instance->registerToken(Op::SUB_I128,   "sub_i128",   {});
+  instance->registerToken(Op::SUB_U128,   "sub_u128",   {});
+  instance->registerToken(Op::SUB_F128,   "sub_f128",   {});
+  instance->registerToken(Op::MUL_I128,   "mul_i128",   {});
+  instance->registerToken(Op::MUL_U128,   "mul_u128",   {});
+  instance->registerToken(Op::MUL_F128,   "mul_f128",   {});
+  instance->registerToken(Op::DIV_I128,   "div_i128",   {});
+  instance->registerToken(Op::DIV_U128,   "div_u128",   {});
+  instance->registerToken(Op::DIV_F128,   "div_f128",   {});
+  instance->registerToken(Op::REM_I128,   "rem_i128",   {});
+  instance->registerToken(Op::REM_U128,   "rem_u128",   {});
+  instance->registerToken(Op::REM_F128,   "rem_f128",   {});
+  instance->registerToken(Op::CMP_I128,   "cmp_i128",   {});
+  instance->registerToken(Op::CMP_U128,   "cmp_u128",   {});
+  instance->registerToken(Op::CMP_F128,   "cmp_f128",   {});
+  #pragma endregion wide
+
+  #pragma region math
+  instance->registerToken(Op::SQRT_F32,  "sqrt_f32",  {});
+  instance->registerToken(Op::SQRT_F64,  "sqrt_f64",  {});
+  instance->registerToken(Op::FLOOR_F32, "floor_f32", {});
+  instance->registerToken(Op::FLOOR_F64, "floor_f64", {});
+  instance->registerToken(Op::CEIL_F32,  "ceil_f32",  {});
+  instance->registerToken(Op::CEIL_F64,  "ceil_f64",  {});
+  instance->registerToken(Op::ROUND_F32, "round_f32", {});
+  instance->registerToken(Op::ROUND_F64, "round_f64", {});
+  instance->registerToken(Op::TRUNC_F32, "trunc_f32", {});
+  instance->registerToken(Op::TRUNC_F64, "trunc_f64", {});
+  instance->registerToken(Op::FMA_F32,   "fma_f32",   {});
+  instance->registerToken(Op::FMA_F64,   "fma_f64",   {});
+  instance->registerToken(Op::MIN_I8,    "min_i8",    {});
+  instance->registerToken(Op::MIN_U8,    "min_u8",    {});
+  instance->registerToken(Op::MIN_I16,   "min_i16",   {});
+  instance->registerToken(Op::MIN_U16,   "min_u16",   {});
+  instance->registerToken(Op::MIN_I32,   "min_i32",   {});
+  instance->registerToken(Op::MIN_U32,   "min_u32",   {});
+  instance->registerToken(Op::MIN_F32,   "min_f32",   {});
+  instance->registerToken(Op::MIN_I64,   "min_i64",   {});
+  instance->registerToken(Op::MIN_U64,   "min_u64",   {});
+  instance->registerToken(Op::MIN_F64,   "min_f64",   {});
+  instance->registerToken(Op::MAX_I8,    "max_i8",    {});
+  instance->registerToken(Op::MAX_U8,    "max_u8",    {});
+  instance->registerToken(Op::MAX_I16,   "max_i16",   {});
+  instance->registerToken(Op::MAX_U16,   "max_u16",   {});
+  instance->registerToken(Op::MAX_I32,   "max_i32",   {});
+  instance->registerToken(Op::MAX_U32,   "max_u32",   {});
+  instance->registerToken(Op::MAX_F32,   "max_f32",   {});
+  instance->registerToken(Op::MAX_I64,   "max_i64",   {});
+  instance->registerToken(Op::MAX_U64,   "max_u64",   {});
+  instance->registerToken(Op::MAX_F64,   "max_f64",   {});
+  #pragma endregion math
+
+  #pragma region cvt
+  instance->registerToken(Op::CVT_I8_I8,   "cvt_i8_i8",   {});
+  instance->registerToken(Op::CVT_I8_U8,   "cvt_i8_u8",   {});
+  instance->registerToken(Op::CVT_I8_I16,  "cvt_i8_i16",  {});
+  instance->registerToken(Op::CVT_I8_U16,  "cvt_i8_u16",  {});
+  instance->registerToken(Op::CVT_I8_I32,  "cvt_i8_i32",  {});
+  instance->registerToken(Op::CVT_I8_U32,  "cvt_i8_u32",  {});
+  instance->registerToken(Op::CVT_I8_F32,  "cvt_i8_f32",  {});
+  instance->registerToken(Op::CVT_I8_I64,  "cvt_i8_i64",  {});
+  instance->registerToken(Op::CVT_I8_U64,  "cvt_i8_u64",  {});
+  instance->registerToken(Op::CVT_I8_F64,  "cvt_i8_f64",  {});
+  instance->registerToken(Op::CVT_U8_I8,   "cvt_u8_i8",   {});
+  instance->registerToken(Op::CVT_U8_U8,   "cvt_u8_u8",   {});
+  instance->registerToken(Op::CVT_U8_I16,  "cvt_u8_i16",  {});
+  instance->registerToken(Op::CVT_U8_U16,  "cvt_u8_u16",  {});
+  instance->registerToken(Op::CVT_U8_I32,  "cvt_u8_i32",  {});
+  instance->registerToken(Op::CVT_U8_U32,  "cvt_u8_u32",  {});
+  instance->registerToken(Op::CVT_U8_F32,  "cvt_u8_f32",  {});
+  instance->registerToken(Op::CVT_U8_I64,  "cvt_u8_i64",  {});
+  instance->registerToken(Op::CVT_U8_U64,  "cvt_u8_u64",  {});
+  instance->registerToken(Op::CVT_U8_F64,  "cvt_u8_f64",  {});
+  instance->registerToken(Op::CVT_I16_I8,  "cvt_i16_i8",  {});
+  instance->registerToken(Op::CVT_I16_U8,  "cvt_i16_u8",  {});
+  instance->registerToken(Op::CVT_I16_I16, "cvt_i16_i16", {});
+  instance->registerToken(Op::CVT_I16_U16, "cvt_i16_u16", {});
+  instance->registerToken(Op::CVT_I16_I32, "cvt_i16_i32", {});
+  instance->registerToken(Op::CVT_I16_U32, "cvt_i16_u32", {});
+  instance->registerToken(Op::CVT_I16_F32, "cvt_i16_f32", {});
+  instance->registerToken(Op::CVT_I16_I64, "cvt_i16_i64", {});
+  instance->registerToken(Op::CVT_I16_U64, "cvt_i16_u64", {});
+  instance->registerToken(Op::CVT_I16_F64, "cvt_i16_f64", {});
+  instance->registerToken(Op::CVT_U16_I8,  "cvt_u16_i8",  {});
+  instance->registerToken(Op::CVT_U16_U8,  "cvt_u16_u8",  {});
+  instance->registerToken(Op::CVT_U16_I16, "cvt_u16_i16", {});
+  instance->registerToken(Op::CVT_U16_U16, "cvt_u16_u16", {});
+  instance->registerToken(Op::CVT_U16_I32, "cvt_u16_i32", {});
+  instance->registerToken(Op::CVT_U16_U32, "cvt_u16_u32", {});
+  instance->registerToken(Op::CVT_U16_F32, "cvt_u16_f32", {});
+  instance->registerToken(Op::CVT_U16_I64, "cvt_u16_i64", {});
+  instance->registerToken(Op::CVT_U16_U64, "cvt_u16_u64", {});
+  instance->registerToken(Op::CVT_U16_F64, "cvt_u16_f64", {});
+  instance->registerToken(Op::CVT_I32_I8,  "cvt_i32_i8",  {});
+  instance->registerToken(Op::CVT_I32_U8,  "cvt_i32_u8",  {});
+  instance->registerToken(Op::CVT_I32_I16, "cvt_i32_i16", {});
+  instance->registerToken(Op::CVT_I32_U16, "cvt_i32_u16", {});
+  instance->registerToken(Op::CVT_I32_I32, "cvt_i32_i32", {});
+  instance->registerToken(Op::CVT_I32_U32, "cvt_i32_u32", {});
+  instance->registerToken(Op::CVT_I32_F32, "cvt_i32_f32", {});
+  instance->registerToken(Op::CVT_I32_I64, "cvt_i32_i64", {});
+  instance->registerToken(Op::CVT_I32_U64, "cvt_i32_u64", {});
+  instance->registerToken(Op::CVT_I32_F64, "cvt_i32_f64", {});
+  instance->registerToken(Op::CVT_U32_I8,  "cvt_u32_i8",  {});
+  instance->registerToken(Op::CVT_U32_U8,  "cvt_u32_u8",  {});
+  instance->registerToken(Op::CVT_U32_I16, "cvt_u32_i16", {});
+  instance->registerToken(Op::CVT_U32_U16, "cvt_u32_u16", {});
+  instance->registerToken(Op::CVT_U32_I32, "cvt_u32_i32", {});
+  instance->registerToken(Op::CVT_U32_U32, "cvt_u32_u32", {});
+  instance->registerToken(Op::CVT_U32_F32, "cvt_u32_f32", {});
+  instance->registerToken(Op::CVT_U32_I64, "cvt_u32_i64", {});
+  instance->registerToken(Op::CVT_U32_U64, "cvt_u32_u64", {});
+  instance->registerToken(Op::CVT_U32_F64, "cvt_u32_f64", {});
+  instance->registerToken(Op::CVT_F32_I8,  "cvt_f32_i8",  {});
+  instance->registerToken(Op::CVT_F32_U8,  "cvt_f32_u8",  {});
+  instance->registerToken(Op::CVT_F32_I16, "cvt_f32_i16", {});
+  instance->registerToken(Op::CVT_F32_U16, "cvt_f32_u16", {});
+  instance->registerToken(Op::CVT_F32_I32, "cvt_f32_i32", {});
+  instance->registerToken(Op::CVT_F32_U32, "cvt_f32_u32", {});
+  instance->registerToken(Op::CVT_F32_F32, "cvt_f32_f32", {});
+  instance->registerToken(Op::CVT_F32_I64, "cvt_f32_i64", {});
+  instance->registerToken(Op::CVT_F32_U64, "cvt_f32_u64", {});
+  instance->registerToken(Op::CVT_F32_F64, "cvt_f32_f64", {});
+  instance->registerToken(Op::CVT_I64_I8,  "cvt_i64_i8",  {});
+  instance->registerToken(Op::CVT_I64_U8,  "cvt_i64_u8",  {});
+  instance->registerToken(Op::CVT_I64_I16, "cvt_i64_i16", {});
+  instance->registerToken(Op::CVT_I64_U16, "cvt_i64_u16", {});
+  instance->registerToken(Op::CVT_I64_I32, "cvt_i64_i32", {});
+  instance->registerToken(Op::CVT_I64_U32, "cvt_i64_u32", {});
+  instance->registerToken(Op::CVT_I64_F32, "cvt_i64_f32", {});
+  instance->registerToken(Op::CVT_I64_I64, "cvt_i64_i64", {});
+  instance->registerToken(Op::CVT_I64_U64, "cvt_i64_u64", {});
+  instance->registerToken(Op::CVT_I64_F64, "cvt_i64_f64", {});
+  instance->registerToken(Op::CVT_U64_I8,  "cvt_u64_i8",  {});
+  instance->registerToken(Op::CVT_U64_U8,  "cvt_u64_u8",  {});
+  instance->registerToken(Op::CVT_U64_I16, "cvt_u64_i16", {});
+  instance->registerToken(Op::CVT_U64_U16, "cvt_u64_u16", {});
+  instance->registerToken(Op::CVT_U64_I32, "cvt_u64_i32", {});
+  instance->registerToken(Op::CVT_U64_U32, "cvt_u64_u32", {});
+  instance->registerToken(Op::CVT_U64_F32, "cvt_u64_f32", {});
+  instance->registerToken(Op::CVT_U64_I64, "cvt_u64_i64", {});
+  instance->registerToken(Op::CVT_U64_U64, "cvt_u64_u64", {});
+  instance->registerToken(Op::CVT_U64_F64, "cvt_u64_f64", {});
+  instance->registerToken(Op::CVT_F64_I8,  "cvt_f64_i8",  {});
+  instance->registerToken(Op::CVT_F64_U8,  "cvt_f64_u8",  {});
+  instance->registerToken(Op::CVT_F64_I16, "cvt_f64_i16", {});
+  instance->registerToken(Op::CVT_F64_U16, "cvt_f64_u16", {});
+  instance->registerToken(Op::CVT_F64_I32, "cvt_f64_i32", {});
+  instance->registerToken(Op::CVT_F64_U32, "cvt_f64_u32", {});
+  instance->registerToken(Op::CVT_F64_F32, "cvt_f64_f32", {});
+  instance->registerToken(Op::CVT_F64_I64, "cvt_f64_i64", {});
+  instance->registerToken(Op::CVT_F64_U64, "cvt_f64_u64", {});
+  instance->registerToken(Op::CVT_F64_F64, "cvt_f64_f64", {});
+  #pragma endregion cvt
+
+  #pragma region loop
+  instance->registerToken(Op::LOOP_I8,    "loop_i8",   {DataType::_u8,DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::LOOP_U8,    "loop_u8",   {DataType::_u8,DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::LOOP_I16,   "loop_i16",  {DataType::_u8,DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::LOOP_U16,   "loop_u16",  {DataType::_u8,DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::LOOP_I32,   "loop_i32",  {DataType::_u8,DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::LOOP_U32,   "loop_u32",  {DataType::_u8,DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::LOOP_F32,   "loop_f32",  {DataType::_u8,DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::LOOP_I64,   "loop_i64",  {DataType::_u8,DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::LOOP_U64,   "loop_u64",  {DataType::_u8,DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::LOOP_F64,   "loop_f64",  {DataType::_u8,DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::DJNZ_I8,    "djnz_i8",   {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_U8,    "djnz_u8",   {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_I16,   "djnz_i16",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_U16,   "djnz_u16",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_I32,   "djnz_i32",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_U32,   "djnz_u32",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_F32,   "djnz_f32",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_I64,   "djnz_i64",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_U64,   "djnz_u64",  {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::DJNZ_F64,   "djnz_f64",  {DataType::_u8,DataType::_u64});
+  #pragma endregion loop
+
+  #pragma region array
+  instance->registerToken(Op::ANEW_I8,     "anew_i8",       {});
+  instance->registerToken(Op::ANEW_U8,     "anew_u8",       {});
+  instance->registerToken(Op::ANEW_BOOL,   "anew_bool",     {});
+  instance->registerToken(Op::ANEW_I16,    "anew_i16",      {});
+  instance->registerToken(Op::ANEW_U16,    "anew_u16",      {});
+  instance->registerToken(Op::ANEW_I32,    "anew_i32",      {});
+  instance->registerToken(Op::ANEW_U32,    "anew_u32",      {});
+  instance->registerToken(Op::ANEW_F32,    "anew_f32",      {});
+  instance->registerToken(Op::ANEW_I64,    "anew_i64",      {});
+  instance->registerToken(Op::ANEW_U64,    "anew_u64",      {});
+  instance->registerToken(Op::ANEW_F64,    "anew_f64",      {});
+  instance->registerToken(Op::ALEN,        "alen",          {});
+  instance->registerToken(Op::ASLICE,      "aslice",        {});
+  instance->registerToken(Op::ALOAD_I8,    "aload_i8",      {});
+  instance->registerToken(Op::ALOAD_U8,    "aload_u8",      {});
+  instance->registerToken(Op::ALOAD_BOOL,  "aload_bool",    {});
+  instance->registerToken(Op::ALOAD_I16,   "aload_i16",     {});
+  instance->registerToken(Op::ALOAD_U16,   "aload_u16",     {});
+  instance->registerToken(Op::ALOAD_I32,   "aload_i32",     {});
+  instance->registerToken(Op::ALOAD_U32,   "aload_u32",     {});
+  instance->registerToken(Op::ALOAD_F32,   "aload_f32",     {});
+  instance->registerToken(Op::ALOAD_I64,   "aload_i64",     {});
+  instance->registerToken(Op::ALOAD_U64,   "aload_u64",     {});
+  instance->registerToken(Op::ALOAD_F64,   "aload_f64",     {});
+  instance->registerToken(Op::ASTORE_I8,   "astore_i8",     {});
+  instance->registerToken(Op::ASTORE_U8,   "astore_u8",     {});
+  instance->registerToken(Op::ASTORE_BOOL, "astore_bool",   {});
+  instance->registerToken(Op::ASTORE_I16,  "astore_i16",    {});
+  instance->registerToken(Op::ASTORE_U16,  "astore_u16",    {});
+  instance->registerToken(Op::ASTORE_I32,  "astore_i32",    {});
+  instance->registerToken(Op::ASTORE_U32,  "astore_u32",    {});
+  instance->registerToken(Op::ASTORE_F32,  "astore_f32",    {});
+  instance->registerToken(Op::ASTORE_I64,  "astore_i64",    {});
+  instance->registerToken(Op::ASTORE_U64,  "astore_u64",    {});
+  instance->registerToken(Op::ASTORE_F64,  "astore_f64",    {});
+  instance->registerToken(Op::ALOADL_I8,   "aloadl_i8",     {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_U8,   "aloadl_u8",     {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_BOOL, "aloadl_bool",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_I16,  "aloadl_i16",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_U16,  "aloadl_u16",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_I32,  "aloadl_i32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_U32,  "aloadl_u32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_F32,  "aloadl_f32",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_I64,  "aloadl_i64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_U64,  "aloadl_u64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADL_F64,  "aloadl_f64",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_I8,  "astorel_i8",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_U8,  "astorel_u8",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_BOOL, "astorel_bool",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_I16, "astorel_i16",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_U16, "astorel_u16",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_I32, "astorel_i32",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_U32, "astorel_u32",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_F32, "astorel_f32",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_I64, "astorel_i64",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_U64, "astorel_u64",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTOREL_F64, "astorel_f64",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_I8,  "aloadlu_i8",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_U8,  "aloadlu_u8",    {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_BOOL, "aloadlu_bool",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_I16, "aloadlu_i16",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_U16, "aloadlu_u16",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_I32, "aloadlu_i32",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_U32, "aloadlu_u32",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_F32, "aloadlu_f32",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_I64, "aloadlu_i64",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_U64, "aloadlu_u64",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ALOADLU_F64, "aloadlu_f64",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_I8, "astorelu_i8",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_U8, "astorelu_u8",   {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_BOOL, "astorelu_bool", {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_I16, "astorelu_i16",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_U16, "astorelu_u16",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_I32, "astorelu_i32",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_U32, "astorelu_u32",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_F32, "astorelu_f32",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_I64, "astorelu_i64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_U64, "astorelu_u64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::ASTORELU_F64, "astorelu_f64",  {DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::BRSIZE,      "brsize",        {DataType::_u8,DataType::_u64,DataType::_u64});
+  #pragma endregion array
+
+  #pragma region memory
+  instance->registerToken(Op::SADDR,   "saddr",    {DataType::_u32});
+  instance->registerToken(Op::MEMCOPY, "memcopy",  {});
+  instance->registerToken(Op::MEMFILL, "memfill",  {});
+  instance->registerToken(Op::MEMCMP,  "memcmp",   {});
+  instance->registerToken(Op::MEMFIND, "memfind",  {});
+  #pragma endregion memory
+
+  #pragma region string
+  instance->registerToken(Op::STRK,    "strk",     {DataType::_u32});
+  instance->registerToken(Op::STRLEN,  "strlen",   {});
+  instance->registerToken(Op::STRCAT,  "strcat",   {});
+  instance->registerToken(Op::STRCMP,  "strcmp",   {});
+  instance->registerToken(Op::STREQ,   "streq",    {});
+  instance->registerToken(Op::STRHASH, "strhash",  {});
+  instance->registerToken(Op::STRSUB,  "strsub",   {});
+  instance->registerToken(Op::STRFREE, "strfree",  {});
+  #pragma endregion string
+
+  #pragma region trap
+  instance->registerToken(Op::ONTRAP,  "ontrap",   {DataType::_u64});
+  instance->registerToken(Op::OFFTRAP, "offtrap",  {});
+  instance->registerToken(Op::RAISE,   "raise",    {});
+  #pragma endregion trap
+
+  #pragma region fused
+  instance->registerToken(Op::BRI_Z_I8,     "bri_z_i8",     {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_U8,     "bri_z_u8",     {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_I16,    "bri_z_i16",    {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_U16,    "bri_z_u16",    {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_I32,    "bri_z_i32",    {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_U32,    "bri_z_u32",    {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_F32,    "bri_z_f32",    {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_I64,    "bri_z_i64",    {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_U64,    "bri_z_u64",    {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRI_Z_F64,    "bri_z_f64",    {DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_I8,    "bri_nz_i8",    {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_U8,    "bri_nz_u8",    {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_I16,   "bri_nz_i16",   {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_U16,   "bri_nz_u16",   {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_I32,   "bri_nz_i32",   {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_U32,   "bri_nz_u32",   {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_F32,   "bri_nz_f32",   {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_I64,   "bri_nz_i64",   {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_U64,   "bri_nz_u64",   {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRI_NZ_F64,   "bri_nz_f64",   {DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRI_L_I8,     "bri_l_i8",     {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRI_L_U8,     "bri_l_u8",     {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRI_L_I16,    "bri_l_i16",    {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRI_L_U16,    "bri_l_u16",    {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRI_L_I32,    "bri_l_i32",    {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRI_L_U32,    "bri_l_u32",    {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRI_L_F32,    "bri_l_f32",    {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRI_L_I64,    "bri_l_i64",    {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRI_L_U64,    "bri_l_u64",    {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRI_L_F64,    "bri_l_f64",    {DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRI_G_I8,     "bri_g_i8",     {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRI_G_U8,     "bri_g_u8",     {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRI_G_I16,    "bri_g_i16",    {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRI_G_U16,    "bri_g_u16",    {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRI_G_I32,    "bri_g_i32",    {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRI_G_U32,    "bri_g_u32",    {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRI_G_F32,    "bri_g_f32",    {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRI_G_I64,    "bri_g_i64",    {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRI_G_U64,    "bri_g_u64",    {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRI_G_F64,    "bri_g_f64",    {DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_I8,    "bri_nl_i8",    {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_U8,    "bri_nl_u8",    {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_I16,   "bri_nl_i16",   {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_U16,   "bri_nl_u16",   {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_I32,   "bri_nl_i32",   {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_U32,   "bri_nl_u32",   {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_F32,   "bri_nl_f32",   {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_I64,   "bri_nl_i64",   {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_U64,   "bri_nl_u64",   {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRI_NL_F64,   "bri_nl_f64",   {DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_I8,    "bri_ng_i8",    {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_U8,    "bri_ng_u8",    {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_I16,   "bri_ng_i16",   {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_U16,   "bri_ng_u16",   {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_I32,   "bri_ng_i32",   {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_U32,   "bri_ng_u32",   {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_F32,   "bri_ng_f32",   {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_I64,   "bri_ng_i64",   {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_U64,   "bri_ng_u64",   {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::BRI_NG_F64,   "bri_ng_f64",   {DataType::_f64,DataType::_u64});
+  instance->registerToken(Op::MOVL2_I8,     "movl2_i8",     {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_U8,     "movl2_u8",     {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_BOOL,   "movl2_bool",   {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_I16,    "movl2_i16",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_U16,    "movl2_u16",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_I32,    "movl2_i32",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_U32,    "movl2_u32",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_F32,    "movl2_f32",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_I64,    "movl2_i64",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_U64,    "movl2_u64",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::MOVL2_F64,    "movl2_f64",    {DataType::_u8,DataType::_u8,DataType::_u8,DataType::_u8});
+  instance->registerToken(Op::LOOPT_I8,     "loopt_i8",     {DataType::_i8,DataType::_u64});
+  instance->registerToken(Op::LOOPT_U8,     "loopt_u8",     {DataType::_u8,DataType::_u64});
+  instance->registerToken(Op::LOOPT_I16,    "loopt_i16",    {DataType::_i16,DataType::_u64});
+  instance->registerToken(Op::LOOPT_U16,    "loopt_u16",    {DataType::_u16,DataType::_u64});
+  instance->registerToken(Op::LOOPT_I32,    "loopt_i32",    {DataType::_i32,DataType::_u64});
+  instance->registerToken(Op::LOOPT_U32,    "loopt_u32",    {DataType::_u32,DataType::_u64});
+  instance->registerToken(Op::LOOPT_F32,    "loopt_f32",    {DataType::_f32,DataType::_u64});
+  instance->registerToken(Op::LOOPT_I64,    "loopt_i64",    {DataType::_i64,DataType::_u64});
+  instance->registerToken(Op::LOOPT_U64,    "loopt_u64",    {DataType::_u64,DataType::_u64});
+  instance->registerToken(Op::LOOPT_F64,    "loopt_f64",    {DataType::_f64,DataType::_u64});
+  #pragma endregion fused
+
   return *instance;
 }
 
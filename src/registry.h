@@ -4,6 +4,7 @@
 
 #include <string>
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace pushle {
@@ -43,6 +44,15 @@ public:
     return std::nullopt;
   }
   
+  inline std::optional<Token> const getToken(const Op op) const {
+    for (const auto &t : tokens) {
+      if (t.getOp() == op) {
+        return t;
+      }
+    }
+    return std::nullopt;
+  }
+
   inline void registerToken(const Op op, const std::string &token, std::vector<DataType> arguments) {
     tokens.push_back(Token(op, token, arguments));
   }
@@ -2,18 +2,37 @@
 #include <cstdint>
 
 #include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include "metrics.h"
+#include "module.h"
 #include "ops.h"
 #include "pushle.h"
+#include "trace.h"
 
 int main(int argc, char** argv) {
-  if (argc != 2) {
-    fmt::print("Usage: {} <file>\n", argv[0]);
+  std::string trace_path;
+  std::string metrics_path;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-t" && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (arg == "-m" && i + 1 < argc) {
+      metrics_path = argv[++i];
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 1) {
+    fmt::print("Usage: {} [-t trace] [-m metrics] <file>\n", argv[0]);
     return 1;
   }
-  std::ifstream ifs(argv[1]);
+  std::ifstream ifs(paths[0]);
   if (!ifs) {
-    fmt::print("Failed to open file: {}\n", argv[1]);
+    fmt::print("Failed to open file: {}\n", paths[0]);
     return 1;
   }
   std::vector<uint8_t> program;
@@ -21,8 +40,41 @@ int main(int argc, char** argv) {
   while (ifs.read(reinterpret_cast<char*>(&byte), sizeof(byte))) {
     program.push_back(byte);
   }
+  pushle::Module module = pushle::Module::load(program.data(), program.size());
   pushle::VM vm;
-  vm.run(program.data(), program.size());
+  // With -t the last instructions are saved for tracedump and with -m the
+  // VM's metrics (as Prometheus text for a .prom file, else JSON), also when
+  // the program fails.
+  std::optional<pushle::Tracer> tracer;
+  if (!trace_path.empty()) {
+    vm.trace(&tracer.emplace());
+  }
+  auto save = [&] {
+    if (tracer) {
+      tracer->write(trace_path);
+    }
+    if (!metrics_path.empty()) {
+      pushle::Metrics metrics = vm.metrics();
+      std::ofstream(metrics_path) << (metrics_path.ends_with(".prom") ? pushle::metrics_prometheus(metrics) : pushle::metrics_json(metrics));
+    }
+  };
+  pushle::RunStatus status;
+  try {
+    status = vm.run(module);
+  } catch (...) {
+    save();
+    throw;
+  }
+  save();
+  if (status == pushle::RUN_TRAPPED) {
+    fmt::print(stderr, "trap: {} at {:#x}\n", pushle::trap_name(vm.trap_code()), vm.trap_offset());
+    return 1;
+  }
+  // a program may well end with less than a u64 on the stack
+  if (vm.stack_depth() < pushle::stack_width(sizeof(uint64_t))) {
+    fmt::print("No u64 result ({} bytes on the stack)\n", vm.stack_depth());
+    return 0;
+  }
   fmt::print("Result as u64: {}\n", vm.get_u64());
   return 0;
 }
@@ -0,0 +1,122 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace pushle {
+
+Scheduler::Scheduler(size_t threads, uint64_t slice) : slice(slice) {
+  if (threads == 0 || slice == 0) {
+    throw std::runtime_error("Scheduler: threads and slice must be non-zero");
+  }
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back(&Scheduler::work, this);
+  }
+}
+
+Scheduler::~Scheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  ready.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void Scheduler::submit(VM &vm, const Module &module, Notify notify, size_t entry) {
+  vm.start(module, entry);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back({ &vm, std::move(notify) });
+    running++;
+  }
+  ready.notify_one();
+}
+
+void Scheduler::wake(VM &vm) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = parked.begin();
+    while (it != parked.end() && it->vm != &vm) {
+      ++it;
+    }
+    if (it == parked.end()) {
+      // woken from notify, before its worker got to park it
+      if (std::find(yielding.begin(), yielding.end(), &vm) != yielding.end() &&
+          std::find(early_wakes.begin(), early_wakes.end(), &vm) == early_wakes.end()) {
+        early_wakes.push_back(&vm);
+      }
+      return;
+    }
+    queue.push_back(std::move(*it));
+    parked.erase(it);
+  }
+  ready.notify_one();
+}
+
+void Scheduler::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this] { return running == 0; });
+}
+
+void Scheduler::work() {
+  for (;;) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ready.wait(lock, [this] { return stopping || !queue.empty(); });
+      if (stopping) {
+        return;
+      }
+      task = std::move(queue.front());
+      queue.pop_front();
+    }
+
+    RunStatus status;
+    std::exception_ptr error;
+    try {
+      status = task.vm->resume(slice);
+    } catch (...) {
+      status = RUN_DONE;
+      error = std::current_exception();
+    }
+
+    if (status == RUN_YIELDED) {
+      std::lock_guard<std::mutex> lock(mutex);
+      yielding.push_back(task.vm);
+    }
+    if (status != RUN_BUDGET) {
+      task.notify(*task.vm, status, error);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    switch (status) {
+      case RUN_BUDGET:
+        queue.push_back(std::move(task));
+        ready.notify_one();
+        break;
+      case RUN_YIELDED: {
+        yielding.erase(std::find(yielding.begin(), yielding.end(), task.vm));
+        auto it = std::find(early_wakes.begin(), early_wakes.end(), task.vm);
+        if (it != early_wakes.end()) {
+          early_wakes.erase(it);
+          queue.push_back(std::move(task));
+          ready.notify_one();
+        } else {
+          parked.push_back(std::move(task));
+        }
+        break;
+      }
+      case RUN_DONE:
+      case RUN_TRAPPED:
+        if (--running == 0) {
+          finished.notify_all();
+        }
+        break;
+    }
+  }
+}
+
+} // namespace pushle
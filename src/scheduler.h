@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "module.h"
+#include "pushle.h"
+
+namespace pushle {
+  const uint64_t SCHEDULER_DEFAULT_SLICE = 4096; // backward branches per turn
+
+  // Runs many VMs on a fixed pool of threads. Each turn resumes one VM with a
+  // budget of `slice` backward branches; a VM that runs out goes to the back
+  // of the queue, so a long-running script delays the others by at most one
+  // slice per thread instead of holding a worker until it finishes.
+  //
+  // A VM that yields is parked until the host calls wake(). `notify` runs on
+  // a worker thread when a VM finishes (RUN_DONE, RUN_TRAPPED, or RUN_DONE
+  // with `error` set if it threw) and each time it yields (RUN_YIELDED).
+  class Scheduler {
+  public:
+    using Notify = std::function<void(VM &vm, RunStatus status, std::exception_ptr error)>;
+
+    explicit Scheduler(size_t threads, uint64_t slice = SCHEDULER_DEFAULT_SLICE);
+    // Stops the workers once their current turn ends; queued VMs are dropped.
+    ~Scheduler();
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    // `vm` and `module` must stay alive until `vm` is done.
+    void submit(VM &vm, const Module &module, Notify notify, size_t entry = 0);
+    // Requeues a VM that yielded. Has no effect on a VM that is not waiting
+    // for a wake: one that is queued, running a slice, or done.
+    void wake(VM &vm);
+    // Blocks until every submitted VM is done; parked VMs count as not done.
+    void wait();
+
+  private:
+    struct Task {
+      VM *vm;
+      Notify notify;
+    };
+
+    uint64_t slice;
+    std::mutex mutex;
+    std::condition_variable ready;    // signalled when the queue gains a task or on shutdown
+    std::condition_variable finished; // signalled when `running` drops to zero
+    std::deque<Task> queue;
+    std::vector<Task> parked;
+    std::vector<VM *> yielding;    // turn ended in a yield, not parked yet
+    std::vector<VM *> early_wakes; // woken while yielding
+    size_t running = 0; // submitted and not yet done
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    void work();
+  };
+};
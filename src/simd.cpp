@@ -0,0 +1,487 @@
+#include "simd.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace pushle::simd {
+
+namespace {
+
+template <size_t Size> struct MaskOf;
+template <> struct MaskOf<1> { using type = uint8_t; };
+template <> struct MaskOf<2> { using type = uint16_t; };
+template <> struct MaskOf<4> { using type = uint32_t; };
+template <> struct MaskOf<8> { using type = uint64_t; };
+
+template <typename T>
+using mask_t = typename MaskOf<sizeof(T)>::type;
+
+// Integer lanes wrap around like the hardware instructions do.
+template <typename T> struct Add {
+  static T apply(T a, T b) {
+    if constexpr (std::is_integral_v<T>) return (T)((uint64_t)a + (uint64_t)b);
+    else return a + b;
+  }
+};
+
+template <typename T> struct Sub {
+  static T apply(T a, T b) {
+    if constexpr (std::is_integral_v<T>) return (T)((uint64_t)a - (uint64_t)b);
+    else return a - b;
+  }
+};
+
+template <typename T> struct Mul {
+  static T apply(T a, T b) {
+    if constexpr (std::is_integral_v<T>) return (T)((uint64_t)a * (uint64_t)b);
+    else return a * b;
+  }
+};
+
+// Same operand order as minps/maxps: the second operand wins on ties and NaN.
+template <typename T> struct Min { static T apply(T a, T b) { return a < b ? a : b; } };
+template <typename T> struct Max { static T apply(T a, T b) { return a > b ? a : b; } };
+template <typename T> struct Eq { static bool apply(T a, T b) { return a == b; } };
+template <typename T> struct Lt { static bool apply(T a, T b) { return a < b; } };
+
+template <typename T, size_t N, typename F>
+void scalar_binary(void *dst, const void *a, const void *b) {
+  T x[N], y[N];
+  memcpy(x, a, sizeof(x));
+  memcpy(y, b, sizeof(y));
+  for (size_t i = 0; i < N; i++)
+    x[i] = F::apply(x[i], y[i]);
+  memcpy(dst, x, sizeof(x));
+}
+
+template <typename T, size_t N, typename F>
+void scalar_compare(void *dst, const void *a, const void *b) {
+  T x[N], y[N];
+  mask_t<T> m[N];
+  memcpy(x, a, sizeof(x));
+  memcpy(y, b, sizeof(y));
+  for (size_t i = 0; i < N; i++)
+    m[i] = F::apply(x[i], y[i]) ? (mask_t<T>)~(mask_t<T>)0 : 0;
+  memcpy(dst, m, sizeof(m));
+}
+
+// Reduces pairwise (lane i with lane i + N/2, then halving again) so that
+// float results are bit-identical to the shuffle-based SIMD reductions.
+template <typename T, size_t N, typename F>
+void scalar_reduce(void *dst, const void *v) {
+  T x[N];
+  memcpy(x, v, sizeof(x));
+  for (size_t n = N / 2; n > 0; n /= 2)
+    for (size_t i = 0; i < n; i++)
+      x[i] = F::apply(x[i], x[i + n]);
+  memcpy(dst, &x[0], sizeof(T));
+}
+
+size_t scalar_find(const void *data, uint8_t byte, size_t size) {
+  const void *found = memchr(data, byte, size);
+  return found ? (const uint8_t *)found - (const uint8_t *)data : size;
+}
+
+#define FILL_SCALAR(shape, T, N) \
+  t.binary[ADD][shape] = scalar_binary<T, N, Add<T>>; \
+  t.binary[SUB][shape] = scalar_binary<T, N, Sub<T>>; \
+  t.binary[MUL][shape] = scalar_binary<T, N, Mul<T>>; \
+  t.binary[MIN][shape] = scalar_binary<T, N, Min<T>>; \
+  t.binary[MAX][shape] = scalar_binary<T, N, Max<T>>; \
+  t.binary[CMPEQ][shape] = scalar_compare<T, N, Eq<T>>; \
+  t.binary[CMPLT][shape] = scalar_compare<T, N, Lt<T>>; \
+  t.reduce[SUM][shape] = scalar_reduce<T, N, Add<T>>; \
+  t.reduce[HMIN][shape] = scalar_reduce<T, N, Min<T>>; \
+  t.reduce[HMAX][shape] = scalar_reduce<T, N, Max<T>>;
+
+#if defined(__x86_64__)
+
+#define SSE41 __attribute__((target("sse4.1")))
+#define SSE42 __attribute__((target("sse4.2")))
+#define AVX __attribute__((target("avx")))
+#define AVX2 __attribute__((target("avx2")))
+
+#define KERNEL_PS(name, attr, expr) \
+  attr void name(void *dst, const void *a, const void *b) { \
+    __m128 x = _mm_loadu_ps((const float *)a), y = _mm_loadu_ps((const float *)b); \
+    _mm_storeu_ps((float *)dst, expr); \
+  }
+
+#define KERNEL_PD(name, attr, expr) \
+  attr void name(void *dst, const void *a, const void *b) { \
+    __m128d x = _mm_loadu_pd((const double *)a), y = _mm_loadu_pd((const double *)b); \
+    _mm_storeu_pd((double *)dst, expr); \
+  }
+
+#define KERNEL_SI(name, attr, expr) \
+  attr void name(void *dst, const void *a, const void *b) { \
+    __m128i x = _mm_loadu_si128((const __m128i *)a), y = _mm_loadu_si128((const __m128i *)b); \
+    _mm_storeu_si128((__m128i *)dst, expr); \
+  }
+
+#define KERNEL_PS256(name, attr, expr) \
+  attr void name(void *dst, const void *a, const void *b) { \
+    __m256 x = _mm256_loadu_ps((const float *)a), y = _mm256_loadu_ps((const float *)b); \
+    _mm256_storeu_ps((float *)dst, expr); \
+  }
+
+#define KERNEL_PD256(name, attr, expr) \
+  attr void name(void *dst, const void *a, const void *b) { \
+    __m256d x = _mm256_loadu_pd((const double *)a), y = _mm256_loadu_pd((const double *)b); \
+    _mm256_storeu_pd((double *)dst, expr); \
+  }
+
+#define KERNEL_SI256(name, attr, expr) \
+  attr void name(void *dst, const void *a, const void *b) { \
+    __m256i x = _mm256_loadu_si256((const __m256i *)a), y = _mm256_loadu_si256((const __m256i *)b); \
+    _mm256_storeu_si256((__m256i *)dst, expr); \
+  }
+
+// Unsigned less-than through the signed compare: flip the sign bit of both sides.
+#define BIAS(v, bits) _mm_xor_si128(v, _mm_set1_epi##bits(INT##bits##_MIN))
+#define BIAS256(v, bits) _mm256_xor_si256(v, _mm256_set1_epi##bits(INT##bits##_MIN))
+#define BIAS64(v) _mm_xor_si128(v, _mm_set1_epi64x(INT64_MIN))
+#define BIAS256_64(v) _mm256_xor_si256(v, _mm256_set1_epi64x(INT64_MIN))
+
+// SSE2 (x86-64 baseline)
+KERNEL_PS(add_ps, , _mm_add_ps(x, y))
+KERNEL_PS(sub_ps, , _mm_sub_ps(x, y))
+KERNEL_PS(mul_ps, , _mm_mul_ps(x, y))
+KERNEL_PS(min_ps, , _mm_min_ps(x, y))
+KERNEL_PS(max_ps, , _mm_max_ps(x, y))
+KERNEL_PS(cmpeq_ps, , _mm_cmpeq_ps(x, y))
+KERNEL_PS(cmplt_ps, , _mm_cmplt_ps(x, y))
+KERNEL_PD(add_pd, , _mm_add_pd(x, y))
+KERNEL_PD(sub_pd, , _mm_sub_pd(x, y))
+KERNEL_PD(mul_pd, , _mm_mul_pd(x, y))
+KERNEL_PD(min_pd, , _mm_min_pd(x, y))
+KERNEL_PD(max_pd, , _mm_max_pd(x, y))
+KERNEL_PD(cmpeq_pd, , _mm_cmpeq_pd(x, y))
+KERNEL_PD(cmplt_pd, , _mm_cmplt_pd(x, y))
+KERNEL_SI(add_epi8, , _mm_add_epi8(x, y))
+KERNEL_SI(sub_epi8, , _mm_sub_epi8(x, y))
+KERNEL_SI(add_epi16, , _mm_add_epi16(x, y))
+KERNEL_SI(sub_epi16, , _mm_sub_epi16(x, y))
+KERNEL_SI(add_epi32, , _mm_add_epi32(x, y))
+KERNEL_SI(sub_epi32, , _mm_sub_epi32(x, y))
+KERNEL_SI(add_epi64, , _mm_add_epi64(x, y))
+KERNEL_SI(sub_epi64, , _mm_sub_epi64(x, y))
+KERNEL_SI(mullo_epi16, , _mm_mullo_epi16(x, y))
+KERNEL_SI(min_epu8, , _mm_min_epu8(x, y))
+KERNEL_SI(max_epu8, , _mm_max_epu8(x, y))
+KERNEL_SI(min_epi16, , _mm_min_epi16(x, y))
+KERNEL_SI(max_epi16, , _mm_max_epi16(x, y))
+KERNEL_SI(cmpeq_epi8, , _mm_cmpeq_epi8(x, y))
+KERNEL_SI(cmpeq_epi16, , _mm_cmpeq_epi16(x, y))
+KERNEL_SI(cmpeq_epi32, , _mm_cmpeq_epi32(x, y))
+KERNEL_SI(cmplt_epi8, , _mm_cmplt_epi8(x, y))
+KERNEL_SI(cmplt_epi16, , _mm_cmplt_epi16(x, y))
+KERNEL_SI(cmplt_epi32, , _mm_cmplt_epi32(x, y))
+KERNEL_SI(cmplt_epu8, , _mm_cmplt_epi8(BIAS(x, 8), BIAS(y, 8)))
+KERNEL_SI(cmplt_epu16, , _mm_cmplt_epi16(BIAS(x, 16), BIAS(y, 16)))
+KERNEL_SI(cmplt_epu32, , _mm_cmplt_epi32(BIAS(x, 32), BIAS(y, 32)))
+
+// SSE4.1 / SSE4.2
+KERNEL_SI(mullo_epi32, SSE41, _mm_mullo_epi32(x, y))
+KERNEL_SI(min_epi8, SSE41, _mm_min_epi8(x, y))
+KERNEL_SI(max_epi8, SSE41, _mm_max_epi8(x, y))
+KERNEL_SI(min_epu16, SSE41, _mm_min_epu16(x, y))
+KERNEL_SI(max_epu16, SSE41, _mm_max_epu16(x, y))
+KERNEL_SI(min_epi32, SSE41, _mm_min_epi32(x, y))
+KERNEL_SI(max_epi32, SSE41, _mm_max_epi32(x, y))
+KERNEL_SI(min_epu32, SSE41, _mm_min_epu32(x, y))
+KERNEL_SI(max_epu32, SSE41, _mm_max_epu32(x, y))
+KERNEL_SI(cmpeq_epi64, SSE41, _mm_cmpeq_epi64(x, y))
+KERNEL_SI(cmplt_epi64, SSE42, _mm_cmpgt_epi64(y, x))
+KERNEL_SI(cmplt_epu64, SSE42, _mm_cmpgt_epi64(BIAS64(y), BIAS64(x)))
+
+// AVX
+KERNEL_PS256(add_ps256, AVX, _mm256_add_ps(x, y))
+KERNEL_PS256(sub_ps256, AVX, _mm256_sub_ps(x, y))
+KERNEL_PS256(mul_ps256, AVX, _mm256_mul_ps(x, y))
+KERNEL_PS256(min_ps256, AVX, _mm256_min_ps(x, y))
+KERNEL_PS256(max_ps256, AVX, _mm256_max_ps(x, y))
+KERNEL_PS256(cmpeq_ps256, AVX, _mm256_cmp_ps(x, y, _CMP_EQ_OQ))
+KERNEL_PS256(cmplt_ps256, AVX, _mm256_cmp_ps(x, y, _CMP_LT_OQ))
+KERNEL_PD256(add_pd256, AVX, _mm256_add_pd(x, y))
+KERNEL_PD256(sub_pd256, AVX, _mm256_sub_pd(x, y))
+KERNEL_PD256(mul_pd256, AVX, _mm256_mul_pd(x, y))
+KERNEL_PD256(min_pd256, AVX, _mm256_min_pd(x, y))
+KERNEL_PD256(max_pd256, AVX, _mm256_max_pd(x, y))
+KERNEL_PD256(cmpeq_pd256, AVX, _mm256_cmp_pd(x, y, _CMP_EQ_OQ))
+KERNEL_PD256(cmplt_pd256, AVX, _mm256_cmp_pd(x, y, _CMP_LT_OQ))
+
+// AVX2
+KERNEL_SI256(add_epi8_256, AVX2, _mm256_add_epi8(x, y))
+KERNEL_SI256(sub_epi8_256, AVX2, _mm256_sub_epi8(x, y))
+KERNEL_SI256(add_epi16_256, AVX2, _mm256_add_epi16(x, y))
+KERNEL_SI256(sub_epi16_256, AVX2, _mm256_sub_epi16(x, y))
+KERNEL_SI256(add_epi32_256, AVX2, _mm256_add_epi32(x, y))
+KERNEL_SI256(sub_epi32_256, AVX2, _mm256_sub_epi32(x, y))
+KERNEL_SI256(add_epi64_256, AVX2, _mm256_add_epi64(x, y))
+KERNEL_SI256(sub_epi64_256, AVX2, _mm256_sub_epi64(x, y))
+KERNEL_SI256(mullo_epi16_256, AVX2, _mm256_mullo_epi16(x, y))
+KERNEL_SI256(mullo_epi32_256, AVX2, _mm256_mullo_epi32(x, y))
+KERNEL_SI256(min_epi8_256, AVX2, _mm256_min_epi8(x, y))
+KERNEL_SI256(max_epi8_256, AVX2, _mm256_max_epi8(x, y))
+KERNEL_SI256(min_epu8_256, AVX2, _mm256_min_epu8(x, y))
+KERNEL_SI256(max_epu8_256, AVX2, _mm256_max_epu8(x, y))
+KERNEL_SI256(min_epi16_256, AVX2, _mm256_min_epi16(x, y))
+KERNEL_SI256(max_epi16_256, AVX2, _mm256_max_epi16(x, y))
+KERNEL_SI256(min_epu16_256, AVX2, _mm256_min_epu16(x, y))
+KERNEL_SI256(max_epu16_256, AVX2, _mm256_max_epu16(x, y))
+KERNEL_SI256(min_epi32_256, AVX2, _mm256_min_epi32(x, y))
+KERNEL_SI256(max_epi32_256, AVX2, _mm256_max_epi32(x, y))
+KERNEL_SI256(min_epu32_256, AVX2, _mm256_min_epu32(x, y))
+KERNEL_SI256(max_epu32_256, AVX2, _mm256_max_epu32(x, y))
+KERNEL_SI256(cmpeq_epi8_256, AVX2, _mm256_cmpeq_epi8(x, y))
+KERNEL_SI256(cmpeq_epi16_256, AVX2, _mm256_cmpeq_epi16(x, y))
+KERNEL_SI256(cmpeq_epi32_256, AVX2, _mm256_cmpeq_epi32(x, y))
+KERNEL_SI256(cmpeq_epi64_256, AVX2, _mm256_cmpeq_epi64(x, y))
+KERNEL_SI256(cmplt_epi8_256, AVX2, _mm256_cmpgt_epi8(y, x))
+KERNEL_SI256(cmplt_epi16_256, AVX2, _mm256_cmpgt_epi16(y, x))
+KERNEL_SI256(cmplt_epi32_256, AVX2, _mm256_cmpgt_epi32(y, x))
+KERNEL_SI256(cmplt_epi64_256, AVX2, _mm256_cmpgt_epi64(y, x))
+KERNEL_SI256(cmplt_epu8_256, AVX2, _mm256_cmpgt_epi8(BIAS256(y, 8), BIAS256(x, 8)))
+KERNEL_SI256(cmplt_epu16_256, AVX2, _mm256_cmpgt_epi16(BIAS256(y, 16), BIAS256(x, 16)))
+KERNEL_SI256(cmplt_epu32_256, AVX2, _mm256_cmpgt_epi32(BIAS256(y, 32), BIAS256(x, 32)))
+KERNEL_SI256(cmplt_epu64_256, AVX2, _mm256_cmpgt_epi64(BIAS256_64(y), BIAS256_64(x)))
+
+// Float reductions, in the same pairwise order as scalar_reduce.
+#define REDUCE_PS(name, attr, op) \
+  attr void name(void *dst, const void *v) { \
+    __m128 x = _mm_loadu_ps((const float *)v); \
+    x = op##_ps(x, _mm_movehl_ps(x, x)); \
+    x = op##_ss(x, _mm_shuffle_ps(x, x, 1)); \
+    _mm_store_ss((float *)dst, x); \
+  }
+
+#define REDUCE_PD(name, attr, op) \
+  attr void name(void *dst, const void *v) { \
+    __m128d x = _mm_loadu_pd((const double *)v); \
+    x = op##_sd(x, _mm_unpackhi_pd(x, x)); \
+    _mm_store_sd((double *)dst, x); \
+  }
+
+#define REDUCE_PS256(name, attr, op) \
+  attr void name(void *dst, const void *v) { \
+    __m256 y = _mm256_loadu_ps((const float *)v); \
+    __m128 x = op##_ps(_mm256_castps256_ps128(y), _mm256_extractf128_ps(y, 1)); \
+    x = op##_ps(x, _mm_movehl_ps(x, x)); \
+    x = op##_ss(x, _mm_shuffle_ps(x, x, 1)); \
+    _mm_store_ss((float *)dst, x); \
+  }
+
+#define REDUCE_PD256(name, attr, op) \
+  attr void name(void *dst, const void *v) { \
+    __m256d y = _mm256_loadu_pd((const double *)v); \
+    __m128d x = op##_pd(_mm256_castpd256_pd128(y), _mm256_extractf128_pd(y, 1)); \
+    x = op##_sd(x, _mm_unpackhi_pd(x, x)); \
+    _mm_store_sd((double *)dst, x); \
+  }
+
+REDUCE_PS(hsum_ps, , _mm_add)
+REDUCE_PS(hmin_ps, , _mm_min)
+REDUCE_PS(hmax_ps, , _mm_max)
+REDUCE_PD(hsum_pd, , _mm_add)
+REDUCE_PD(hmin_pd, , _mm_min)
+REDUCE_PD(hmax_pd, , _mm_max)
+REDUCE_PS256(hsum_ps256, AVX, _mm_add)
+REDUCE_PS256(hmin_ps256, AVX, _mm_min)
+REDUCE_PS256(hmax_ps256, AVX, _mm_max)
+REDUCE_PD256(hsum_pd256, AVX, _mm_add)
+REDUCE_PD256(hmin_pd256, AVX, _mm_min)
+REDUCE_PD256(hmax_pd256, AVX, _mm_max)
+
+AVX2 size_t find_epi8_256(const void *data, uint8_t byte, size_t size) {
+  const uint8_t *p = (const uint8_t *)data;
+  __m256i needle = _mm256_set1_epi8((char)byte);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(p + i));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, needle));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + scalar_find(p + i, byte, size - i);
+}
+
+#endif // __x86_64__
+
+KernelTable scalar_table() {
+  KernelTable t;
+  t.find = scalar_find;
+
+  FILL_SCALAR(I8X16, int8_t, 16)
+  FILL_SCALAR(U8X16, uint8_t, 16)
+  FILL_SCALAR(I16X8, int16_t, 8)
+  FILL_SCALAR(U16X8, uint16_t, 8)
+  FILL_SCALAR(I32X4, int32_t, 4)
+  FILL_SCALAR(U32X4, uint32_t, 4)
+  FILL_SCALAR(F32X4, float, 4)
+  FILL_SCALAR(I64X2, int64_t, 2)
+  FILL_SCALAR(U64X2, uint64_t, 2)
+  FILL_SCALAR(F64X2, double, 2)
+  FILL_SCALAR(I8X32, int8_t, 32)
+  FILL_SCALAR(U8X32, uint8_t, 32)
+  FILL_SCALAR(I16X16, int16_t, 16)
+  FILL_SCALAR(U16X16, uint16_t, 16)
+  FILL_SCALAR(I32X8, int32_t, 8)
+  FILL_SCALAR(U32X8, uint32_t, 8)
+  FILL_SCALAR(F32X8, float, 8)
+  FILL_SCALAR(I64X4, int64_t, 4)
+  FILL_SCALAR(U64X4, uint64_t, 4)
+  FILL_SCALAR(F64X4, double, 4)
+  return t;
+}
+
+KernelTable select_kernels() {
+  KernelTable t = scalar_table();
+
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+
+  t.binary[ADD][F32X4] = add_ps;
+  t.binary[SUB][F32X4] = sub_ps;
+  t.binary[MUL][F32X4] = mul_ps;
+  t.binary[MIN][F32X4] = min_ps;
+  t.binary[MAX][F32X4] = max_ps;
+  t.binary[CMPEQ][F32X4] = cmpeq_ps;
+  t.binary[CMPLT][F32X4] = cmplt_ps;
+  t.reduce[SUM][F32X4] = hsum_ps;
+  t.reduce[HMIN][F32X4] = hmin_ps;
+  t.reduce[HMAX][F32X4] = hmax_ps;
+  t.binary[ADD][F64X2] = add_pd;
+  t.binary[SUB][F64X2] = sub_pd;
+  t.binary[MUL][F64X2] = mul_pd;
+  t.binary[MIN][F64X2] = min_pd;
+  t.binary[MAX][F64X2] = max_pd;
+  t.binary[CMPEQ][F64X2] = cmpeq_pd;
+  t.binary[CMPLT][F64X2] = cmplt_pd;
+  t.reduce[SUM][F64X2] = hsum_pd;
+  t.reduce[HMIN][F64X2] = hmin_pd;
+  t.reduce[HMAX][F64X2] = hmax_pd;
+  t.binary[ADD][I8X16] = t.binary[ADD][U8X16] = add_epi8;
+  t.binary[SUB][I8X16] = t.binary[SUB][U8X16] = sub_epi8;
+  t.binary[ADD][I16X8] = t.binary[ADD][U16X8] = add_epi16;
+  t.binary[SUB][I16X8] = t.binary[SUB][U16X8] = sub_epi16;
+  t.binary[ADD][I32X4] = t.binary[ADD][U32X4] = add_epi32;
+  t.binary[SUB][I32X4] = t.binary[SUB][U32X4] = sub_epi32;
+  t.binary[ADD][I64X2] = t.binary[ADD][U64X2] = add_epi64;
+  t.binary[SUB][I64X2] = t.binary[SUB][U64X2] = sub_epi64;
+  t.binary[MUL][I16X8] = t.binary[MUL][U16X8] = mullo_epi16;
+  t.binary[MIN][U8X16] = min_epu8;
+  t.binary[MAX][U8X16] = max_epu8;
+  t.binary[MIN][I16X8] = min_epi16;
+  t.binary[MAX][I16X8] = max_epi16;
+  t.binary[CMPEQ][I8X16] = t.binary[CMPEQ][U8X16] = cmpeq_epi8;
+  t.binary[CMPEQ][I16X8] = t.binary[CMPEQ][U16X8] = cmpeq_epi16;
+  t.binary[CMPEQ][I32X4] = t.binary[CMPEQ][U32X4] = cmpeq_epi32;
+  t.binary[CMPLT][I8X16] = cmplt_epi8;
+  t.binary[CMPLT][I16X8] = cmplt_epi16;
+  t.binary[CMPLT][I32X4] = cmplt_epi32;
+  t.binary[CMPLT][U8X16] = cmplt_epu8;
+  t.binary[CMPLT][U16X8] = cmplt_epu16;
+  t.binary[CMPLT][U32X4] = cmplt_epu32;
+
+  if (__builtin_cpu_supports("sse4.1")) {
+    t.binary[MUL][I32X4] = t.binary[MUL][U32X4] = mullo_epi32;
+    t.binary[MIN][I8X16] = min_epi8;
+    t.binary[MAX][I8X16] = max_epi8;
+    t.binary[MIN][U16X8] = min_epu16;
+    t.binary[MAX][U16X8] = max_epu16;
+    t.binary[MIN][I32X4] = min_epi32;
+    t.binary[MAX][I32X4] = max_epi32;
+    t.binary[MIN][U32X4] = min_epu32;
+    t.binary[MAX][U32X4] = max_epu32;
+    t.binary[CMPEQ][I64X2] = t.binary[CMPEQ][U64X2] = cmpeq_epi64;
+  }
+
+  if (__builtin_cpu_supports("sse4.2")) {
+    t.binary[CMPLT][I64X2] = cmplt_epi64;
+    t.binary[CMPLT][U64X2] = cmplt_epu64;
+  }
+
+  if (__builtin_cpu_supports("avx")) {
+    t.binary[ADD][F32X8] = add_ps256;
+    t.binary[SUB][F32X8] = sub_ps256;
+    t.binary[MUL][F32X8] = mul_ps256;
+    t.binary[MIN][F32X8] = min_ps256;
+    t.binary[MAX][F32X8] = max_ps256;
+    t.binary[CMPEQ][F32X8] = cmpeq_ps256;
+    t.binary[CMPLT][F32X8] = cmplt_ps256;
+    t.reduce[SUM][F32X8] = hsum_ps256;
+    t.reduce[HMIN][F32X8] = hmin_ps256;
+    t.reduce[HMAX][F32X8] = hmax_ps256;
+    t.binary[ADD][F64X4] = add_pd256;
+    t.binary[SUB][F64X4] = sub_pd256;
+    t.binary[MUL][F64X4] = mul_pd256;
+    t.binary[MIN][F64X4] = min_pd256;
+    t.binary[MAX][F64X4] = max_pd256;
+    t.binary[CMPEQ][F64X4] = cmpeq_pd256;
+    t.binary[CMPLT][F64X4] = cmplt_pd256;
+    t.reduce[SUM][F64X4] = hsum_pd256;
+    t.reduce[HMIN][F64X4] = hmin_pd256;
+    t.reduce[HMAX][F64X4] = hmax_pd256;
+  }
+
+  if (__builtin_cpu_supports("avx2")) {
+    t.binary[ADD][I8X32] = t.binary[ADD][U8X32] = add_epi8_256;
+    t.binary[SUB][I8X32] = t.binary[SUB][U8X32] = sub_epi8_256;
+    t.binary[ADD][I16X16] = t.binary[ADD][U16X16] = add_epi16_256;
+    t.binary[SUB][I16X16] = t.binary[SUB][U16X16] = sub_epi16_256;
+    t.binary[ADD][I32X8] = t.binary[ADD][U32X8] = add_epi32_256;
+    t.binary[SUB][I32X8] = t.binary[SUB][U32X8] = sub_epi32_256;
+    t.binary[ADD][I64X4] = t.binary[ADD][U64X4] = add_epi64_256;
+    t.binary[SUB][I64X4] = t.binary[SUB][U64X4] = sub_epi64_256;
+    t.binary[MUL][I16X16] = t.binary[MUL][U16X16] = mullo_epi16_256;
+    t.binary[MUL][I32X8] = t.binary[MUL][U32X8] = mullo_epi32_256;
+    t.binary[MIN][I8X32] = min_epi8_256;
+    t.binary[MAX][I8X32] = max_epi8_256;
+    t.binary[MIN][U8X32] = min_epu8_256;
+    t.binary[MAX][U8X32] = max_epu8_256;
+    t.binary[MIN][I16X16] = min_epi16_256;
+    t.binary[MAX][I16X16] = max_epi16_256;
+    t.binary[MIN][U16X16] = min_epu16_256;
+    t.binary[MAX][U16X16] = max_epu16_256;
+    t.binary[MIN][I32X8] = min_epi32_256;
+    t.binary[MAX][I32X8] = max_epi32_256;
+    t.binary[MIN][U32X8] = min_epu32_256;
+    t.binary[MAX][U32X8] = max_epu32_256;
+    t.binary[CMPEQ][I8X32] = t.binary[CMPEQ][U8X32] = cmpeq_epi8_256;
+    t.binary[CMPEQ][I16X16] = t.binary[CMPEQ][U16X16] = cmpeq_epi16_256;
+    t.binary[CMPEQ][I32X8] = t.binary[CMPEQ][U32X8] = cmpeq_epi32_256;
+    t.binary[CMPEQ][I64X4] = t.binary[CMPEQ][U64X4] = cmpeq_epi64_256;
+    t.binary[CMPLT][I8X32] = cmplt_epi8_256;
+    t.binary[CMPLT][I16X16] = cmplt_epi16_256;
+    t.binary[CMPLT][I32X8] = cmplt_epi32_256;
+    t.binary[CMPLT][I64X4] = cmplt_epi64_256;
+    t.binary[CMPLT][U8X32] = cmplt_epu8_256;
+    t.binary[CMPLT][U16X16] = cmplt_epu16_256;
+    t.binary[CMPLT][U32X8] = cmplt_epu32_256;
+    t.binary[CMPLT][U64X4] = cmplt_epu64_256;
+    t.find = find_epi8_256;
+  }
+#endif
+
+  return t;
+}
+
+} // namespace
+
+const KernelTable &kernels() {
+  static const KernelTable table = select_kernels();
+  return table;
+}
+
+const KernelTable &scalar_kernels() {
+  static const KernelTable table = scalar_table();
+  return table;
+}
+
+} // namespace pushle::simd
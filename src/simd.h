@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pushle::simd {
+  // Lane shapes, in the same order as the _OP_V opcode families.
+  enum Shape {
+    I8X16, U8X16, I16X8, U16X8, I32X4, U32X4, F32X4, I64X2, U64X2, F64X2,
+    I8X32, U8X32, I16X16, U16X16, I32X8, U32X8, F32X8, I64X4, U64X4, F64X4,
+    SHAPE_COUNT,
+  };
+
+  // Families in the same order as VADD_..VCMPLT_ and VSUM_..VHMAX_ in ops.h.
+  enum BinaryOp { ADD, SUB, MUL, MIN, MAX, CMPEQ, CMPLT, BINARY_OP_COUNT };
+  enum ReduceOp { SUM, HMIN, HMAX, REDUCE_OP_COUNT };
+
+  // `dst` may alias `b`; none of the pointers need to be aligned.
+  using BinaryKernel = void (*)(void *dst, const void *a, const void *b);
+  // Writes a single lane-sized scalar to `dst`.
+  using ReduceKernel = void (*)(void *dst, const void *v);
+
+  // Index of the first `byte` among the `size` bytes at `data`, or `size`.
+  using FindKernel = size_t (*)(const void *data, uint8_t byte, size_t size);
+
+  struct KernelTable {
+    BinaryKernel binary[BINARY_OP_COUNT][SHAPE_COUNT];
+    ReduceKernel reduce[REDUCE_OP_COUNT][SHAPE_COUNT];
+    FindKernel find;
+  };
+
+  inline size_t vector_size(Shape shape) {
+    return shape < I8X32 ? 16 : 32;
+  }
+
+  inline size_t lane_size(Shape shape) {
+    switch (shape % (SHAPE_COUNT / 2)) {
+      case I8X16: case U8X16: return 1;
+      case I16X8: case U16X8: return 2;
+      case I32X4: case U32X4: case F32X4: return 4;
+      default: return 8;
+    }
+  }
+
+  // Kernels for the host CPU, selected once on first use. Every entry has a
+  // portable scalar implementation; SSE2/SSE4.1/AVX/AVX2 versions replace
+  // them when the CPU supports the instruction set.
+  const KernelTable &kernels();
+  // The portable implementations alone, which the others must match bit for bit.
+  const KernelTable &scalar_kernels();
+};
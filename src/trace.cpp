@@ -0,0 +1,83 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace pushle {
+
+Tracer::Tracer(size_t capacity) : records(std::bit_ceil(std::max<size_t>(capacity, 1))), head(0) {
+  mask = records.size() - 1;
+}
+
+std::vector<TraceRecord> Tracer::snapshot(uint64_t *first) const {
+  uint64_t end = head.load(std::memory_order_acquire);
+  uint64_t begin = end > records.size() ? end - records.size() : 0;
+  std::vector<TraceRecord> out;
+  out.reserve(end - begin);
+  for (uint64_t i = begin; i < end; i++) {
+    out.push_back(records[i & mask]);
+  }
+
+  // The writer may have lapped the copy; drop the records it overwrote,
+  // including the one it may be writing now.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t now = head.load(std::memory_order_relaxed);
+  uint64_t valid = now >= records.size() ? now - records.size() + 1 : 0;
+  if (valid > begin) {
+    uint64_t lost = std::min<uint64_t>(valid - begin, out.size());
+    out.erase(out.begin(), out.begin() + lost);
+    begin += lost;
+  }
+  if (first != nullptr) {
+    *first = begin;
+  }
+  return out;
+}
+
+void Tracer::clear() {
+  head.store(0, std::memory_order_release);
+}
+
+void Tracer::write(const std::string &path) const {
+  TraceFileHeader header;
+  std::vector<TraceRecord> snapshot = this->snapshot(&header.dropped);
+  memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+  header.version = TRACE_VERSION;
+  header.record_size = sizeof(TraceRecord);
+  header.count = snapshot.size();
+
+  std::ofstream out(path, std::ios::binary);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(snapshot.data()), snapshot.size() * sizeof(TraceRecord));
+  if (!out) {
+    throw std::runtime_error("trace: cannot write " + path);
+  }
+}
+
+std::vector<TraceRecord> Tracer::read(const std::string &path, uint64_t *dropped) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("trace: cannot open file");
+  }
+  TraceFileHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))
+      || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+    throw std::runtime_error("trace: not a trace file");
+  }
+  if (header.version != TRACE_VERSION || header.record_size != sizeof(TraceRecord)) {
+    throw std::runtime_error("trace: unsupported trace version");
+  }
+  std::vector<TraceRecord> records(header.count);
+  if (!in.read(reinterpret_cast<char *>(records.data()), records.size() * sizeof(TraceRecord))) {
+    throw std::runtime_error("trace: file is truncated");
+  }
+  if (dropped != nullptr) {
+    *dropped = header.dropped;
+  }
+  return records;
+}
+
+} // namespace pushle
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pushle {
+  const char TRACE_MAGIC[4] = { 'P', 'S', 'H', 'T' };
+  const uint16_t TRACE_VERSION = 1;
+  const size_t TRACE_DEFAULT_CAPACITY = 64 * 1024; // records
+
+  // One instruction, recorded just before it executes.
+  struct TraceRecord {
+    uint64_t top;      // the 8 bytes on top of the stack, zero-extended if it holds fewer
+    uint32_t offset;   // of the instruction in the code section
+    uint32_t depth;    // stack bytes in use
+    uint32_t opcode;   // an Op
+    uint32_t reserved;
+  };
+
+  // A trace file is a TraceFileHeader followed by `count` records, oldest
+  // first. `dropped` records were overwritten in the ring before it was saved.
+  struct TraceFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint64_t count;
+    uint64_t dropped;
+  };
+
+  // Ring of the most recent records of one VM, which is its only writer.
+  // Writing a record is a handful of stores and never blocks or allocates;
+  // snapshot() may run on any thread meanwhile and returns the records that
+  // were not overwritten while it copied them.
+  class Tracer {
+  public:
+    // `capacity` is rounded up to a power of two.
+    explicit Tracer(size_t capacity = TRACE_DEFAULT_CAPACITY);
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    inline void record(uint32_t offset, uint32_t opcode, uint32_t depth, uint64_t top) {
+      uint64_t n = head.load(std::memory_order_relaxed);
+      records[n & mask] = { top, offset, depth, opcode, 0 };
+      head.store(n + 1, std::memory_order_release);
+    }
+
+    // Records written since construction or the last clear().
+    inline uint64_t total() const { return head.load(std::memory_order_acquire); }
+    inline size_t capacity() const { return records.size(); }
+    // The records still in the ring, oldest first. `first` receives the
+    // number of records written before the oldest one.
+    std::vector<TraceRecord> snapshot(uint64_t *first = nullptr) const;
+    void clear();
+    // Saves snapshot() as a trace file for the tracedump tool.
+    void write(const std::string &path) const;
+    static std::vector<TraceRecord> read(const std::string &path, uint64_t *dropped = nullptr);
+
+  private:
+    std::vector<TraceRecord> records;
+    size_t mask;
+    std::atomic<uint64_t> head;
+  };
+};
@@ -0,0 +1,49 @@
+#include <fmt/core.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ops.h"
+#include "registry.h"
+#include "trace.h"
+
+// Renders a trace file written by pushle::Tracer, one instruction per line:
+// sequence number, code offset, mnemonic, stack depth and top of stack.
+int main(int argc, char** argv) {
+  size_t last = SIZE_MAX;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      last = std::stoull(argv[++i]);
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 1) {
+    fmt::print("Usage: {} [-n last] <trace>\n", argv[0]);
+    return 1;
+  }
+
+  uint64_t dropped;
+  std::vector<pushle::TraceRecord> records;
+  try {
+    records = pushle::Tracer::read(paths[0], &dropped);
+  } catch (const std::exception& e) {
+    fmt::print("{}: {}\n", paths[0], e.what());
+    return 1;
+  }
+  size_t begin = records.size() > last ? records.size() - last : 0;
+  fmt::print("// {} records, {} earlier ones overwritten\n", records.size(), dropped);
+
+  auto& registry = pushle::TokenRegistry::getInstance();
+  for (size_t i = begin; i < records.size(); i++) {
+    const auto& r = records[i];
+    auto token = registry.getToken((pushle::Op) r.opcode);
+    std::string name = token ? token->getToken() : fmt::format("<{:#x}>", r.opcode);
+    fmt::print("{:>10}  {:#08x}  {:<16} depth {:<8} top {:#018x}\n", dropped + i, r.offset, name, r.depth, r.top);
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+# Runs every program in PROGRAMS through the interpreter and through native
+# code built with `aot -c` and linked with HOST, at each assembler -O level,
+# and fails if the output or the exit status differ.
+#
+# Invoked by ctest with ASSEMBLER, PUSHLE, AOT, HOST, LIBPUSHLE, CXX,
+# INCLUDES, DEFINES, PROGRAMS and WORK_DIR set; lists are separated by `|`.
+
+string(REPLACE "|" ";" PROGRAMS "${PROGRAMS}")
+string(REPLACE "|" ";" INCLUDES "${INCLUDES}")
+string(REPLACE "|" ";" DEFINES "${DEFINES}")
+# the generated code must be compiled like the VM library it links against
+set(COMPILE_FLAGS)
+foreach(dir IN LISTS INCLUDES)
+  list(APPEND COMPILE_FLAGS "-I${dir}")
+endforeach()
+foreach(define IN LISTS DEFINES)
+  list(APPEND COMPILE_FLAGS "-D${define}")
+endforeach()
+set(ENV{CXX} "${CXX}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+foreach(program IN LISTS PROGRAMS)
+  get_filename_component(name "${program}" NAME_WE)
+  foreach(level 0 1 2)
+    set(base "${WORK_DIR}/${name}-O${level}")
+    set(test "${name} -O${level}")
+
+    execute_process(COMMAND "${ASSEMBLER}" -O${level} "${program}" "${base}.bin"
+      RESULT_VARIABLE status OUTPUT_VARIABLE log ERROR_VARIABLE log)
+    if(NOT status EQUAL 0)
+      message(SEND_ERROR "${test}: assembler failed:\n${log}")
+      continue()
+    endif()
+
+    execute_process(COMMAND "${PUSHLE}" "${base}.bin"
+      RESULT_VARIABLE expected_status OUTPUT_VARIABLE expected ERROR_VARIABLE expected)
+
+    execute_process(COMMAND "${AOT}" -c -n aot_test_program ${COMPILE_FLAGS} "${base}.bin" "${base}.o"
+      RESULT_VARIABLE status OUTPUT_VARIABLE log ERROR_VARIABLE log)
+    if(NOT status EQUAL 0)
+      message(SEND_ERROR "${test}: aot failed:\n${log}")
+      continue()
+    endif()
+    execute_process(COMMAND "${CXX}" "${base}.o" "${HOST}" "${LIBPUSHLE}" -pthread -o "${base}"
+      RESULT_VARIABLE status OUTPUT_VARIABLE log ERROR_VARIABLE log)
+    if(NOT status EQUAL 0)
+      message(SEND_ERROR "${test}: linking failed:\n${log}")
+      continue()
+    endif()
+
+    execute_process(COMMAND "${base}"
+      RESULT_VARIABLE actual_status OUTPUT_VARIABLE actual ERROR_VARIABLE actual)
+    string(STRIP "${expected}" expected)
+    string(STRIP "${actual}" actual)
+    if(NOT actual STREQUAL expected OR NOT actual_status STREQUAL expected_status)
+      message(SEND_ERROR "${test}: interpreter gave \"${expected}\" (${expected_status}), aot gave \"${actual}\" (${actual_status})")
+    else()
+      message(STATUS "${test}: ${expected}")
+    endif()
+  endforeach()
+endforeach()
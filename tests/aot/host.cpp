@@ -0,0 +1,23 @@
+#include <fmt/core.h>
+
+#include "pushle.h"
+
+// Defined by the module compiled with `aot -c -n aot_test_program`.
+void aot_test_program(pushle::VM &vm);
+
+// Runs the compiled program and reports the outcome the way the pushle
+// runtime does, so that the two outputs can be compared verbatim.
+int main() {
+  pushle::VM vm;
+  aot_test_program(vm);
+  if (vm.trap_code() != pushle::TRAP_NONE) {
+    fmt::print(stderr, "trap: {} at {:#x}\n", pushle::trap_name(vm.trap_code()), vm.trap_offset());
+    return 1;
+  }
+  if (vm.stack_depth() < pushle::stack_width(sizeof(uint64_t))) {
+    fmt::print("No u64 result ({} bytes on the stack)\n", vm.stack_depth());
+    return 0;
+  }
+  fmt::print("Result as u64: {}\n", vm.get_u64());
+  return 0;
+}
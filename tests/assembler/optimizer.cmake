@@ -0,0 +1,62 @@
+# Assembles PROGRAM at -O${LEVEL}, runs it with a trace and checks which
+# opcodes ran: each one in REQUIRE must appear in the trace and none in
+# FORBID. With MAX_STEPS set, at most that many instructions may run, and
+# with RESULT set, the interpreter must print exactly that.
+#
+# Invoked by ctest with ASSEMBLER, PUSHLE, TRACEDUMP, PROGRAM, LEVEL and
+# WORK_DIR set; REQUIRE and FORBID are lists separated by `|`.
+
+string(REPLACE "|" ";" REQUIRE "${REQUIRE}")
+string(REPLACE "|" ";" FORBID "${FORBID}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+get_filename_component(name "${PROGRAM}" NAME_WE)
+set(base "${WORK_DIR}/${name}-O${LEVEL}")
+
+execute_process(COMMAND "${ASSEMBLER}" -O${LEVEL} "${PROGRAM}" "${base}.bin"
+  RESULT_VARIABLE status OUTPUT_VARIABLE log ERROR_VARIABLE log)
+if(NOT status EQUAL 0)
+  message(FATAL_ERROR "assembler failed:\n${log}")
+endif()
+
+execute_process(COMMAND "${PUSHLE}" -t "${base}.trace" "${base}.bin"
+  RESULT_VARIABLE status OUTPUT_VARIABLE output ERROR_VARIABLE output)
+string(STRIP "${output}" output)
+if(NOT RESULT STREQUAL "" AND NOT output STREQUAL RESULT)
+  message(FATAL_ERROR "expected \"${RESULT}\", got \"${output}\" (${status})")
+endif()
+
+execute_process(COMMAND "${TRACEDUMP}" "${base}.trace"
+  RESULT_VARIABLE status OUTPUT_VARIABLE dump ERROR_VARIABLE dump)
+if(NOT status EQUAL 0)
+  message(FATAL_ERROR "tracedump failed:\n${dump}")
+endif()
+if(NOT dump MATCHES "// ([0-9]+) records, ([0-9]+) earlier ones overwritten")
+  message(FATAL_ERROR "unexpected trace dump:\n${dump}")
+endif()
+math(EXPR steps "${CMAKE_MATCH_1} + ${CMAKE_MATCH_2}")
+
+# records read `<index>  <offset>  <opcode>  depth ...`
+string(REGEX MATCHALL "0x[0-9a-f]+  [a-z0-9_]+" records "${dump}")
+set(ops)
+foreach(record IN LISTS records)
+  string(REGEX REPLACE "^0x[0-9a-f]+  " "" op "${record}")
+  list(APPEND ops "${op}")
+endforeach()
+list(REMOVE_DUPLICATES ops)
+
+foreach(op IN LISTS REQUIRE)
+  list(FIND ops "${op}" index)
+  if(index EQUAL -1)
+    message(SEND_ERROR "${op} never ran; ran: ${ops}")
+  endif()
+endforeach()
+foreach(op IN LISTS FORBID)
+  list(FIND ops "${op}" index)
+  if(NOT index EQUAL -1)
+    message(SEND_ERROR "${op} ran; ran: ${ops}")
+  endif()
+endforeach()
+if(NOT MAX_STEPS STREQUAL "" AND steps GREATER MAX_STEPS)
+  message(SEND_ERROR "${steps} instructions ran, expected at most ${MAX_STEPS}")
+endif()
+message(STATUS "${name} -O${LEVEL}: ${steps} instructions, ran ${ops}")
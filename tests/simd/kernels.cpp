@@ -0,0 +1,196 @@
+// Runs every vector kernel the host CPU selected against the portable scalar
+// version of the same operation and fails on any difference in the result
+// bytes. The inputs mix random lanes with the edge values of each lane type,
+// so wrap-around, signedness and lane boundaries are covered.
+
+#include <fmt/core.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "simd.h"
+
+using namespace pushle::simd;
+
+static const char *SHAPE_NAMES[] = {
+  "i8x16", "u8x16", "i16x8", "u16x8", "i32x4", "u32x4", "f32x4", "i64x2", "u64x2", "f64x2",
+  "i8x32", "u8x32", "i16x16", "u16x16", "i32x8", "u32x8", "f32x8", "i64x4", "u64x4", "f64x4",
+};
+static const char *BINARY_NAMES[] = { "add", "sub", "mul", "min", "max", "cmpeq", "cmplt" };
+static const char *REDUCE_NAMES[] = { "sum", "hmin", "hmax" };
+
+static std::mt19937_64 rng(42);
+static int failures = 0;
+
+static bool is_float(Shape shape) {
+  return shape % (SHAPE_COUNT / 2) == F32X4 || shape % (SHAPE_COUNT / 2) == F64X2;
+}
+
+template <typename T>
+static T edge_lane() {
+  const T edges[] = {
+    0, 1, (T)-1, std::numeric_limits<T>::min(), std::numeric_limits<T>::max(),
+    (T)(std::numeric_limits<T>::min() + 1), (T)(std::numeric_limits<T>::max() - 1),
+  };
+  return rng() % 2 ? edges[rng() % std::size(edges)] : (T)rng();
+}
+
+template <typename T>
+static T float_lane() {
+  const T edges[] = {
+    0, -0.0, 1, -1, std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(),
+    std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::denorm_min(),
+  };
+  if (rng() % 4 == 0) {
+    return edges[rng() % std::size(edges)];
+  }
+  return (T)std::ldexp((double)(int64_t)rng() / (double)INT64_MAX, (int)(rng() % 64) - 32);
+}
+
+// Fills a vector of `shape` with lanes of its type; `nan` allows NaN lanes.
+static void fill(uint8_t *v, Shape shape, bool nan) {
+  size_t lane = lane_size(shape);
+  for (size_t i = 0; i < vector_size(shape); i += lane) {
+    switch (shape % (SHAPE_COUNT / 2)) {
+      case I8X16:  { int8_t x = edge_lane<int8_t>(); memcpy(v + i, &x, lane); break; }
+      case U8X16:  { uint8_t x = edge_lane<uint8_t>(); memcpy(v + i, &x, lane); break; }
+      case I16X8:  { int16_t x = edge_lane<int16_t>(); memcpy(v + i, &x, lane); break; }
+      case U16X8:  { uint16_t x = edge_lane<uint16_t>(); memcpy(v + i, &x, lane); break; }
+      case I32X4:  { int32_t x = edge_lane<int32_t>(); memcpy(v + i, &x, lane); break; }
+      case U32X4:  { uint32_t x = edge_lane<uint32_t>(); memcpy(v + i, &x, lane); break; }
+      case I64X2:  { int64_t x = edge_lane<int64_t>(); memcpy(v + i, &x, lane); break; }
+      case U64X2:  { uint64_t x = edge_lane<uint64_t>(); memcpy(v + i, &x, lane); break; }
+      case F32X4: {
+        float x = nan && rng() % 8 == 0 ? std::numeric_limits<float>::quiet_NaN() : float_lane<float>();
+        memcpy(v + i, &x, lane);
+        break;
+      }
+      default: {
+        double x = nan && rng() % 8 == 0 ? std::numeric_limits<double>::quiet_NaN() : float_lane<double>();
+        memcpy(v + i, &x, lane);
+        break;
+      }
+    }
+  }
+}
+
+static std::string hex(const uint8_t *v, size_t size) {
+  std::string text;
+  for (size_t i = 0; i < size; i++) {
+    text += fmt::format("{:02x}", v[i]);
+  }
+  return text;
+}
+
+static void check_binary(const KernelTable &fast, const KernelTable &scalar) {
+  for (int op = 0; op < BINARY_OP_COUNT; op++) {
+    for (int s = 0; s < SHAPE_COUNT; s++) {
+      Shape shape = (Shape)s;
+      size_t size = vector_size(shape);
+      for (int round = 0; round < 2000; round++) {
+        // NaN sums and products may keep either operand's payload, so only
+        // min, max and the compares see NaN lanes
+        bool nan = is_float(shape) && op >= MIN;
+        uint8_t a[32], b[32], expected[32], actual[32];
+        fill(a, shape, nan);
+        fill(b, shape, nan);
+        if (round % 7 == 0) {
+          memcpy(b, a, size); // equal lanes, for cmpeq and the min/max ties
+        }
+        scalar.binary[op][shape](expected, a, b);
+        fast.binary[op][shape](actual, a, b);
+        if (memcmp(expected, actual, size) != 0) {
+          fmt::print("v{}_{}: {} {} gave {}, expected {}\n", BINARY_NAMES[op], SHAPE_NAMES[shape],
+                     hex(a, size), hex(b, size), hex(actual, size), hex(expected, size));
+          failures++;
+          break;
+        }
+      }
+    }
+  }
+}
+
+static void check_reduce(const KernelTable &fast, const KernelTable &scalar) {
+  for (int op = 0; op < REDUCE_OP_COUNT; op++) {
+    for (int s = 0; s < SHAPE_COUNT; s++) {
+      Shape shape = (Shape)s;
+      size_t lane = lane_size(shape);
+      for (int round = 0; round < 2000; round++) {
+        uint8_t v[32], expected[8], actual[8];
+        fill(v, shape, is_float(shape) && op != SUM);
+        scalar.reduce[op][shape](expected, v);
+        fast.reduce[op][shape](actual, v);
+        if (memcmp(expected, actual, lane) != 0) {
+          fmt::print("v{}_{}: {} gave {}, expected {}\n", REDUCE_NAMES[op], SHAPE_NAMES[shape],
+                     hex(v, vector_size(shape)), hex(actual, lane), hex(expected, lane));
+          failures++;
+          break;
+        }
+      }
+    }
+  }
+}
+
+// Adding 1 to all-ones lanes must wrap each lane to 0 without carrying into
+// the next one, whatever the lane width.
+static void check_lane_carry(const KernelTable &fast) {
+  for (int s = 0; s < SHAPE_COUNT; s++) {
+    Shape shape = (Shape)s;
+    if (is_float(shape)) {
+      continue;
+    }
+    size_t size = vector_size(shape);
+    size_t lane = lane_size(shape);
+    uint8_t a[32], b[32], r[32], zero[32] = {};
+    memset(a, 0xff, size);
+    memset(b, 0, size);
+    for (size_t i = 0; i < size; i += lane) {
+      b[i] = 1;
+    }
+    fast.binary[ADD][shape](r, a, b);
+    if (memcmp(r, zero, size) != 0) {
+      fmt::print("vadd_{}: all-ones + 1 gave {}\n", SHAPE_NAMES[shape], hex(r, size));
+      failures++;
+    }
+  }
+}
+
+static void check_find(const KernelTable &fast, const KernelTable &scalar) {
+  std::vector<uint8_t> data(300);
+  for (size_t size = 0; size <= data.size(); size++) {
+    for (int round = 0; round < 8; round++) {
+      for (auto &byte : data) {
+        byte = 1 + rng() % 255;
+      }
+      if (round > 0 && size > 0) {
+        data[rng() % size] = 0;
+      }
+      size_t expected = scalar.find(data.data(), 0, size);
+      size_t actual = fast.find(data.data(), 0, size);
+      if (expected != actual) {
+        fmt::print("memfind: {} bytes gave {}, expected {}\n", size, actual, expected);
+        failures++;
+        return;
+      }
+    }
+  }
+}
+
+int main() {
+  const KernelTable &fast = kernels();
+  const KernelTable &scalar = scalar_kernels();
+  check_binary(fast, scalar);
+  check_reduce(fast, scalar);
+  check_lane_carry(fast);
+  check_find(fast, scalar);
+  if (failures > 0) {
+    fmt::print("{} kernel(s) differ from the scalar fallback\n", failures);
+    return 1;
+  }
+  fmt::print("all kernels match the scalar fallback\n");
+  return 0;
+}